@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mappedFile.h"
+
+// Binary files of structures that can be used in place from a mapped file
+//  - header : magic, format version, type of the structure and sizeof(T), 4 bytes each
+//  - scalars are stored as they are in memory (native byte order)
+//  - an array is stored as an 8-byte count and its data, the data is aligned to 8 bytes from the start of
+//    the file, so a mapped file can be used in place without copying
+struct BinaryFile {
+    static const int ALIGNMENT = 8;
+
+    static size_t padding(size_t offset) {
+        return (ALIGNMENT - offset % ALIGNMENT) % ALIGNMENT;
+    }
+};
+
+struct BinaryWriter {
+    FILE*   fp;
+    size_t  offset;
+    bool    ok;
+
+    explicit BinaryWriter(FILE* fp) : fp(fp), offset(0), ok(fp != nullptr) {
+    }
+
+    void writeHeader(unsigned int magic, unsigned int version, unsigned int type, unsigned int elementSize) {
+        write(magic);
+        write(version);
+        write(type);
+        write(elementSize);
+    }
+
+    template <typename T>
+    void write(T value) {
+        writeBytes(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void writeArray(const T* data, size_t n) {
+        write((unsigned long long)n);
+        align();
+        writeBytes(data, n * sizeof(T));
+    }
+
+    void align() {
+        static const char zeros[BinaryFile::ALIGNMENT] = { 0, };
+        writeBytes(zeros, BinaryFile::padding(offset));
+    }
+
+    void writeBytes(const void* data, size_t size) {
+        if (ok && size > 0 && fwrite(data, 1, size, fp) != size)
+            ok = false;
+        offset += size;
+    }
+};
+
+// reads values from a file in memory, arrays are returned as pointers into the memory
+struct BinaryReader {
+    const char* base;
+    size_t      size;
+    size_t      offset;
+    bool        ok;
+
+    BinaryReader(const char* base, size_t size) : base(base), size(size), offset(0), ok(base != nullptr) {
+    }
+
+    bool readHeader(unsigned int magic, unsigned int version, unsigned int type, unsigned int elementSize) {
+        unsigned int fileMagic = 0, fileVersion = 0, fileType = 0, fileElementSize = 0;
+        read(fileMagic);
+        read(fileVersion);
+        read(fileType);
+        read(fileElementSize);
+        ok = ok && fileMagic == magic && fileVersion == version
+                && fileType == type && fileElementSize == elementSize;
+        return ok;
+    }
+
+    template <typename T>
+    bool read(T& value) {
+        if (!ok || size - offset < sizeof(T))
+            return ok = false;
+        memcpy(&value, base + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    // returns nullptr if the file is broken
+    template <typename T>
+    const T* readArray(size_t& n) {
+        unsigned long long count = 0;
+        if (!read(count))
+            return nullptr;
+        offset += BinaryFile::padding(offset);
+        if (offset > size || (size - offset) / sizeof(T) < count) {
+            ok = false;
+            return nullptr;
+        }
+        const T* res = reinterpret_cast<const T*>(base + offset);
+        n = size_t(count);
+        offset += n * sizeof(T);
+        return res;
+    }
+
+    template <typename T>
+    bool readArray(vector<T>& out) {
+        size_t n = 0;
+        const T* p = readArray<T>(n);
+        if (!p)
+            return false;
+        out.assign(p, p + n);
+        return true;
+    }
+};
+
+// calls save(FILE*) of a structure with a new file
+template <typename Struct>
+inline bool saveBinaryFile(const Struct& s, const char* path) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+        return false;
+    bool res = s.save(fp);
+    return (fclose(fp) == 0) && res;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define MAPPED_FILE_USE_MMAP
+#endif
+
+// a read-only file in memory, mapped if possible, otherwise read at once
+//  - mapped pages are shared with the page cache, so processes mapping the same file share the memory
+//  - open(path, false) only maps, and fails if the file can't be mapped (to stream it instead)
+struct MappedFile {
+    const char* data;
+    size_t      size;
+    bool        mapped;
+
+    MappedFile() : data(nullptr), size(0), mapped(false) {
+    }
+
+    explicit MappedFile(const char* path) : data(nullptr), size(0), mapped(false) {
+        open(path);
+    }
+
+    MappedFile(MappedFile&& rhs) noexcept : data(rhs.data), size(rhs.size), mapped(rhs.mapped) {
+        rhs.data = nullptr;
+        rhs.size = 0;
+        rhs.mapped = false;
+    }
+
+    MappedFile& operator =(MappedFile&& rhs) noexcept {
+        if (this != &rhs) {
+            close();
+            swap(data, rhs.data);
+            swap(size, rhs.size);
+            swap(mapped, rhs.mapped);
+        }
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator =(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        close();
+    }
+
+    bool open(const char* path, bool readIfNotMapped = true) {
+        close();
+#ifdef MAPPED_FILE_USE_MMAP
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat st;
+        if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* p = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED) {
+                ::close(fd);
+                data = reinterpret_cast<const char*>(p);
+                size = size_t(st.st_size);
+                mapped = true;
+                return true;
+            }
+        }
+        ::close(fd);
+#endif
+        if (!readIfNotMapped)
+            return false;
+
+        FILE* fp = fopen(path, "rb");
+        if (!fp)
+            return false;
+
+        bool res = false;
+        if (fseek(fp, 0, SEEK_END) == 0) {
+            long fileSize = ftell(fp);
+            if (fileSize > 0 && fseek(fp, 0, SEEK_SET) == 0) {
+                char* buff = reinterpret_cast<char*>(malloc(size_t(fileSize)));
+                if (buff && fread(buff, 1, size_t(fileSize), fp) == size_t(fileSize)) {
+                    data = buff;
+                    size = size_t(fileSize);
+                    res = true;
+                } else {
+                    free(buff);
+                }
+            }
+        }
+        fclose(fp);
+        return res;
+    }
+
+    void close() {
+#ifdef MAPPED_FILE_USE_MMAP
+        if (mapped)
+            munmap(const_cast<char*>(data), size);
+        else
+#endif
+            free(const_cast<char*>(data));
+        data = nullptr;
+        size = 0;
+        mapped = false;
+    }
+
+    // hints that the mapped pages will be read in order
+    void adviseSequential() const {
+#if defined(MAPPED_FILE_USE_MMAP) && defined(MADV_SEQUENTIAL)
+        if (mapped)
+            madvise(const_cast<char*>(data), size, MADV_SEQUENTIAL);
+#endif
+    }
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <thread>
+
+// calls f(first, last) for about 'threadCount' equal parts of [0, n), one part per thread
+template <typename F>
+inline void parallelFor(int n, int threadCount, F f) {
+    threadCount = max(1, min(threadCount, n));
+    if (threadCount == 1) {
+        if (n > 0)
+            f(0, n);
+        return;
+    }
+
+    vector<thread> threads;
+    for (int t = 1; t < threadCount; t++)
+        threads.emplace_back(f, int(1ll * n * t / threadCount), int(1ll * n * (t + 1) / threadCount));
+    f(0, int(1ll * n / threadCount));
+    for (auto& th : threads)
+        th.join();
+}
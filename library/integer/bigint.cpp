@@ -56,42 +56,135 @@ void testBigInt() {
         }
     }
     {
-        int N = 1;
-        vector<bigint> x(N), y(N);
-        for (int i = 0; i < N; i++) {
-            x[i] = getRandomBigint(60000);
-            y[i] = getRandomBigint(60000);
-        }
+        bigint z(5);
+        z = 6;
+        assert(z == bigint(6));
+    }
+    cout << "OK!" << endl;
+}
+
+void testBigIntFast() {
+    //return; //TODO: if you want to test, make this line a comment.
 
-        PROFILE_START(0);
-        for (int i = 0; i < N; i++) {
-            bigint z = x[i] * y[i];
-            if (z.sign < 0)
-                cout << "What?" << endl;
+    cout << "------------ Big Integer : Karatsuba, NTT and Newton division --------------" << endl;
+    {
+        // every multiplication path, including the split path of Karatsuba
+        int lens[] = { 1, 9, 100, 500, 1000, 5000, 10000, 40000 };
+        for (int len1 : lens) {
+            for (int len2 : lens) {
+                if (len1 > len2 || 1ll * len1 * len2 > 100000000ll)
+                    continue;
+                bigint a = getRandomBigint(len1);
+                bigint b = -getRandomBigint(len2);
+                bigint x = a.multiplySimple(b);
+                assert(x == a.multiplyKaratsuba(b));
+                assert(x == a.multiplyNTT(b));
+                assert(x == a * b);
+            }
+        }
+        bigint a = getRandomBigint(100000);
+        bigint b = getRandomBigint(80000);
+        assert(a.multiplyKaratsuba(b) == a.multiplyNTT(b));
+    }
+    {
+        // Newton division vs schoolbook division
+        int lens[][2] = { { 2000, 1000 }, { 5000, 1000 }, { 10000, 3000 }, { 20000, 9000 }, { 3000, 2990 } };
+        for (auto& it : lens) {
+            bigint a = getRandomBigint(it[0]);
+            bigint b = getRandomBigint(it[1]);
+            if (RandInt32::get() & 1)
+                a = -a;
+            auto qr1 = bigint::divModSimple(a, b);
+            auto qr2 = bigint::divModNewton(a, b);
+            assert(qr1.first == qr2.first && qr1.second == qr2.second);
+            assert(qr2.first * b + qr2.second == a);
+            assert(divMod(a, b) == qr2);
         }
-        PROFILE_STOP(0);
+        // b^k - 1 / b^j edge cases for the correction steps
+        bigint b = getRandomBigint(1000);
+        bigint a = b * b * b - bigint(1);
+        auto qr = bigint::divModNewton(a, b);
+        assert(qr.first == b * b - bigint(1) && qr.second == b - bigint(1));
+    }
+    {
+        cout << "*** Speed test : multiplication (in limbs of 10^9) ***" << endl;
+        for (int n = 16; n <= 65536; n <<= 1) {
+            bigint x = getRandomBigint(n * bigint::baseDigitN);
+            bigint y = getRandomBigint(n * bigint::baseDigitN);
+            int T = max(1, 4096 / n);
+            cout << "N = " << n << ", " << T << " times" << endl;
+
+            if (n <= 8192) {
+                cout << "  schoolbook : ";
+                PROFILE_START(0);
+                for (int i = 0; i < T; i++) {
+                    bigint z = x.multiplySimple(y);
+                    if (z.sign < 0)
+                        cout << "What?" << endl;
+                }
+                PROFILE_STOP(0);
+            }
 
-        PROFILE_START(1);
-        for (int i = 0; i < N; i++) {
-            bigint z = x[i].multiplyKaratsuba(y[i]);
-            if (z.sign < 0)
-                cout << "What?" << endl;
+            cout << "  Karatsuba : ";
+            PROFILE_START(1);
+            for (int i = 0; i < T; i++) {
+                bigint z = x.multiplyKaratsuba(y);
+                if (z.sign < 0)
+                    cout << "What?" << endl;
+            }
+            PROFILE_STOP(1);
+
+            cout << "  NTT : ";
+            PROFILE_START(2);
+            for (int i = 0; i < T; i++) {
+                bigint z = x.multiplyNTT(y);
+                if (z.sign < 0)
+                    cout << "What?" << endl;
+            }
+            PROFILE_STOP(2);
         }
-        PROFILE_STOP(1);
     }
     {
-        auto a = getRandomBigint(10000);
-        auto b = getRandomBigint(2000);
-        PROFILE_START(2);
-        bigint c = a / b;
-        PROFILE_STOP(2);
-        if (c.sign < 0)
-            cout << "What?" << endl;
+        cout << "*** Speed test : division (2N / N limbs) ***" << endl;
+        for (int n = 32; n <= 8192; n <<= 1) {
+            bigint x = getRandomBigint(2 * n * bigint::baseDigitN);
+            bigint y = getRandomBigint(n * bigint::baseDigitN);
+            cout << "N = " << n << endl;
+
+            cout << "  schoolbook : ";
+            PROFILE_START(3);
+            auto qr1 = bigint::divModSimple(x, y);
+            PROFILE_STOP(3);
+
+            cout << "  Newton : ";
+            PROFILE_START(4);
+            auto qr2 = bigint::divModNewton(x, y);
+            PROFILE_STOP(4);
+
+            assert(qr1 == qr2);
+        }
     }
     {
-        bigint z(5);
-        z = 6;
-        assert(z == bigint(6));
+        cout << "*** Speed test : 100000! (product tree) ***" << endl;
+        int N = 100000;
+        PROFILE_START(5);
+        vector<bigint> v;
+        for (int i = 1; i <= N; i++)
+            v.push_back(bigint(i));
+        while (v.size() > 1) {
+            vector<bigint> next;
+            for (int i = 0; i + 1 < int(v.size()); i += 2)
+                next.push_back(v[i] * v[i + 1]);
+            if (v.size() & 1)
+                next.push_back(v.back());
+            v.swap(next);
+        }
+        PROFILE_STOP(5);
+        int digits = int(v[0].a.size() - 1) * bigint::baseDigitN;
+        for (int x = v[0].a.back(); x > 0; x /= 10)
+            digits++;
+        cout << "  " << digits << " digits" << endl;
+        assert(digits == 456574);
     }
     cout << "OK!" << endl;
 }
@@ -1,11 +1,27 @@
 #pragma once
 
 #include "../polynomial/polynomial.h"
+#include "../polynomial/nttMontgomery.h"
+
+// multiplication : schoolbook -> Karatsuba -> NTT, by the length of the shorter operand (in limbs)
+#ifndef BIGINT_KARATSUBA_THRESHOLD
+#define BIGINT_KARATSUBA_THRESHOLD  48
+#endif
+#ifndef BIGINT_NTT_THRESHOLD
+#define BIGINT_NTT_THRESHOLD        2048
+#endif
+// division : schoolbook -> Newton iteration, by the lengths of the divisor and the quotient (in limbs)
+#ifndef BIGINT_NEWTON_THRESHOLD
+#define BIGINT_NEWTON_THRESHOLD     100
+#endif
+// the most correction steps after a Newton step, more steps mean a precision bug
+#define BIGINT_NEWTON_MAX_CORRECTIONS   4
 
 // LSB first
 struct bigint {
     static const int base = 1000000000;
     static const int baseDigitN = 9;
+    static const int KARATSUBA_KERNEL_MAX_SIZE = 4096;     // in limbs, 64-bit column sums are safe up to this
 
     vector<int> a;
     int sign;
@@ -141,12 +157,13 @@ struct bigint {
     }
 
     bigint operator *(const bigint& v) const {
-        bigint res;
-        res.sign = sign * v.sign;
-        res.a = multiplyFFT(convertBase(a, baseDigitN, 3), convertBase(v.a, baseDigitN, 3));
-        res.a = convertBase(res.a, 3, baseDigitN);
-        res.trim();
-        return res;
+        int n = int(min(a.size(), v.a.size()));
+        if (n < BIGINT_KARATSUBA_THRESHOLD)
+            return multiplySimple(v);
+        else if (n < BIGINT_NTT_THRESHOLD)
+            return multiplyKaratsuba(v);
+        else
+            return multiplyNTT(v);
     }
 
     bigint& operator *=(const bigint& v) {
@@ -266,6 +283,27 @@ struct bigint {
             sign = 1;
     }
 
+    // *this * base^n
+    bigint shiftLeftLimbs(int n) const {
+        bigint res;
+        if (a.empty())
+            return res;
+        res.sign = sign;
+        res.a.resize(a.size() + n);
+        copy(a.begin(), a.end(), res.a.begin() + n);
+        return res;
+    }
+
+    // *this / base^n (truncated)
+    bigint shiftRightLimbs(int n) const {
+        bigint res;
+        if (n >= int(a.size()))
+            return res;
+        res.sign = sign;
+        res.a.assign(a.begin() + n, a.end());
+        return res;
+    }
+
 
     static vector<int> convertBase(const vector<int> &a, int oldDigits, int newDigits) {
         vector<long long> p(max(oldDigits, newDigits) + 1);
@@ -307,29 +345,59 @@ struct bigint {
     }
 
     bigint multiplyKaratsuba(const bigint& v) const {
+        bigint res;
+        if (a.empty() || v.a.empty())
+            return res;
+
+        // the kernel keeps 64-bit column sums, so very long operands are split with carries first
+        int n = int(max(a.size(), v.a.size()));
+        if (n > KARATSUBA_KERNEL_MAX_SIZE) {
+            int k = (n + 1) >> 1;
+            bigint x0 = abs(), x1 = x0.shiftRightLimbs(k);
+            bigint y0 = v.abs(), y1 = y0.shiftRightLimbs(k);
+            x0.a.resize(min(int(x0.a.size()), k));
+            x0.trim();
+            y0.a.resize(min(int(y0.a.size()), k));
+            y0.trim();
+
+            bigint z0 = x0.multiplyKaratsuba(y0);
+            bigint z2 = x1.multiplyKaratsuba(y1);
+            bigint z1 = (x0 + x1).multiplyKaratsuba(y0 + y1) - z0 - z2;
+
+            res = z2.shiftLeftLimbs(2 * k) + z1.shiftLeftLimbs(k) + z0;
+            res.sign = sign * v.sign;
+            res.trim();
+            return res;
+        }
+
         vector<int> a6 = convertBase(this->a, baseDigitN, 6);
         vector<int> b6 = convertBase(v.a, baseDigitN, 6);
-        vector<long long> a(a6.begin(), a6.end());
-        vector<long long> b(b6.begin(), b6.end());
-        while (a.size() < b.size())
-            a.push_back(0);
-        while (b.size() < a.size())
-            b.push_back(0);
-        while (a.size() & (a.size() - 1))
-            a.push_back(0), b.push_back(0);
-        vector<long long> c = multiplyKaratsuba(a, b);
-        bigint res;
+        vector<long long> c = multiplyKaratsuba(vector<long long>(a6.begin(), a6.end()),
+                                                vector<long long>(b6.begin(), b6.end()));
         res.sign = sign * v.sign;
-        for (int i = 0, carry = 0; i < int(c.size()); i++) {
-            long long cur = c[i] + carry;
+        res.a.reserve(c.size() + 2);
+        long long carry = 0;
+        for (int i = 0; i < int(c.size()) || carry; i++) {
+            long long cur = (i < int(c.size()) ? c[i] : 0) + carry;
             res.a.push_back(int(cur % 1000000));
-            carry = int(cur / 1000000);
+            carry = cur / 1000000;
         }
         res.a = convertBase(res.a, 6, baseDigitN);
         res.trim();
         return res;
     }
 
+    bigint multiplyNTT(const bigint& v) const {
+        bigint res;
+        if (a.empty() || v.a.empty())
+            return res;
+        res.sign = sign * v.sign;
+        res.a = multiplyNTT(convertBase(a, baseDigitN, 6), convertBase(v.a, baseDigitN, 6));
+        res.a = convertBase(res.a, 6, baseDigitN);
+        res.trim();
+        return res;
+    }
+
 
     static vector<int> multiplyFFT(const vector<int>& a, const vector<int>& b) {
         auto c = PolyFFT::multiply(a, b);
@@ -351,46 +419,130 @@ struct bigint {
         return res;
     }
 
+    // a, b : base 10^6 limbs, any lengths
     static vector<long long> multiplyKaratsuba(const vector<long long>& a, const vector<long long>& b) {
-        int n = int(a.size());
-        vector<long long> res(n + n);
+        const vector<long long>& x = (a.size() >= b.size()) ? a : b;
+        const vector<long long>& y = (a.size() >= b.size()) ? b : a;
+        int n = int(x.size());
+        int m = int(y.size());
+
+        vector<long long> res(n + m);
+        if (m == 0)
+            return res;
+
+        // the longer operand is cut into pieces as long as the shorter one
+        vector<long long> piece(m), prod(2 * m), tmp(4 * m + 256);
+        for (int i = 0; i < n; i += m) {
+            int len = min(m, n - i);
+            copy(x.begin() + i, x.begin() + i + len, piece.begin());
+            fill(piece.begin() + len, piece.end(), 0);
+            multiplyKaratsuba(piece.data(), y.data(), m, prod.data(), tmp.data());
+            for (int j = 0; j < len + m - 1; j++)
+                res[i + j] += prod[j];
+        }
+        return res;
+    }
+
+    // res[0, 2n) = a[0, n) * b[0, n), tmp must have 4n + 256 elements
+    static void multiplyKaratsuba(const long long* a, const long long* b, int n, long long* res, long long* tmp) {
         if (n <= 32) {
-            for (int i = 0; i < n; i++)
+            fill(res, res + 2 * n, 0);
+            for (int i = 0; i < n; i++) {
                 for (int j = 0; j < n; j++)
                     res[i + j] += a[i] * b[j];
-            return res;
+            }
+            return;
         }
 
         int k = n >> 1;
-        vector<long long> a1(a.begin(), a.begin() + k);
-        vector<long long> a2(a.begin() + k, a.end());
-        vector<long long> b1(b.begin(), b.begin() + k);
-        vector<long long> b2(b.begin() + k, b.end());
-
-        vector<long long> a1b1 = multiplyKaratsuba(a1, b1);
-        vector<long long> a2b2 = multiplyKaratsuba(a2, b2);
-
-        for (int i = 0; i < k; i++)
-            a2[i] += a1[i];
-        for (int i = 0; i < k; i++)
-            b2[i] += b1[i];
-
-        vector<long long> r = multiplyKaratsuba(a2, b2);
-        for (int i = 0; i < int(a1b1.size()); i++)
-            r[i] -= a1b1[i];
-        for (int i = 0; i < int(a2b2.size()); i++)
-            r[i] -= a2b2[i];
-
-        for (int i = 0; i < int(r.size()); i++)
-            res[i + k] += r[i];
-        for (int i = 0; i < int(a1b1.size()); i++)
-            res[i] += a1b1[i];
-        for (int i = 0; i < int(a2b2.size()); i++)
-            res[i + n] += a2b2[i];
+        int h = n - k;
+        multiplyKaratsuba(a, b, k, res, tmp);                   // a1b1 -> res[0, 2k)
+        multiplyKaratsuba(a + k, b + k, h, res + 2 * k, tmp);   // a2b2 -> res[2k, 2n)
+
+        long long* sa = tmp;
+        long long* sb = tmp + h;
+        long long* r = tmp + 2 * h;
+        for (int i = 0; i < h; i++) {
+            sa[i] = a[k + i] + (i < k ? a[i] : 0);
+            sb[i] = b[k + i] + (i < k ? b[i] : 0);
+        }
+        multiplyKaratsuba(sa, sb, h, r, tmp + 4 * h);
+
+        for (int i = 0; i < 2 * k; i++)
+            r[i] -= res[i];
+        for (int i = 0; i < 2 * h; i++)
+            r[i] -= res[2 * k + i];
+        for (int i = 0; i < 2 * h - 1; i++)
+            res[k + i] += r[i];
+    }
+
+    // a, b : limbs of 'limbBase' (<= 10^6), the result must have less than 2^23 limbs
+    static vector<int> multiplyNTT(const vector<int>& a, const vector<int>& b, int limbBase = 1000000) {
+        static const int M1 = 167772161;
+        static const int M2 = 469762049;
+        static const int M3 = 998244353;
+        static NTTMontgomery ntt1(M1, 3);
+        static NTTMontgomery ntt2(M2, 3);
+        static NTTMontgomery ntt3(M3, 3);
+
+        vector<int> x, y, z;
+        ntt1.multiply(a, b, x);
+        ntt2.multiply(a, b, y);
+        ntt3.multiply(a, b, z);
+
+        const long long m1InvM2 = powMod(M1, M2 - 2, M2);
+        const long long m12InvM3 = powMod(1ll * M1 * M2 % M3, M3 - 2, M3);
+        const unsigned long long m12 = 1ull * M1 * M2;
+
+        // each column is less than 2^63, so it's recovered exactly in 64-bit arithmetic
+        vector<int> res;
+        res.reserve(x.size() + 4);
+        unsigned long long carry = 0;
+        for (int i = 0; i < int(x.size()); i++) {
+            long long t2 = (y[i] - x[i]) % M2;
+            if (t2 < 0)
+                t2 += M2;
+            t2 = t2 * m1InvM2 % M2;
+            unsigned long long v12 = x[i] + 1ull * M1 * t2;
+
+            long long t3 = (z[i] - (long long)(v12 % M3)) % M3;
+            if (t3 < 0)
+                t3 += M3;
+            t3 = t3 * m12InvM3 % M3;
+
+            carry += v12 + m12 * (unsigned long long)t3;
+            res.push_back(int(carry % limbBase));
+            carry /= limbBase;
+        }
+        while (carry) {
+            res.push_back(int(carry % limbBase));
+            carry /= limbBase;
+        }
+        while (!res.empty() && res.back() == 0)
+            res.pop_back();
+
+        return res;
+    }
+
+    static long long powMod(long long x, long long n, long long mod) {
+        long long res = 1;
+        for (x %= mod; n > 0; n >>= 1, x = x * x % mod) {
+            if (n & 1)
+                res = res * x % mod;
+        }
         return res;
     }
 
+    //--- division
+
     friend pair<bigint, bigint> divMod(const bigint& a1, const bigint& b1) {
+        if (int(b1.a.size()) >= BIGINT_NEWTON_THRESHOLD
+            && int(a1.a.size()) - int(b1.a.size()) >= BIGINT_NEWTON_THRESHOLD)
+            return divModNewton(a1, b1);
+        return divModSimple(a1, b1);
+    }
+
+    static pair<bigint, bigint> divModSimple(const bigint& a1, const bigint& b1) {
         int norm = base / (b1.a.back() + 1);
         bigint a = a1.abs() * norm;
         bigint b = b1.abs() * norm;
@@ -416,6 +568,70 @@ struct bigint {
         return make_pair(q, r / norm);
     }
 
+    // q = (a * floor(base^(n) / b)) / base^n, then corrected by a few steps
+    static pair<bigint, bigint> divModNewton(const bigint& a1, const bigint& b1) {
+        bigint a = a1.abs();
+        bigint b = b1.abs();
+
+        int n = int(a.a.size());
+        int m = int(b.a.size());
+        if (n < m)
+            return make_pair(bigint(0), a1);
+
+        int k = n - m;
+        bigint q = (a * reciprocal(b, k)).shiftRightLimbs(m + k);
+        bigint r = a - q * b;
+        int corrections = 0;
+        while (r.sign < 0) {
+            q -= bigint(1);
+            r += b;
+            assert(++corrections <= BIGINT_NEWTON_MAX_CORRECTIONS);
+        }
+        while (r >= b) {
+            q += bigint(1);
+            r -= b;
+            assert(++corrections <= BIGINT_NEWTON_MAX_CORRECTIONS);
+        }
+
+        q.sign = a1.sign * b1.sign;
+        r.sign = a1.sign;
+        q.trim();
+        r.trim();
+        return make_pair(q, r);
+    }
+
+    // about floor(base^(m + k) / b), b has m limbs, the error is at most 2
+    //  - only the top (k + 2) limbs of b are used
+    //  - precision is doubled by Newton's iteration, x' = x * (2 - b * x)
+    static bigint reciprocal(const bigint& b, int k) {
+        int m = int(b.a.size());
+        int t = min(m, k + 2);
+        bigint bt = b.shiftRightLimbs(m - t);
+
+        bigint one = bigint(1).shiftLeftLimbs(t + k);
+        if (k < BIGINT_NEWTON_THRESHOLD)
+            return divModSimple(one, bt).first;
+
+        int h = (k >> 1) + 1;
+        bigint s = reciprocal(bt, h);                          // floor(base^(t + h) / bt)
+        bigint r = (s * 2).shiftLeftLimbs(k - h) - (bt * (s * s)).shiftRightLimbs(t + 2 * h - k);
+
+        // r = floor(base^(t + k) / bt)
+        bigint prod = bt * r;
+        int corrections = 0;
+        while (prod > one) {
+            r -= bigint(1);
+            prod -= bt;
+            assert(++corrections <= BIGINT_NEWTON_MAX_CORRECTIONS);
+        }
+        while (prod + bt <= one) {
+            r += bigint(1);
+            prod += bt;
+            assert(++corrections <= BIGINT_NEWTON_MAX_CORRECTIONS);
+        }
+        return r;
+    }
+
     friend bigint gcd(const bigint &a, const bigint &b) {
         return b.isZero() ? a : gcd(b, a % b);
     }
@@ -0,0 +1,165 @@
+#include <cmath>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <istream>
+#include <algorithm>
+
+using namespace std;
+
+#include "bigint64.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+static string getRandomDigits(int len) {
+    string s;
+    s += char('1' + RandInt32::get() % 9);
+    for (int i = 1; i < len; i++)
+        s += char('0' + RandInt32::get() % 10);
+    return s;
+}
+
+static bigint64 getRandomBigint64(int limbs) {
+    bigint64 res;
+    for (int i = 0; i < limbs; i++)
+        res.a.push_back(RandUInt64::get());
+    res.trim();
+    return res;
+}
+
+void testBigInt64() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "------------ Big Integer (64-bit limbs) --------------" << endl;
+    {
+        assert(bigint64(0).toString() == "0");
+        assert(bigint64(-1).toString() == "-1");
+        assert(bigint64(numeric_limits<long long>::min()).toString() == "-9223372036854775808");
+        assert(bigint64("18446744073709551616").a == (vector<unsigned long long>{ 0, 1 }));
+        assert((bigint64(1) << 64) == bigint64("18446744073709551616"));
+        assert(((bigint64(1) << 200) >> 136) == (bigint64(1) << 64));
+
+        bigint64 a("99999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999999");
+        bigint64 b("-19999999999999999999999999999999999999999999999999999999999999999999999999999999999999998");
+        cout << "a * b = " << a * b << endl;
+        cout << "a / b = " << a / b << endl;
+        cout << "a % b = " << a % b << endl;
+        assert((a * b).toBigint() == a.toBigint() * b.toBigint());
+    }
+    {
+        // conversions and arithmetic vs bigint
+        int lens[] = { 1, 18, 20, 300, 700, 1000, 5000, 30000, 100000 };
+        for (int len1 : lens) {
+            for (int len2 : lens) {
+                if (len1 > len2 || 1ll * len1 * len2 > 1000000000ll)
+                    continue;
+                string s1 = getRandomDigits(len1);
+                string s2 = (RandInt32::get() & 1 ? "-" : "") + getRandomDigits(len2);
+                bigint x1(s1), x2(s2);
+                bigint64 y1(s1), y2(s2);
+                assert(y1.toString() == s1 && y2.toString() == s2);
+                assert(bigint64(x1) == y1 && y2.toBigint() == x2);
+
+                assert((y1 + y2).toBigint() == x1 + x2);
+                assert((y1 - y2).toBigint() == x1 - x2);
+                assert((y2 - y1).toBigint() == x2 - x1);
+                assert((y1 * y2).toBigint() == x1 * x2);
+                assert((y1 < y2) == (x1 < x2));
+            }
+        }
+    }
+    {
+        // every multiplication path
+        int lens[] = { 1, 20, 31, 32, 100, 1023, 1024, 3000 };
+        for (int n : lens) {
+            for (int m : lens) {
+                bigint64 x = getRandomBigint64(n);
+                bigint64 y = getRandomBigint64(m);
+                vector<unsigned long long> gt(n + m);
+                bigint64::multiplySimple(x.a.data(), n, y.a.data(), m, gt.data());
+                while (!gt.empty() && gt.back() == 0)
+                    gt.pop_back();
+                assert((x * y).a == gt);
+            }
+        }
+        bigint64 x = getRandomBigint64(1000);
+        assert(x % 1000000007ull == (unsigned long long)(x.toBigint() % 1000000007));
+        bigint64 y = x;
+        assert(y.divSmall(12345) == (unsigned long long)(x.toBigint() % 12345));
+        assert(y.toBigint() == x.toBigint() / 12345);
+    }
+    {
+        cout << "*** Speed test : multiplication (bigint vs bigint64) ***" << endl;
+        for (int digits = 1000; digits <= 1000000; digits *= 10) {
+            string s1 = getRandomDigits(digits), s2 = getRandomDigits(digits);
+            bigint x1(s1), x2(s2);
+            bigint64 y1(s1), y2(s2);
+            int T = min(1000, max(1, 1000000000 / digits / digits));
+            cout << "digits = " << digits << ", " << T << " times" << endl;
+
+            cout << "  bigint : ";
+            PROFILE_START(0);
+            for (int i = 0; i < T; i++) {
+                bigint z = x1 * x2;
+                if (z.sign < 0)
+                    cout << "What?" << endl;
+            }
+            PROFILE_STOP(0);
+
+            cout << "  bigint64 : ";
+            PROFILE_START(1);
+            for (int i = 0; i < T; i++) {
+                bigint64 z = y1 * y2;
+                if (z.sign < 0)
+                    cout << "What?" << endl;
+            }
+            PROFILE_STOP(1);
+        }
+    }
+    {
+        int digits = 1000000;
+#ifdef _DEBUG
+        digits = 10000;
+#endif
+        cout << "*** Speed test : radix conversion (" << digits << " digits) ***" << endl;
+        string s = getRandomDigits(digits);
+
+        cout << "  parsing (divide and conquer) : ";
+        PROFILE_START(2);
+        bigint64 x(s);
+        PROFILE_STOP(2);
+
+        cout << "  printing (divide and conquer) : ";
+        PROFILE_START(3);
+        string t = x.toString();
+        PROFILE_STOP(3);
+        assert(s == t);
+
+        // Horner's method on 18-digit blocks, O(n^2)
+        int naiveDigits = digits / 10;
+        cout << "  parsing " << naiveDigits << " digits (Horner's method) : ";
+        PROFILE_START(4);
+        bigint64 y;
+        for (int i = 0; i < naiveDigits; i += 18) {
+            int len = min(18, naiveDigits - i);
+            unsigned long long p = 1, v = 0;
+            for (int j = 0; j < len; j++) {
+                p *= 10;
+                v = v * 10 + (s[i + j] - '0');
+            }
+            y *= p;
+            y += bigint64((long long)v);
+        }
+        PROFILE_STOP(4);
+        assert(y == bigint64(s.substr(0, naiveDigits)));
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,601 @@
+#pragma once
+
+#include "bigint.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// multiplication : schoolbook -> Karatsuba -> NTT, by the length of the shorter operand (in 64-bit limbs)
+#ifndef BIGINT64_KARATSUBA_THRESHOLD
+#define BIGINT64_KARATSUBA_THRESHOLD    32
+#endif
+#ifndef BIGINT64_NTT_THRESHOLD
+#define BIGINT64_NTT_THRESHOLD          1024
+#endif
+
+// LSB first, 2^64 limbs
+//  - limb products are done in 128 bits (unsigned __int128, or _umul128() on MSVC)
+//  - NTT multiplication runs on 16-bit digits with bigint::multiplyNTT()
+//  - decimal conversion is divide-and-conquer over cached powers, O(M(n) log n) instead of O(n^2)
+//  - general division and decimal I/O go through bigint
+struct bigint64 {
+    typedef unsigned long long LimbT;
+
+    vector<LimbT> a;
+    int sign;
+
+    bigint64() : sign(1) {
+    }
+
+    explicit bigint64(long long v) {
+        *this = v;
+    }
+
+    explicit bigint64(const string& s) {
+        *this = bigint64(bigint(s));
+    }
+
+    explicit bigint64(const bigint& v) : sign(v.sign) {
+        if (!v.a.empty()) {
+            vector<vector<LimbT>>& pw = getDecimalPowers();
+            a = fromDecimal(v.a, 0, int(v.a.size()), pw);
+        }
+        trim();
+    }
+
+    bigint64& operator =(long long v) {
+        sign = 1;
+        a.clear();
+        if (v < 0) {
+            sign = -1;
+            a.push_back(0ull - (unsigned long long)v);
+        } else if (v > 0) {
+            a.push_back((unsigned long long)v);
+        }
+        return *this;
+    }
+
+    bigint toBigint() const {
+        bigint res;
+        if (a.empty())
+            return res;
+        vector<bigint>& pw = getBinaryPowers();
+        res = toDecimal(a, 0, int(a.size()), pw);
+        res.sign = sign;
+        res.trim();
+        return res;
+    }
+
+    string toString() const {
+        bigint v = toBigint();
+
+        string res;
+        if (v.sign < 0)
+            res.push_back('-');
+        res += to_string(v.a.empty() ? 0 : v.a.back());
+        for (int i = int(v.a.size()) - 2; i >= 0; i--) {
+            char buf[bigint::baseDigitN];
+            for (int j = bigint::baseDigitN - 1, x = v.a[i]; j >= 0; j--, x /= 10)
+                buf[j] = char('0' + x % 10);
+            res.append(buf, bigint::baseDigitN);
+        }
+        return res;
+    }
+
+
+    bool isZero() const {
+        return a.empty();
+    }
+
+    bigint64 operator -() const {
+        bigint64 res = *this;
+        if (!res.a.empty())
+            res.sign = -sign;
+        return res;
+    }
+
+    bigint64 abs() const {
+        bigint64 res = *this;
+        res.sign = 1;
+        return res;
+    }
+
+    int bitLength() const {
+        if (a.empty())
+            return 0;
+        int res = int(a.size() - 1) * 64;
+        for (LimbT x = a.back(); x; x >>= 1)
+            res++;
+        return res;
+    }
+
+
+    bigint64 operator +(const bigint64& v) const {
+        if (sign == v.sign) {
+            bigint64 res;
+            res.sign = sign;
+            res.a = addMag(a, v.a);
+            return res;
+        }
+        return *this - (-v);
+    }
+
+    bigint64& operator +=(const bigint64& v) {
+        *this = move(*this + v);
+        return *this;
+    }
+
+    bigint64 operator -(const bigint64& v) const {
+        if (sign == v.sign) {
+            bigint64 res;
+            if (compareMag(a, v.a) >= 0) {
+                res.sign = sign;
+                res.a = subMag(a, v.a);
+            } else {
+                res.sign = -sign;
+                res.a = subMag(v.a, a);
+            }
+            res.trim();
+            return res;
+        }
+        return *this + (-v);
+    }
+
+    bigint64& operator -=(const bigint64& v) {
+        *this = move(*this - v);
+        return *this;
+    }
+
+    bigint64 operator *(const bigint64& v) const {
+        bigint64 res;
+        if (a.empty() || v.a.empty())
+            return res;
+        res.sign = sign * v.sign;
+        res.a = multiplyMag(a, v.a);
+        res.trim();
+        return res;
+    }
+
+    bigint64& operator *=(const bigint64& v) {
+        *this = move(*this * v);
+        return *this;
+    }
+
+    bigint64 operator /(const bigint64& v) const {
+        return bigint64(toBigint() / v.toBigint());
+    }
+
+    bigint64& operator /=(const bigint64& v) {
+        *this = move(*this / v);
+        return *this;
+    }
+
+    bigint64 operator %(const bigint64& v) const {
+        return bigint64(toBigint() % v.toBigint());
+    }
+
+    bigint64& operator %=(const bigint64& v) {
+        *this = move(*this % v);
+        return *this;
+    }
+
+
+    bigint64& operator *=(LimbT v) {
+        if (v == 0) {
+            a.clear();
+            sign = 1;
+            return *this;
+        }
+        LimbT carry = mulAddSmall(a.data(), int(a.size()), v, 0);
+        if (carry)
+            a.push_back(carry);
+        return *this;
+    }
+
+    bigint64 operator *(LimbT v) const {
+        bigint64 res = *this;
+        res *= v;
+        return res;
+    }
+
+    // returns the remainder of the magnitude
+    LimbT divSmall(LimbT v) {
+        LimbT rem = 0;
+        for (int i = int(a.size()) - 1; i >= 0; i--)
+            a[i] = divWide(rem, a[i], v, rem);
+        trim();
+        return rem;
+    }
+
+    bigint64& operator /=(LimbT v) {
+        divSmall(v);
+        return *this;
+    }
+
+    bigint64 operator /(LimbT v) const {
+        bigint64 res = *this;
+        res /= v;
+        return res;
+    }
+
+    LimbT operator %(LimbT v) const {
+        LimbT rem = 0;
+        for (int i = int(a.size()) - 1; i >= 0; i--)
+            divWide(rem, a[i], v, rem);
+        return rem;
+    }
+
+    // shifts of the magnitude
+    bigint64 operator <<(int n) const {
+        bigint64 res;
+        if (a.empty())
+            return res;
+        int limbs = n >> 6, bits = n & 63;
+        res.sign = sign;
+        res.a.assign(a.size() + limbs + 1, 0);
+        for (int i = 0; i < int(a.size()); i++) {
+            res.a[i + limbs] |= a[i] << bits;
+            if (bits)
+                res.a[i + limbs + 1] = a[i] >> (64 - bits);
+        }
+        res.trim();
+        return res;
+    }
+
+    bigint64 operator >>(int n) const {
+        bigint64 res;
+        int limbs = n >> 6, bits = n & 63;
+        if (limbs >= int(a.size()))
+            return res;
+        res.sign = sign;
+        res.a.assign(a.begin() + limbs, a.end());
+        if (bits) {
+            for (int i = 0; i < int(res.a.size()); i++) {
+                res.a[i] >>= bits;
+                if (i + 1 < int(res.a.size()))
+                    res.a[i] |= res.a[i + 1] << (64 - bits);
+            }
+        }
+        res.trim();
+        return res;
+    }
+
+
+    bool operator <(const bigint64& v) const {
+        if (sign != v.sign)
+            return sign < v.sign;
+        int cmp = compareMag(a, v.a);
+        return sign > 0 ? cmp < 0 : cmp > 0;
+    }
+
+    bool operator >(const bigint64& v) const {
+        return v < *this;
+    }
+
+    bool operator <=(const bigint64& v) const {
+        return !(v < *this);
+    }
+
+    bool operator >=(const bigint64& v) const {
+        return !(*this < v);
+    }
+
+    bool operator ==(const bigint64& v) const {
+        return sign == v.sign && a == v.a;
+    }
+
+    bool operator !=(const bigint64& v) const {
+        return !(*this == v);
+    }
+
+
+    void trim() {
+        while (!a.empty() && a.back() == 0)
+            a.pop_back();
+        if (a.empty())
+            sign = 1;
+    }
+
+    //--- limb operations
+
+    // returns the low 64 bits, 'hi' gets the high 64 bits
+    static LimbT mulWide(LimbT x, LimbT y, LimbT& hi) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _umul128(x, y, &hi);
+#else
+        unsigned __int128 t = (unsigned __int128)x * y;
+        hi = LimbT(t >> 64);
+        return LimbT(t);
+#endif
+    }
+
+    // (hi * 2^64 + lo) / d, hi < d
+    static LimbT divWide(LimbT hi, LimbT lo, LimbT d, LimbT& rem) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _udiv128(hi, lo, d, &rem);
+#else
+        unsigned __int128 t = ((unsigned __int128)hi << 64) | lo;
+        rem = LimbT(t % d);
+        return LimbT(t / d);
+#endif
+    }
+
+    // x[0, n) = x[0, n) * mul + add, returns carry
+    static LimbT mulAddSmall(LimbT* x, int n, LimbT mul, LimbT add) {
+        LimbT carry = add;
+        for (int i = 0; i < n; i++) {
+            LimbT hi;
+            LimbT lo = mulWide(x[i], mul, hi);
+            lo += carry;
+            hi += lo < carry;
+            x[i] = lo;
+            carry = hi;
+        }
+        return carry;
+    }
+
+    // r[0, rn) += x[0, xn), xn <= rn, the carry out of r[rn - 1] is dropped
+    static void addInPlace(LimbT* r, int rn, const LimbT* x, int xn) {
+        LimbT carry = 0;
+        int i = 0;
+        for (; i < xn; i++) {
+            LimbT t = r[i] + carry;
+            carry = t < carry;
+            r[i] = t + x[i];
+            carry += r[i] < t;
+        }
+        for (; carry && i < rn; i++)
+            carry = (++r[i] == 0);
+    }
+
+    // r[0, rn) -= x[0, xn), r >= x
+    static void subInPlace(LimbT* r, int rn, const LimbT* x, int xn) {
+        LimbT borrow = 0;
+        int i = 0;
+        for (; i < xn; i++) {
+            LimbT t = r[i] - borrow;
+            borrow = t > r[i];
+            borrow += t < x[i];
+            r[i] = t - x[i];
+        }
+        for (; borrow && i < rn; i++)
+            borrow = (r[i]-- == 0);
+    }
+
+    // r[0, xn + yn) = x * y
+    static void multiplySimple(const LimbT* x, int xn, const LimbT* y, int yn, LimbT* r) {
+        fill(r, r + xn + yn, 0);
+        for (int i = 0; i < xn; i++) {
+            LimbT carry = 0;
+            for (int j = 0; j < yn; j++) {
+                LimbT hi;
+                LimbT lo = mulWide(x[i], y[j], hi);
+                lo += r[i + j];
+                hi += lo < r[i + j];
+                lo += carry;
+                hi += lo < carry;
+                r[i + j] = lo;
+                carry = hi;
+            }
+            r[i + yn] = carry;
+        }
+    }
+
+    // r[0, 2n) = x[0, n) * y[0, n), tmp must have 4n + 256 limbs
+    static void multiplyKaratsuba(const LimbT* x, const LimbT* y, int n, LimbT* r, LimbT* tmp) {
+        if (n < max(BIGINT64_KARATSUBA_THRESHOLD, 4)) {
+            multiplySimple(x, n, y, n, r);
+            return;
+        }
+
+        int k = n >> 1;
+        int h = n - k;
+        multiplyKaratsuba(x, y, k, r, tmp);                     // x1y1 -> r[0, 2k)
+        multiplyKaratsuba(x + k, y + k, h, r + 2 * k, tmp);     // x2y2 -> r[2k, 2n)
+
+        LimbT* sx = tmp;
+        LimbT* sy = tmp + (h + 1);
+        LimbT* p = tmp + 2 * (h + 1);
+        copy(x + k, x + n, sx);
+        sx[h] = 0;
+        addInPlace(sx, h + 1, x, k);
+        copy(y + k, y + n, sy);
+        sy[h] = 0;
+        addInPlace(sy, h + 1, y, k);
+        multiplyKaratsuba(sx, sy, h + 1, p, tmp + 4 * (h + 1));
+
+        subInPlace(p, 2 * h + 2, r, 2 * k);
+        subInPlace(p, 2 * h + 2, r + 2 * k, 2 * h);
+        addInPlace(r + k, 2 * n - k, p, min(2 * h + 2, 2 * n - k));
+    }
+
+    static vector<LimbT> multiplyMag(const vector<LimbT>& a, const vector<LimbT>& b) {
+        const vector<LimbT>& x = (a.size() >= b.size()) ? a : b;
+        const vector<LimbT>& y = (a.size() >= b.size()) ? b : a;
+        int n = int(x.size());
+        int m = int(y.size());
+
+        vector<LimbT> res(n + m);
+        if (m == 0)
+            return res;
+
+        if (m < BIGINT64_KARATSUBA_THRESHOLD) {
+            multiplySimple(x.data(), n, y.data(), m, res.data());
+        } else if (m < BIGINT64_NTT_THRESHOLD) {
+            // the longer operand is cut into pieces as long as the shorter one
+            vector<LimbT> piece(m), prod(2 * m), tmp(4 * m + 256);
+            for (int i = 0; i < n; i += m) {
+                int len = min(m, n - i);
+                copy(x.begin() + i, x.begin() + i + len, piece.begin());
+                fill(piece.begin() + len, piece.end(), 0);
+                multiplyKaratsuba(piece.data(), y.data(), m, prod.data(), tmp.data());
+                addInPlace(res.data() + i, n + m - i, prod.data(), min(2 * m, n + m - i));
+            }
+        } else {
+            vector<int> c = bigint::multiplyNTT(toDigits16(x), toDigits16(y), 65536);
+            for (int i = 0; i < int(c.size()) && (i >> 2) < n + m; i++)
+                res[i >> 2] |= LimbT(c[i]) << ((i & 3) * 16);
+        }
+        return res;
+    }
+
+    static vector<int> toDigits16(const vector<LimbT>& x) {
+        vector<int> res(x.size() * 4);
+        for (int i = 0; i < int(x.size()); i++) {
+            for (int j = 0; j < 4; j++)
+                res[i * 4 + j] = int((x[i] >> (j * 16)) & 0xffff);
+        }
+        while (!res.empty() && res.back() == 0)
+            res.pop_back();
+        return res;
+    }
+
+    static int compareMag(const vector<LimbT>& x, const vector<LimbT>& y) {
+        if (x.size() != y.size())
+            return x.size() < y.size() ? -1 : 1;
+        for (int i = int(x.size()) - 1; i >= 0; i--) {
+            if (x[i] != y[i])
+                return x[i] < y[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static vector<LimbT> addMag(const vector<LimbT>& x, const vector<LimbT>& y) {
+        const vector<LimbT>& l = (x.size() >= y.size()) ? x : y;
+        const vector<LimbT>& s = (x.size() >= y.size()) ? y : x;
+        vector<LimbT> res(l.size() + 1);
+        copy(l.begin(), l.end(), res.begin());
+        addInPlace(res.data(), int(res.size()), s.data(), int(s.size()));
+        if (res.back() == 0)
+            res.pop_back();
+        return res;
+    }
+
+    // x >= y
+    static vector<LimbT> subMag(const vector<LimbT>& x, const vector<LimbT>& y) {
+        vector<LimbT> res = x;
+        subInPlace(res.data(), int(res.size()), y.data(), int(y.size()));
+        return res;
+    }
+
+    //--- radix conversion
+
+    static const int CONVERSION_BLOCK = 32;     // limbs converted by Horner's method
+
+    // (10^9)^(CONVERSION_BLOCK * 2^i) in binary
+    static vector<vector<LimbT>>& getDecimalPowers() {
+        static vector<vector<LimbT>> pw;
+        return pw;
+    }
+
+    // (2^64)^(CONVERSION_BLOCK * 2^i) in decimal
+    static vector<bigint>& getBinaryPowers() {
+        static vector<bigint> pw;
+        return pw;
+    }
+
+    // base 10^9 limbs a[lo, hi) -> binary
+    static vector<LimbT> fromDecimal(const vector<int>& a, int lo, int hi, vector<vector<LimbT>>& pw) {
+        int n = hi - lo;
+        if (n <= CONVERSION_BLOCK) {
+            vector<LimbT> res;
+            for (int i = hi - 1; i >= lo; i--) {
+                LimbT carry = mulAddSmall(res.data(), int(res.size()), LimbT(bigint::base), LimbT(a[i]));
+                if (carry)
+                    res.push_back(carry);
+            }
+            return res;
+        }
+
+        int level = 0;
+        while ((CONVERSION_BLOCK << (level + 1)) < n)
+            level++;
+        while (int(pw.size()) <= level) {
+            if (pw.empty()) {
+                vector<LimbT> x(1, 1);
+                for (int i = 0; i < CONVERSION_BLOCK; i++) {
+                    LimbT carry = mulAddSmall(x.data(), int(x.size()), LimbT(bigint::base), 0);
+                    if (carry)
+                        x.push_back(carry);
+                }
+                pw.push_back(x);
+            } else {
+                vector<LimbT> x = multiplyMag(pw.back(), pw.back());
+                while (!x.empty() && x.back() == 0)
+                    x.pop_back();
+                pw.push_back(x);
+            }
+        }
+
+        int mid = lo + (CONVERSION_BLOCK << level);
+        vector<LimbT> high = fromDecimal(a, mid, hi, pw);
+        vector<LimbT> low = fromDecimal(a, lo, mid, pw);
+
+        vector<LimbT> res;
+        if (!high.empty())
+            res = multiplyMag(high, pw[level]);
+        if (res.size() < low.size() + 1)
+            res.resize(low.size() + 1);
+        addInPlace(res.data(), int(res.size()), low.data(), int(low.size()));
+        while (!res.empty() && res.back() == 0)
+            res.pop_back();
+        return res;
+    }
+
+    // x = x * mul + add, mul <= 2^32
+    static void mulAddSmall(bigint& x, long long mul, long long add) {
+        long long carry = add;
+        for (int i = 0; i < int(x.a.size()); i++) {
+            long long cur = x.a[i] * mul + carry;
+            x.a[i] = int(cur % bigint::base);
+            carry = cur / bigint::base;
+        }
+        for (; carry > 0; carry /= bigint::base)
+            x.a.push_back(int(carry % bigint::base));
+    }
+
+    // binary limbs a[lo, hi) -> decimal
+    static bigint toDecimal(const vector<LimbT>& a, int lo, int hi, vector<bigint>& pw) {
+        int n = hi - lo;
+        if (n <= CONVERSION_BLOCK) {
+            bigint res;
+            for (int i = hi - 1; i >= lo; i--) {
+                mulAddSmall(res, 1ll << 32, (long long)(a[i] >> 32));
+                mulAddSmall(res, 1ll << 32, (long long)(a[i] & 0xffffffffull));
+            }
+            res.trim();
+            return res;
+        }
+
+        int level = 0;
+        while ((CONVERSION_BLOCK << (level + 1)) < n)
+            level++;
+        while (int(pw.size()) <= level) {
+            if (pw.empty()) {
+                bigint x(1);
+                for (int i = 0; i < CONVERSION_BLOCK * 2; i++)
+                    mulAddSmall(x, 1ll << 32, 0);
+                pw.push_back(x);
+            } else {
+                pw.push_back(pw.back() * pw.back());
+            }
+        }
+
+        int mid = lo + (CONVERSION_BLOCK << level);
+        bigint res = toDecimal(a, mid, hi, pw) * pw[level];
+        res += toDecimal(a, lo, mid, pw);
+        return res;
+    }
+};
+
+inline istream& operator >>(istream& is, bigint64& v) {
+    string s;
+    is >> s;
+    v = bigint64(s);
+    return is;
+}
+
+inline ostream& operator <<(ostream& os, const bigint64& v) {
+    return os << v.toString();
+}
@@ -19,6 +19,8 @@ int main(void) {
     TEST(Equations);
     TEST(PrimitiveRoot);
     TEST(BigInt);
+    TEST(BigIntFast);
+    TEST(BigInt64);
     TEST(Bit);
     TEST(PrimalityTest);
     TEST(PrimalityTestFast);
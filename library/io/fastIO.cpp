@@ -0,0 +1,308 @@
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+#include "fastIO.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+static const char* makeTempFileName(const char* name) {
+    static char path[1024];
+#ifdef _WIN32
+    snprintf(path, sizeof(path), "%s\\%s", getenv("TEMP") ? getenv("TEMP") : ".", name);
+#else
+    snprintf(path, sizeof(path), "/tmp/%s", name);
+#endif
+    return path;
+}
+
+static void generateIntFile(const char* path, long long targetBytes) {
+    FILE* fp = fopen(path, "wb");
+    {
+        FastIO::Writer out(fp);
+        long long written = 0;
+        while (written < targetBytes) {
+            int x = RandInt32::get() - (numeric_limits<int>::max() >> 1);
+            out.writeInt(x);
+            out.writeChar('\n');
+            written += 12;
+        }
+    }
+    fclose(fp);
+}
+
+static void checkReader(FastIO::Reader& in, const vector<long long>& ints, const vector<unsigned long long>& uints,
+                        const vector<double>& doubles, const vector<string>& tokens, const vector<string>& lines) {
+    for (auto x : ints)
+        assert(in.readInt64() == x);
+    for (auto x : uints)
+        assert(in.readUInt64() == x);
+    for (auto x : doubles) {
+        double y = in.readDouble();
+        if (y != x)
+            cerr << "mismatched : " << x << ", " << y << endl;
+        assert(y == x);
+    }
+    for (auto& s : tokens)
+        assert(in.readString() == s);
+    int len;
+    in.readLine(len);           // rest of the current line
+    for (auto& s : lines) {
+        const char* p = in.readLine(len);
+        assert(p != nullptr && string(p, len) == s);
+    }
+    assert(in.eof());
+}
+
+void testFastIO() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- FastIO ----------" << endl;
+    {
+        int N = 10000;
+#ifdef _DEBUG
+        N = 1000;
+#endif
+        vector<long long> ints(N);
+        vector<unsigned long long> uints(N);
+        vector<double> doubles(N);
+        vector<string> tokens(N);
+        vector<string> lines(N);
+        for (int i = 0; i < N; i++) {
+            ints[i] = RandInt64::get() * ((i & 1) ? -1 : 1);
+            uints[i] = RandUInt64::get();
+            doubles[i] = double(RandInt32::get() % 2000000 - 1000000) / 1000.0;
+            tokens[i] = string(1 + RandInt32::get() % ((i % 100 == 0) ? 1000 : 10), char('a' + i % 26));
+            lines[i] = (i % 7 == 0) ? string() : (tokens[i] + " " + to_string(i) + "\t" + tokens[i]);
+        }
+        ints[0] = numeric_limits<long long>::min();
+        ints[1] = numeric_limits<long long>::max();
+        uints[0] = numeric_limits<unsigned long long>::max();
+
+        const char* path = makeTempFileName("fastIO_test.txt");
+        FILE* outFp = fopen(path, "wb");
+        {
+            FastIO::Writer out(outFp, 256);
+            for (auto x : ints) {
+                out.writeInt64(x);
+                out.writeChar(' ');
+            }
+            out.writeChar('\n');
+            for (auto x : uints) {
+                out.writeUInt64(x);
+                out.writeChar('\n');
+            }
+            for (auto x : doubles) {
+                out.writeDouble(x, 3);
+                out.writeChar(' ');
+            }
+            for (int i = 0; i < N; i++) {
+                out.write(tokens[i]);
+                out.writeChar((i + 1 < N && (RandInt32::get() & 1)) ? '\n' : ' ');
+            }
+            out.writeChar('\n');
+            for (int i = 0; i < N; i++) {
+                out.write(lines[i]);
+                out.write((i & 1) ? "\r\n" : "\n");
+            }
+        }
+        fclose(outFp);
+
+        // streaming with a small buffer
+        {
+            FILE* fp = fopen(path, "rb");
+            FastIO::Reader in(fp, 256);
+            checkReader(in, ints, uints, doubles, tokens, lines);
+            fclose(fp);
+        }
+        // mmap (or streaming on non-POSIX systems)
+        {
+            FastIO::Reader in(path);
+            checkReader(in, ints, uints, doubles, tokens, lines);
+        }
+        remove(path);
+    }
+    {
+        // values longer than the buffer of Writer
+        vector<pair<double, int>> values{ { 1e300, 6 }, { -1.7e308, 3 }, { 0.5, 600 }, { 1e20, 0 },
+                                          { 123.25, -1 }, { numeric_limits<double>::infinity(), 2 } };
+
+        const char* path = makeTempFileName("fastIO_double.txt");
+        FILE* fp = fopen(path, "wb");
+        {
+            FastIO::Writer out(fp, 256);
+            for (auto& it : values) {
+                out.writeDouble(it.first, it.second);
+                out.writeChar('\n');
+            }
+        }
+        fclose(fp);
+
+        fp = fopen(path, "rb");
+        FastIO::Reader in(fp, 256);
+        for (auto& it : values) {
+            int len;
+            const char* p = in.readLine(len);
+            string gt(1024, '\0');
+            gt.resize(snprintf(&gt[0], gt.size(), "%.*f", max(it.second, 0), it.first));
+            assert(p != nullptr && string(p, len) == gt);
+        }
+        fclose(fp);
+        remove(path);
+    }
+#ifdef FASTIO_USE_SIMD
+    {
+        // SIMD parser vs scalar parser
+        int N = 1000000;
+#ifdef _DEBUG
+        N = 10000;
+#endif
+        static const char* SPACES = " \n\t\r";
+        string text;
+        for (int i = 0; i < N; i++) {
+            int sign = RandInt32::get() % 4;
+            if (sign == 1)
+                text += '-';
+            else if (sign == 2)
+                text += '+';
+            int len = 1 + RandInt32::get() % 24;
+            if (RandInt32::get() % 4)
+                len = 1 + len % 10;
+            for (int j = 0; j < len; j++)
+                text += char('0' + RandInt32::get() % 10);
+            text += SPACES[RandInt32::get() % 4];
+            if (RandInt32::get() % 8 == 0)
+                text += SPACES[RandInt32::get() % 4];
+        }
+        assert(text.length() < sizeof(FastIO::gInBuff));
+
+        const char* path = makeTempFileName("fastIO_fuzz.txt");
+        {
+            FILE* fp = fopen(path, "wb");
+            fwrite(text.data(), 1, text.length(), fp);
+            fclose(fp);
+        }
+
+        vector<long long> res[2];
+        vector<unsigned long long> resU[2];
+        vector<int> resLegacy[2];
+        for (int simd = 0; simd < 2; simd++) {
+            FastIO::gUseSIMD = (simd != 0);
+            {
+                FILE* fp = fopen(path, "rb");
+                FastIO::Reader in(fp, 1000 + simd * 17);
+                while (!in.eof())
+                    res[simd].push_back(in.readInt64());
+                fclose(fp);
+            }
+            {
+                FastIO::Reader in(path);
+                while (!in.eof())
+                    resU[simd].push_back(in.readUInt64());
+            }
+            {
+                memcpy(FastIO::gInBuff, text.data(), text.length());
+                FastIO::gInBuff[text.length()] = 0;
+                FastIO::gInPtr = FastIO::gInBuff;
+                for (int i = 0; i < N; i++)
+                    resLegacy[simd].push_back(FastIO::readInt());
+            }
+        }
+        FastIO::gUseSIMD = FastIO::hasSSE41();
+
+        assert(int(res[0].size()) == N && res[0] == res[1]);
+        assert(resU[0] == resU[1]);
+        assert(resLegacy[0] == resLegacy[1]);
+        for (int i = 0; i < N; i++)
+            assert(int(res[0][i]) == resLegacy[0][i]);
+
+        remove(path);
+    }
+#endif
+    {
+        long long BENCH_BYTES = 1ll << 30;
+#ifdef _DEBUG
+        BENCH_BYTES = 1ll << 24;
+#endif
+        cout << "*** Speed test (" << (BENCH_BYTES >> 20) << " MB) ***" << endl;
+
+        const char* path = makeTempFileName("fastIO_bench.txt");
+        generateIntFile(path, BENCH_BYTES);
+
+        long long sum1 = 0, sum2 = 0, sum3 = 0, sum4 = 0;
+
+        cout << "  scanf() : ";
+        PROFILE_START(0);
+        {
+            FILE* fp = fopen(path, "rb");
+            int x;
+            while (fscanf(fp, "%d", &x) == 1)
+                sum1 += x;
+            fclose(fp);
+        }
+        PROFILE_STOP(0);
+
+        cout << "  ifstream >> : ";
+        PROFILE_START(1);
+        {
+            ifstream ifs(path, ios::binary);
+            int x;
+            while (ifs >> x)
+                sum2 += x;
+        }
+        PROFILE_STOP(1);
+
+        cout << "  FastIO::Reader (fread) : ";
+        PROFILE_START(2);
+        {
+            FILE* fp = fopen(path, "rb");
+            FastIO::Reader in(fp);
+            while (!in.eof())
+                sum3 += in.readInt();
+            fclose(fp);
+        }
+        PROFILE_STOP(2);
+
+        cout << "  FastIO::Reader (mmap) : ";
+        PROFILE_START(3);
+        {
+            FastIO::Reader in(path);
+            while (!in.eof())
+                sum4 += in.readInt();
+        }
+        PROFILE_STOP(3);
+
+#ifdef FASTIO_USE_SIMD
+        long long sum5 = 0;
+        FastIO::gUseSIMD = false;
+        cout << "  FastIO::Reader (mmap, scalar) : ";
+        PROFILE_START(4);
+        {
+            FastIO::Reader in(path);
+            while (!in.eof())
+                sum5 += in.readInt();
+        }
+        PROFILE_STOP(4);
+        FastIO::gUseSIMD = FastIO::hasSSE41();
+        assert(sum4 == sum5);
+#endif
+
+        remove(path);
+
+        if (sum1 != sum2 || sum1 != sum3 || sum1 != sum4)
+            cerr << "mismatched : " << sum1 << ", " << sum2 << ", " << sum3 << ", " << sum4 << endl;
+        assert(sum1 == sum2 && sum1 == sum3 && sum1 == sum4);
+    }
+
+    cout << "OK!" << endl;
+}
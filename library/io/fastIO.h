@@ -1,8 +1,73 @@
 #pragma once
 
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "../common/mappedFile.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define FASTIO_USE_SIMD
+#define FASTIO_TARGET_SSE4  __attribute__((target("sse4.1")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define FASTIO_USE_SIMD
+#define FASTIO_TARGET_SSE4
+#endif
 
 namespace FastIO {
+#ifdef FASTIO_USE_SIMD
+    inline bool hasSSE41() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 19)) != 0;
+#else
+        return __builtin_cpu_supports("sse4.1") != 0;
+#endif
+    }
+
+    // set false to force the scalar parser
+    bool gUseSIMD = hasSSE41();
+
+    // Parses up to 16 leading digits of p[0..15] at once, all 16 bytes must be readable.
+    // Returns the number of digits, and the value of them in 'value'.
+    FASTIO_TARGET_SSE4 inline int parseDigits16(const char* p, unsigned long long& value) {
+        // shuffle masks to right-align n digits : SHUFFLE + n
+        static const signed char SHUFFLE[32] = {
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15
+        };
+
+        __m128i v = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(9)), v);
+        unsigned mask = unsigned(_mm_movemask_epi8(isDigit));
+
+#ifdef _MSC_VER
+        unsigned long n;
+        _BitScanForward(&n, ~mask);     // 0 <= n <= 16
+#else
+        int n = __builtin_ctz(~mask);   // 0 <= n <= 16
+#endif
+        if (n == 0) {
+            value = 0;
+            return 0;
+        }
+
+        v = _mm_shuffle_epi8(v, _mm_loadu_si128(reinterpret_cast<const __m128i*>(SHUFFLE + n)));
+        v = _mm_maddubs_epi16(v, _mm_set1_epi16(0x010A));                       // 2 digits
+        v = _mm_madd_epi16(v, _mm_set1_epi32(0x00010064));                      // 4 digits
+        v = _mm_packus_epi32(v, v);
+        v = _mm_madd_epi16(v, _mm_set1_epi32(0x00012710));                      // 8 digits
+
+        value = 100000000ull * unsigned(_mm_cvtsi128_si32(v)) + unsigned(_mm_extract_epi32(v, 1));
+        return int(n);
+    }
+#endif
+
     char gInBuff[1 << 24];
     const char* gInPtr;
 
@@ -25,11 +90,508 @@ namespace FastIO {
             ++gInPtr;
         }
 
+#ifdef FASTIO_USE_SIMD
+        if (gUseSIMD && gInPtr + 16 <= gInBuff + sizeof(gInBuff)) {
+            unsigned long long v;
+            int n = parseDigits16(gInPtr, v);
+            u = unsigned(v);
+            gInPtr += n;
+        }
+#endif
         while (*gInPtr >= '0' && *gInPtr <= '9')
             u = (u << 3) + (u << 1) + (*gInPtr++ - '0');
 
         return static_cast<int>((u ^ s) + !!s);
     }
+
+    //-------------------------------------------------------------------------
+    // Streaming reader
+    //  - refills a buffer from a FILE*, or maps a regular file into memory (POSIX)
+    //  - input size is not limited by the buffer size
+    //  - readToken() / readLine() return a pointer into the internal buffer (no copy),
+    //    which is valid until the next read call. The token is NOT null-terminated.
+    struct Reader {
+        static const int DEFAULT_BUFFER_SIZE = 1 << 20;
+        static const int GUARD_SIZE = 64;           // a number token must not be longer than this
+
+        explicit Reader(FILE* fp = stdin, int bufferSize = DEFAULT_BUFFER_SIZE) {
+            initBuffer(bufferSize);
+            this->fp = fp;
+        }
+
+        // mmap a regular file if possible, otherwise stream it with fread()
+        explicit Reader(const char* path, int bufferSize = DEFAULT_BUFFER_SIZE) {
+            initBuffer(bufferSize);
+            open(path);
+        }
+
+        ~Reader() {
+            close();
+            free(buff);
+        }
+
+        // owns the buffer and the file (or mapping)
+        Reader(const Reader&) = delete;
+        Reader& operator =(const Reader&) = delete;
+
+        bool open(const char* path) {
+            close();
+            if (mapping.open(path, false)) {
+                mapping.adviseSequential();
+                ptr = mapping.data;
+                end = mapping.data + mapping.size;
+                return true;
+            }
+            fp = fopen(path, "rb");
+            ownFile = (fp != nullptr);
+            return ownFile;
+        }
+
+        void close() {
+            mapping.close();
+            if (ownFile) {
+                fclose(fp);
+                ownFile = false;
+            }
+            fp = nullptr;
+            ptr = end = buff;
+            eofFile = false;
+        }
+
+        // returns true if there is no more token
+        bool eof() {
+            return !skipSpaces();
+        }
+
+        //--- numbers
+
+        long long readInt64() {
+            if (!skipSpaces())
+                return 0;
+            ensure();
+
+            bool neg = false;
+            if (ptr < end && (*ptr == '-' || *ptr == '+'))
+                neg = (*ptr++ == '-');
+
+            unsigned long long u = parseDigits();
+            return neg ? static_cast<long long>(0ull - u) : static_cast<long long>(u);
+        }
+
+        unsigned long long readUInt64() {
+            if (!skipSpaces())
+                return 0;
+            ensure();
+
+            // a negative value is wrapped around like strtoull()
+            bool neg = false;
+            if (ptr < end && (*ptr == '-' || *ptr == '+'))
+                neg = (*ptr++ == '-');
+
+            unsigned long long u = parseDigits();
+            return neg ? 0ull - u : u;
+        }
+
+        int readInt() {
+            return static_cast<int>(readInt64());
+        }
+
+        unsigned readUInt() {
+            return static_cast<unsigned>(readUInt64());
+        }
+
+        // exact when the value has at most 15 significant digits and |exponent| <= 22,
+        // otherwise falls back to strtod()
+        double readDouble() {
+            if (!skipSpaces())
+                return 0.0;
+            ensure();
+
+            const char* start = ptr;
+            const char* p = ptr;
+
+            bool neg = false;
+            if (p < end && (*p == '-' || *p == '+'))
+                neg = (*p++ == '-');
+
+            unsigned long long mant = 0;
+            int digits = 0, exp10 = 0;
+            while (p < end && isDigit(*p)) {
+                if (digits < 19) {
+                    mant = mant * 10 + (*p - '0');
+                    if (mant)
+                        digits++;
+                } else {
+                    exp10++;
+                }
+                p++;
+            }
+            if (p < end && *p == '.') {
+                p++;
+                while (p < end && isDigit(*p)) {
+                    if (digits < 19) {
+                        mant = mant * 10 + (*p - '0');
+                        if (mant)
+                            digits++;
+                        exp10--;
+                    }
+                    p++;
+                }
+            }
+            if (p < end && (*p == 'e' || *p == 'E')) {
+                p++;
+                bool expNeg = false;
+                if (p < end && (*p == '-' || *p == '+'))
+                    expNeg = (*p++ == '-');
+                int e = 0;
+                while (p < end && isDigit(*p)) {
+                    if (e < 100000)
+                        e = e * 10 + (*p - '0');
+                    p++;
+                }
+                exp10 += expNeg ? -e : e;
+            }
+
+            double res;
+            if (mant < (1ull << 53) && -22 <= exp10 && exp10 <= 22) {
+                static const double pow10[23] = {
+                    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+                };
+                res = exp10 >= 0 ? double(mant) * pow10[exp10] : double(mant) / pow10[-exp10];
+                if (neg)
+                    res = -res;
+            } else {
+                res = strtod(std::string(start, p).c_str(), nullptr);
+            }
+            ptr = p;
+            return res;
+        }
+
+        //--- tokens
+
+        char readChar() {
+            if (!skipSpaces())
+                return 0;
+            return *ptr++;
+        }
+
+        // returns a space-separated token, or nullptr at the end of input
+        const char* readToken(int& len) {
+            if (!skipSpaces()) {
+                len = 0;
+                return nullptr;
+            }
+
+            size_t i = 0;
+            while (true) {
+                while (ptr + i < end && ptr[i] > ' ')
+                    i++;
+                if (ptr + i < end || !refill())
+                    break;
+            }
+            const char* res = ptr;
+            len = int(i);
+            ptr += i;
+            return res;
+        }
+
+        // returns a line without '\n' (and '\r'), or nullptr at the end of input
+        const char* readLine(int& len) {
+            if (ptr >= end && !refill()) {
+                len = 0;
+                return nullptr;
+            }
+
+            size_t i = 0;
+            while (true) {
+                const char* nl = reinterpret_cast<const char*>(memchr(ptr + i, '\n', end - ptr - i));
+                if (nl) {
+                    i = nl - ptr;
+                    break;
+                }
+                i = end - ptr;
+                if (!refill())
+                    break;
+            }
+            const char* res = ptr;
+            ptr += i;
+            if (ptr < end)
+                ptr++;      // skip '\n'
+            if (i > 0 && res[i - 1] == '\r')
+                i--;
+            len = int(i);
+            return res;
+        }
+
+        std::string readString() {
+            int len;
+            const char* s = readToken(len);
+            return s ? std::string(s, len) : std::string();
+        }
+
+        std::string readLineString() {
+            int len;
+            const char* s = readLine(len);
+            return s ? std::string(s, len) : std::string();
+        }
+
+    private:
+        FILE* fp = nullptr;
+        bool ownFile = false;
+        bool eofFile = false;
+
+        char* buff = nullptr;
+        size_t capacity = 0;
+        const char* ptr = nullptr;
+        const char* end = nullptr;
+
+        MappedFile mapping;
+
+        static bool isDigit(char c) {
+            return static_cast<unsigned char>(c - '0') < 10;
+        }
+
+        void initBuffer(int bufferSize) {
+            capacity = size_t(max(bufferSize, GUARD_SIZE * 4));
+            buff = reinterpret_cast<char*>(malloc(capacity));
+            ptr = end = buff;
+        }
+
+        // moves unread data to the front of the buffer and reads more, O(unread size)
+        // returns false if nothing more was read
+        bool refill() {
+            if (mapping.mapped) {
+                // the whole file is mapped, nothing to read
+                return false;
+            }
+            if (eofFile || !fp)
+                return false;
+
+            size_t remain = size_t(end - ptr);
+            if (remain >= capacity / 2) {
+                // a token is too long for the buffer
+                capacity <<= 1;
+                char* p = reinterpret_cast<char*>(malloc(capacity));
+                memcpy(p, ptr, remain);
+                free(buff);
+                buff = p;
+            } else if (remain > 0 && ptr != buff) {
+                memmove(buff, ptr, remain);
+            }
+            ptr = buff;
+            end = buff + remain;
+
+            size_t n = fread(buff + remain, 1, capacity - remain, fp);
+            if (n == 0) {
+                eofFile = true;
+                return false;
+            }
+            end += n;
+            return true;
+        }
+
+        // makes at least GUARD_SIZE bytes available unless it's the end of input
+        void ensure() {
+            if (end - ptr < GUARD_SIZE)
+                refill();
+        }
+
+        // returns false at the end of input
+        bool skipSpaces() {
+            while (true) {
+                while (ptr < end && *ptr <= ' ')
+                    ++ptr;
+                if (ptr < end)
+                    return true;
+                if (!refill())
+                    return false;
+            }
+        }
+
+        unsigned long long parseDigits() {
+            unsigned long long u = 0;
+#ifdef FASTIO_USE_SIMD
+            if (gUseSIMD && end - ptr >= 16) {
+                ptr += parseDigits16(ptr, u);
+                if (ptr >= end || !isDigit(*ptr))
+                    return u;
+            }
+#endif
+            while (ptr < end && isDigit(*ptr))
+                u = u * 10 + (*ptr++ - '0');
+            return u;
+        }
+    };
+
+    //-------------------------------------------------------------------------
+    // Buffered writer
+    struct Writer {
+        static const int DEFAULT_BUFFER_SIZE = 1 << 20;
+
+        explicit Writer(FILE* fp = stdout, int bufferSize = DEFAULT_BUFFER_SIZE) {
+            this->fp = fp;
+            capacity = size_t(max(bufferSize, 256));
+            buff = reinterpret_cast<char*>(malloc(capacity));
+            ptr = buff;
+        }
+
+        ~Writer() {
+            flush();
+            free(buff);
+        }
+
+        // owns the buffer
+        Writer(const Writer&) = delete;
+        Writer& operator =(const Writer&) = delete;
+
+        void flush() {
+            if (ptr > buff) {
+                fwrite(buff, 1, ptr - buff, fp);
+                ptr = buff;
+            }
+            fflush(fp);
+        }
+
+        //--- numbers
+
+        void writeInt64(long long x) {
+            reserve(24);
+            if (x < 0) {
+                *ptr++ = '-';
+                writeDigits(0ull - static_cast<unsigned long long>(x));
+            } else {
+                writeDigits(static_cast<unsigned long long>(x));
+            }
+        }
+
+        void writeUInt64(unsigned long long x) {
+            reserve(24);
+            writeDigits(x);
+        }
+
+        void writeInt(int x) {
+            writeInt64(x);
+        }
+
+        void writeUInt(unsigned x) {
+            writeUInt64(x);
+        }
+
+        // fixed-point notation with 'precision' digits below the decimal point
+        void writeDouble(double x, int precision = 6) {
+            if (precision < 0)
+                precision = 0;
+            if (!(x == x) || x >= 1e18 || x <= -1e18 || precision > 17) {
+                // NaN, infinity or too large values, formatted out of the buffer
+                //  : sign + integer digits (up to 309) + '.' + precision + NUL
+                int exponent = 0;
+                if (x - x == 0.0)
+                    frexp(x, &exponent);
+                int size = max(exponent, 0) * 30103 / 100000 + precision + 8;
+                string s(size, '\0');
+                int len = snprintf(&s[0], s.size(), "%.*f", precision, x);
+                if (len > 0)
+                    write(s.data(), size_t(min(len, size - 1)));
+                return;
+            }
+
+            reserve(48);
+            if (x < 0) {
+                *ptr++ = '-';
+                x = -x;
+            }
+
+            unsigned long long scale = 1;
+            for (int i = 0; i < precision; i++)
+                scale *= 10;
+
+            unsigned long long ip = static_cast<unsigned long long>(x);
+            double frac = (x - double(ip)) * double(scale) + 0.5;
+            unsigned long long fracPart = static_cast<unsigned long long>(frac);
+            if (fracPart >= scale) {
+                ip++;
+                fracPart -= scale;
+            }
+
+            writeDigits(ip);
+            if (precision > 0) {
+                *ptr++ = '.';
+                char* p = ptr + precision;
+                for (int i = 0; i < precision; i++) {
+                    *--p = char('0' + fracPart % 10);
+                    fracPart /= 10;
+                }
+                ptr += precision;
+            }
+        }
+
+        //--- tokens
+
+        void writeChar(char c) {
+            reserve(1);
+            *ptr++ = c;
+        }
+
+        void write(const char* s, size_t len) {
+            if (len >= capacity) {
+                flushBuffer();
+                fwrite(s, 1, len, fp);
+                return;
+            }
+            reserve(len);
+            memcpy(ptr, s, len);
+            ptr += len;
+        }
+
+        void write(const char* s) {
+            write(s, strlen(s));
+        }
+
+        void write(const std::string& s) {
+            write(s.data(), s.length());
+        }
+
+        void writeLine(const char* s, size_t len) {
+            write(s, len);
+            writeChar('\n');
+        }
+
+        void writeLine(const std::string& s) {
+            writeLine(s.data(), s.length());
+        }
+
+    private:
+        FILE* fp;
+        char* buff;
+        size_t capacity;
+        char* ptr;
+
+        void flushBuffer() {
+            if (ptr > buff) {
+                fwrite(buff, 1, ptr - buff, fp);
+                ptr = buff;
+            }
+        }
+
+        void reserve(size_t n) {
+            if (size_t(buff + capacity - ptr) < n)
+                flushBuffer();
+        }
+
+        void writeDigits(unsigned long long x) {
+            char tmp[24];
+            char* p = tmp + sizeof(tmp);
+            do {
+                *--p = char('0' + x % 10);
+                x /= 10;
+            } while (x);
+
+            size_t len = tmp + sizeof(tmp) - p;
+            memcpy(ptr, p, len);
+            ptr += len;
+        }
+    };
 }
 
 /*
@@ -42,4 +604,26 @@ int main() {
     int b = FastIO::readInt();
     // ...
 }
+
+<Usage - streaming>
+
+int main() {
+    FastIO::Reader in(stdin);           // or FastIO::Reader in("input.txt");
+    FastIO::Writer out(stdout);
+
+    int T = in.readInt();
+    while (T-- > 0) {
+        long long a = in.readInt64();
+        double b = in.readDouble();
+
+        int len;
+        const char* s = in.readToken(len);  // not null-terminated, valid until the next read
+
+        out.writeInt64(a);
+        out.writeChar(' ');
+        out.writeDouble(b, 3);
+        out.writeChar(' ');
+        out.writeLine(s, len);
+    }
+}
 */
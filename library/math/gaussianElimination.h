@@ -19,7 +19,7 @@ struct SLAE {
                 continue;
 
             if (row != best) {
-                swap(a[row], a[best]);
+                a.swapRows(row, best);
                 swap(b[row], b[best]);
             }
 
@@ -7,6 +7,7 @@ using namespace std;
 
 int main(void) {
     TEST(Matrix);
+    TEST(MatrixMultiply);
     TEST(Fibonacci);
     TEST(TernarySearch);
     TEST(GaussianElimination);
@@ -10,10 +10,10 @@ using namespace std;
 template <typename T>
 static Matrix<T> fibonacci(int n) {
     Matrix<T> fm(2);
-    fm.val[0][0] = 1ll;
-    fm.val[0][1] = 1ll;
-    fm.val[1][0] = 1ll;
-    fm.val[1][1] = 0ll;
+    fm[0][0] = 1ll;
+    fm[0][1] = 1ll;
+    fm[1][0] = 1ll;
+    fm[1][1] = 0ll;
     return Matrix<T>::pow(fm, n);
 }
 
@@ -26,9 +26,29 @@ static Matrix<T> fibonacci(int n) {
 #include <iostream>
 #include "../common/iostreamhelper.h"
 #include "../common/profile.h"
+#include "../common/rand.h"
 
 //#define MOD     1000000007
 
+template <typename T>
+static vector<vector<T>> multiplyNaive(const vector<vector<T>>& a, const vector<vector<T>>& b, T mod = 0) {
+    int N = int(a.size());
+    vector<vector<T>> res(N, vector<T>(N));
+    for (int r = 0; r < N; r++) {
+        for (int c = 0; c < N; c++) {
+            T sum = 0;
+            for (int k = 0; k < N; k++) {
+                if (mod)
+                    sum = (sum + a[r][k] * b[k][c]) % mod;
+                else
+                    sum += a[r][k] * b[k][c];
+            }
+            res[r][c] = sum;
+        }
+    }
+    return res;
+}
+
 static long long fibonacciSlow(int n) {
     if (n == 0)
         return 0ll;
@@ -81,3 +101,92 @@ void testMatrix() {
 
     cout << "OK!" << endl;
 }
+
+void testMatrixMultiply() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Matrix : tiled and multi-threaded multiplication ---------------------------------" << endl;
+
+    {
+        const int MOD = 1000000007;
+        for (int N : { 1, 5, 33, 100, 600 }) {
+            vector<vector<long long>> a(N, vector<long long>(N)), b(N, vector<long long>(N));
+            for (int i = 0; i < N; i++) {
+                for (int j = 0; j < N; j++) {
+                    a[i][j] = RandInt32::get() % MOD;
+                    b[i][j] = RandInt32::get() % MOD;
+                }
+            }
+            auto gtMod = multiplyNaive(a, b, (long long)MOD);
+
+            MatrixMod<MOD> x(a), y(b), z(N);
+            for (int threadCount = 1; threadCount <= 4; threadCount += 3) {
+                MatrixMod<MOD>::multiply(z, x, y, threadCount);
+                for (int i = 0; i < N; i++)
+                    for (int j = 0; j < N; j++)
+                        assert(z[i][j] == gtMod[i][j]);
+            }
+
+            for (int i = 0; i < N; i++) {
+                for (int j = 0; j < N; j++) {
+                    a[i][j] %= 1000;
+                    b[i][j] %= 1000;
+                }
+            }
+            auto gt = multiplyNaive(a, b);
+            Matrix<long long> p(a), q(b), r(N);
+            for (int threadCount = 1; threadCount <= 4; threadCount += 3) {
+                Matrix<long long>::multiply(r, p, q, threadCount);
+                for (int i = 0; i < N; i++)
+                    for (int j = 0; j < N; j++)
+                        assert(r[i][j] == gt[i][j]);
+            }
+        }
+
+        // a(n) = a(n-1) + 2 * a(n-3), 5th power by squaring vs step by step
+        MatrixMod<MOD> m(vector<vector<int>>{ { 1, 0, 2 }, { 1, 0, 0 }, { 0, 1, 0 } });
+        MatrixMod<MOD> p = m.pow(5);
+        MatrixMod<MOD> q = m * m * m * m * m;
+        assert(p.val == q.val);
+        assert(m.pow(0)[1][1] == 1 && m.pow(1).val == m.val);
+    }
+    {
+        int N = 512;
+#ifdef _DEBUG
+        N = 128;
+#endif
+        const int MOD = 1000000007;
+        vector<vector<long long>> a(N, vector<long long>(N)), b(N, vector<long long>(N));
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                a[i][j] = RandInt32::get() % MOD;
+                b[i][j] = RandInt32::get() % MOD;
+            }
+        }
+        cout << "*** Speed test (N = " << N << ", mod 1000000007) ***" << endl;
+
+        cout << "  vector<vector<>> with r-c-k loops : ";
+        PROFILE_START(2);
+        auto gt = multiplyNaive(a, b, (long long)MOD);
+        PROFILE_STOP(2);
+
+        MatrixMod<MOD> x(a), y(b), z(N);
+        int threadCount = max(1, int(thread::hardware_concurrency()));
+        for (int t = 1; t <= threadCount; t <<= 1) {
+            cout << "  MatrixMod::multiply(), " << t << " threads : ";
+            PROFILE_START(3);
+            MatrixMod<MOD>::multiply(z, x, y, t);
+            PROFILE_STOP(3);
+        }
+        for (int i = 0; i < N; i++)
+            for (int j = 0; j < N; j++)
+                assert(z[i][j] == gt[i][j]);
+
+        cout << "  MatrixMod::pow(x, 10^6) : ";
+        PROFILE_START(4);
+        z = x.pow(1000000, threadCount);
+        PROFILE_STOP(4);
+    }
+
+    cout << "OK!" << endl;
+}
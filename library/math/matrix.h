@@ -1,45 +1,50 @@
 #pragma once
 
+#include "../common/parallelFor.h"
+
+// Matrix multiplication
+//  - N x N values are stored contiguously in row-major order
+//  - i-k-j order in tiles, so the inner loop reads and writes rows sequentially
+//  - row blocks can be multiplied by several threads (threadCount), each thread owns its output rows
+
 //-----------------------------------------------------------------------------
 
 template <typename T>
 struct Matrix {
-    int N;
-    vector<vector<T>> val;
+    static const int TILE_ROWS = 32;
+    static const int TILE_DEPTH = 128;
+    static const int TILE_COLS = 512;
 
-    Matrix(int _N) : N(_N), val(_N, vector<T>(_N)) {
-    }
+    int N;
+    vector<T> val;
 
-    Matrix(const vector<vector<T>>& rhs) : N(int(rhs.size())), val(rhs) {
+    Matrix(int _N) : N(_N), val(size_t(_N) * _N) {
     }
 
-    Matrix(vector<vector<T>>&& rhs) : N(int(rhs.size())), val(move(rhs)) {
+    Matrix(const vector<vector<T>>& rhs) : N(int(rhs.size())), val(size_t(N) * N) {
+        for (int i = 0; i < N; i++)
+            copy(rhs[i].begin(), rhs[i].begin() + N, val.begin() + size_t(i) * N);
     }
 
     template <typename U>
-    Matrix(const vector<vector<U>>& rhs) : N(int(rhs.size())), val(N, vector<T>(N)) {
+    Matrix(const vector<vector<U>>& rhs) : N(int(rhs.size())), val(size_t(N) * N) {
         for (int i = 0; i < N; i++)
             for (int j = 0; j < N; j++)
-                val[i][j] = (T)rhs[i][j];
+                (*this)[i][j] = (T)rhs[i][j];
     }
 
     template <typename U>
-    Matrix(const Matrix<U>& rhs) : N(rhs.N), val(N, vector<T>(N)) {
-        for (int i = 0; i < N; i++)
-            for (int j = 0; j < N; j++)
-                val[i][j] = (T)rhs.val[i][j];
+    Matrix(const Matrix<U>& rhs) : N(rhs.N), val(size_t(N) * N) {
+        for (size_t i = 0; i < val.size(); i++)
+            val[i] = (T)rhs.val[i];
     }
 
 
     Matrix& operator =(const vector<vector<T>>& rhs) {
-        N = int(rhs.N);
-        val = rhs;
-        return *this;
-    }
-
-    Matrix& operator =(vector<vector<T>>&& rhs) {
         N = int(rhs.size());
-        val = move(rhs);
+        val.resize(size_t(N) * N);
+        for (int i = 0; i < N; i++)
+            copy(rhs[i].begin(), rhs[i].begin() + N, val.begin() + size_t(i) * N);
         return *this;
     }
 
@@ -47,51 +52,53 @@ struct Matrix {
     Matrix& operator =(const vector<vector<U>>& rhs) {
         N = int(rhs.size());
 
-        val.assign(N, vector<T>(N));
+        val.assign(size_t(N) * N, T());
         for (int i = 0; i < N; i++)
             for (int j = 0; j < N; j++)
-                val[i][j] = (T)rhs[i][j];
+                (*this)[i][j] = (T)rhs[i][j];
 
         return *this;
     }
 
     template <typename U>
     Matrix& operator =(const Matrix<U>& rhs) {
-        N = int(rhs.size());
+        N = rhs.N;
 
-        val.assign(N, vector<T>(N));
-        for (int i = 0; i < N; i++)
-            for (int j = 0; j < N; j++)
-                val[i][j] = (T)rhs.val[i][j];
+        val.resize(size_t(N) * N);
+        for (size_t i = 0; i < val.size(); i++)
+            val[i] = (T)rhs.val[i];
 
         return *this;
     }
 
 
     Matrix& init() {
-        for (int i = 0; i < N; i++)
-            fill(val[i].begin(), val[i].end(), 0);
+        fill(val.begin(), val.end(), T(0));
         return *this;
     }
 
     Matrix& identity() {
         for (int i = 0; i < N; i++)
-            val[i][i] = 1;
+            (*this)[i][i] = 1;
         return *this;
     }
 
-    const vector<T>& operator[](int row) const {
-        return val[row];
+    const T* operator[](int row) const {
+        return val.data() + size_t(row) * N;
     }
 
-    vector<T>& operator[](int row) {
-        return val[row];
+    T* operator[](int row) {
+        return val.data() + size_t(row) * N;
+    }
+
+    void swapRows(int r1, int r2) {
+        if (r1 != r2)
+            swap_ranges((*this)[r1], (*this)[r1] + N, (*this)[r2]);
     }
 
     Matrix& operator +=(T x) {
-        for (int i = 0; i < N; i++)
-            for (int j = 0; j < N; j++)
-                val[i][j] += x;
+        for (auto& it : val)
+            it += x;
         return *this;
     }
 
@@ -100,16 +107,14 @@ struct Matrix {
     }
 
     Matrix& operator *=(T x) {
-        for (int i = 0; i < N; i++)
-            for (int j = 0; j < N; j++)
-                val[i][j] *= x;
+        for (auto& it : val)
+            it *= x;
         return *this;
     }
 
     Matrix& operator /=(T x) {
-        for (int i = 0; i < N; i++)
-            for (int j = 0; j < N; j++)
-                val[i][j] /= x;
+        for (auto& it : val)
+            it /= x;
         return *this;
     }
 
@@ -120,16 +125,14 @@ struct Matrix {
     }
 
     Matrix& operator +=(const Matrix& rhs) {
-        for (int i = 0; i < N; i++)
-            for (int j = 0; j < N; j++)
-                val[i][j] += rhs.val[i][j];
+        for (size_t i = 0; i < val.size(); i++)
+            val[i] += rhs.val[i];
         return *this;
     }
 
     Matrix& operator -=(const Matrix& rhs) {
-        for (int i = 0; i < N; i++)
-            for (int j = 0; j < N; j++)
-                val[i][j] -= rhs.val[i][j];
+        for (size_t i = 0; i < val.size(); i++)
+            val[i] -= rhs.val[i];
         return *this;
     }
 
@@ -164,20 +167,20 @@ struct Matrix {
     }
 
     Matrix operator +(const Matrix& rhs) const {
-        Matrix res(N);
+        Matrix res = *this;
         res += rhs;
         return res;
     }
 
     Matrix operator -(const Matrix& rhs) const {
-        Matrix res(N);
+        Matrix res = *this;
         res -= rhs;
         return res;
     }
 
 
-    Matrix pow(T n) const {
-        return Matrix<T>::pow(*this, n);
+    Matrix pow(long long n, int threadCount = 1) const {
+        return Matrix<T>::pow(*this, n, threadCount);
     }
 
     // O(N^3)
@@ -216,16 +219,14 @@ struct Matrix {
     }
 
 
-    static void multiply(Matrix& out, const Matrix& left, const Matrix& right) {
+    // 'out' must not be 'left' or 'right'
+    static void multiply(Matrix& out, const Matrix& left, const Matrix& right, int threadCount = 1) {
         int N = left.N;
-        for (int r = 0; r < N; r++) {
-            for (int c = 0; c < N; c++) {
-                out[r][c] = 0;
-                for (int k = 0; k < N; k++) {
-                    out[r][c] += left[r][k] * right[k][c];
-                }
-            }
-        }
+        out.N = N;
+        out.val.assign(size_t(N) * N, T(0));
+        forEachRowBlock(N, threadCount, [&out, &left, &right](int first, int last) {
+            multiplyRows(out, left, right, first, last);
+        });
     }
 
     static const Matrix& getIdentity(int N) {
@@ -234,7 +235,7 @@ struct Matrix {
         auto it = M.find(N);
         if (it != M.end())
             return *it->second;
-        
+
         auto mat = make_shared<Matrix<T>>(N);
         mat->identity();
         M[N] = mat;
@@ -243,21 +244,201 @@ struct Matrix {
     }
 
     //PRECONDITION: n >= 0
-    static Matrix pow(const Matrix& m, T n) {
+    static Matrix pow(const Matrix& m, long long n, int threadCount = 1) {
         if (n == 1)
             return m;
         else if (n == 0)
             return getIdentity(m.N);
 
-        if (n & 1)
-            return m * pow(m, n - 1);
+        Matrix res(m.N), x = m, t(m.N);
+        for (bool first = true; n > 0; n >>= 1) {
+            if (n & 1) {
+                if (first)
+                    res = x;
+                else {
+                    multiply(t, res, x, threadCount);
+                    swap(res.val, t.val);
+                }
+                first = false;
+            }
+            if (n > 1) {
+                multiply(t, x, x, threadCount);
+                swap(x.val, t.val);
+            }
+        }
+        return res;
+    }
+
+    // calls f(first, last) for row ranges of whole tiles, on 'threadCount' threads
+    template <typename F>
+    static void forEachRowBlock(int N, int threadCount, F f) {
+        int blocks = (N + TILE_ROWS - 1) / TILE_ROWS;
+        parallelFor(blocks, threadCount, [N, &f](int first, int last) {
+            f(first * TILE_ROWS, min(N, last * TILE_ROWS));
+        });
+    }
+
+private:
+    // out[first, last) += left[first, last) * right
+    static void multiplyRows(Matrix& out, const Matrix& left, const Matrix& right, int first, int last) {
+        int N = left.N;
+        for (int jj = 0; jj < N; jj += TILE_COLS) {
+            int jEnd = min(N, jj + TILE_COLS);
+            for (int ii = first; ii < last; ii += TILE_ROWS) {
+                int iEnd = min(last, ii + TILE_ROWS);
+                for (int kk = 0; kk < N; kk += TILE_DEPTH) {
+                    int kEnd = min(N, kk + TILE_DEPTH);
+                    for (int i = ii; i < iEnd; i++) {
+                        T* o = out[i];
+                        const T* l = left[i];
+                        for (int k = kk; k < kEnd; k++) {
+                            T a = l[k];
+                            const T* r = right[k];
+                            for (int j = jj; j < jEnd; j++)
+                                o[j] += a * r[j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+// values are in [0, mod), mod < 2^31
+//  - products are summed in 64 bits and reduced once per batch of rows of 'right'
+//    (MAX_BATCH products can be added before an overflow), instead of once per product
+template <int mod>
+struct MatrixMod {
+    static const int TILE_ROWS = 32;
+    static const int TILE_COLS = 512;
+    static const int MAX_BATCH = int(min(256ull,
+        (~0ull - (unsigned long long)mod) / ((unsigned long long)(mod - 1) * (mod - 1) + 1)));
+
+    int N;
+    vector<int> val;
+
+    MatrixMod(int _N) : N(_N), val(size_t(_N) * _N) {
+    }
+
+    template <typename U>
+    MatrixMod(const vector<vector<U>>& rhs) : N(int(rhs.size())), val(size_t(N) * N) {
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < N; j++) {
+                long long x = (long long)rhs[i][j] % mod;
+                (*this)[i][j] = int(x < 0 ? x + mod : x);
+            }
+        }
+    }
+
+    MatrixMod& init() {
+        fill(val.begin(), val.end(), 0);
+        return *this;
+    }
 
-        auto t = pow(m, n / 2);
-        return t * t;
+    MatrixMod& identity() {
+        for (int i = 0; i < N; i++)
+            (*this)[i][i] = 1 % mod;
+        return *this;
+    }
+
+    const int* operator[](int row) const {
+        return val.data() + size_t(row) * N;
+    }
+
+    int* operator[](int row) {
+        return val.data() + size_t(row) * N;
+    }
+
+    MatrixMod& operator *=(const MatrixMod& rhs) {
+        MatrixMod t = *this;
+        multiply(*this, t, rhs);
+        return *this;
+    }
+
+    MatrixMod operator *(const MatrixMod& rhs) const {
+        MatrixMod res(N);
+        multiply(res, *this, rhs);
+        return res;
+    }
+
+    MatrixMod pow(long long n, int threadCount = 1) const {
+        return MatrixMod::pow(*this, n, threadCount);
+    }
+
+    // 'out' must not be 'left' or 'right'
+    static void multiply(MatrixMod& out, const MatrixMod& left, const MatrixMod& right, int threadCount = 1) {
+        int N = left.N;
+        out.N = N;
+        out.val.resize(size_t(N) * N);
+        Matrix<int>::forEachRowBlock(N, threadCount, [&out, &left, &right](int first, int last) {
+            multiplyRows(out, left, right, first, last);
+        });
+    }
+
+    //PRECONDITION: n >= 0
+    static MatrixMod pow(const MatrixMod& m, long long n, int threadCount = 1) {
+        MatrixMod res(m.N);
+        res.identity();
+
+        MatrixMod x = m, t(m.N);
+        for (bool first = true; n > 0; n >>= 1) {
+            if (n & 1) {
+                if (first)
+                    res = x;
+                else {
+                    multiply(t, res, x, threadCount);
+                    swap(res.val, t.val);
+                }
+                first = false;
+            }
+            if (n > 1) {
+                multiply(t, x, x, threadCount);
+                swap(x.val, t.val);
+            }
+        }
+        return res;
+    }
+
+private:
+    static void multiplyRows(MatrixMod& out, const MatrixMod& left, const MatrixMod& right, int first, int last) {
+        int N = left.N;
+        vector<unsigned long long> acc(size_t(TILE_ROWS) * TILE_COLS);
+        for (int jj = 0; jj < N; jj += TILE_COLS) {
+            int jEnd = min(N, jj + TILE_COLS);
+            int cols = jEnd - jj;
+            for (int ii = first; ii < last; ii += TILE_ROWS) {
+                int iEnd = min(last, ii + TILE_ROWS);
+                fill(acc.begin(), acc.end(), 0ull);
+                for (int kk = 0; kk < N; kk += MAX_BATCH) {
+                    int kEnd = min(N, kk + MAX_BATCH);
+                    for (int i = ii; i < iEnd; i++) {
+                        unsigned long long* o = acc.data() + size_t(i - ii) * TILE_COLS;
+                        const int* l = left[i];
+                        for (int k = kk; k < kEnd; k++) {
+                            unsigned long long a = unsigned(l[k]);
+                            const int* r = right[k] + jj;
+                            for (int j = 0; j < cols; j++)
+                                o[j] += a * unsigned(r[j]);
+                        }
+                        // batched reduction
+                        for (int j = 0; j < cols; j++)
+                            o[j] %= unsigned(mod);
+                    }
+                }
+                for (int i = ii; i < iEnd; i++) {
+                    const unsigned long long* o = acc.data() + size_t(i - ii) * TILE_COLS;
+                    int* dst = out[i] + jj;
+                    for (int j = 0; j < cols; j++)
+                        dst[j] = int(o[j]);
+                }
+            }
+        }
     }
 };
 
 // https://github.com/yosupo06/Algorithm/tree/54cd52339c4bb8be8719ef04dbb4486e355f03fb/src/math
 //TODO: inverse
 //TODO: matrix determinant
-//TODO: QR decomposition
\ No newline at end of file
+//TODO: QR decomposition
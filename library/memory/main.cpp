@@ -8,4 +8,5 @@ using namespace std;
 int main(void) {
     TEST(TypeAllocator);
     TEST(BlockAllocator);
+    TEST(SizeClassAllocator);
 }
@@ -0,0 +1,18 @@
+#pragma once
+
+// Node allocation policies for node-based containers (Treap, SplayTree, BST, AVLTree, RBTree, ...)
+//   create<NodeT>()   : allocates and value-initializes a node
+//   destroy<NodeT>(p) : destroys and frees a node
+
+// default policy : global new / delete
+struct HeapNodeAllocator {
+    template <typename NodeT>
+    static NodeT* create() {
+        return new NodeT();
+    }
+
+    template <typename NodeT>
+    static void destroy(NodeT* node) {
+        delete node;
+    }
+};
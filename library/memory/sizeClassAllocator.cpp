@@ -0,0 +1,162 @@
+#include <vector>
+#include <set>
+#include <algorithm>
+
+using namespace std;
+
+#include "sizeClassAllocator.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+#include "../tree/treap.h"
+#include "../tree/splayTree.h"
+
+template <typename TreeT>
+static long long churnTree(const vector<int>& keys, int rounds) {
+    long long res = 0;
+    TreeT tree;
+    for (int r = 0; r < rounds; r++) {
+        for (auto x : keys)
+            tree.insert(x);
+        res += tree.size();
+        for (auto x : keys)
+            tree.erase(x);
+    }
+    return res;
+}
+
+void testSizeClassAllocator() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Size Class Allocator ----------------------------" << endl;
+    {
+        int N = 10000;
+        vector<pair<unsigned char*, size_t>> v;
+        for (int i = 0; i < N; i++) {
+            size_t size = 1 + RandInt32::get() % 700;
+            auto* p = reinterpret_cast<unsigned char*>(SizeClassAllocator::allocate(size));
+            assert(reinterpret_cast<size_t>(p) % sizeof(void*) == 0);
+            memset(p, i & 0xff, size);
+            v.emplace_back(p, size);
+        }
+        for (int i = 0; i < N; i++) {
+            for (size_t j = 0; j < v[i].second; j++)
+                assert(v[i].first[j] == (i & 0xff));
+            if (i & 1)
+                SizeClassAllocator::deallocate(v[i].first, v[i].second);
+        }
+        for (int i = 1; i < N; i += 2) {
+            v[i].first = reinterpret_cast<unsigned char*>(SizeClassAllocator::allocate(v[i].second));
+            memset(v[i].first, i & 0xff, v[i].second);
+        }
+        for (int i = 0; i < N; i++) {
+            for (size_t j = 0; j < v[i].second; j++)
+                assert(v[i].first[j] == (i & 0xff));
+            SizeClassAllocator::deallocate(v[i].first, v[i].second);
+        }
+        SizeClassAllocator::release();
+        assert(SizeClassAllocator::getReservedSize() == 0);
+    }
+    {
+        // blocks allocated in one thread and freed in other threads
+        int N = 100000;
+        vector<long long*> v(N);
+        for (int i = 0; i < N; i++)
+            v[i] = SizeClassAllocator::construct<long long>(i);
+
+        vector<thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&v, N, t]() {
+                for (int i = t; i < N; i += 4) {
+                    assert(*v[i] == i);
+                    SizeClassAllocator::destroy(v[i]);
+                }
+                for (int i = 0; i < N / 4; i++)
+                    SizeClassAllocator::destroy(SizeClassAllocator::construct<pair<int, int>>(t, i));
+            });
+        }
+        for (auto& it : threads)
+            it.join();
+    }
+    {
+        set<int, less<int>, SizeClassStdAllocator<int>> S;
+        for (int i = 0; i < 1000; i++)
+            S.insert(i);
+        for (int i = 0; i < 1000; i += 2)
+            S.erase(i);
+        assert(S.size() == 500 && *S.begin() == 1);
+    }
+    {
+        int N = 100000;
+        int R = 20;
+#ifdef _DEBUG
+        N = 10000;
+#endif
+        vector<int> keys(N);
+        for (int i = 0; i < N; i++)
+            keys[i] = RandInt32::get();
+
+        cout << "*** Speed test (insert/erase " << N << " keys x " << R << ") ***" << endl;
+        long long r1, r2, r3, r4;
+
+        cout << "  Treap<int, HeapNodeAllocator> : ";
+        PROFILE_START(0);
+        r1 = churnTree<Treap<int, HeapNodeAllocator>>(keys, R);
+        PROFILE_STOP(0);
+
+        cout << "  Treap<int, PoolNodeAllocator> : ";
+        PROFILE_START(1);
+        r2 = churnTree<Treap<int, PoolNodeAllocator>>(keys, R);
+        PROFILE_STOP(1);
+
+        cout << "  SplayTree<int, HeapNodeAllocator> : ";
+        PROFILE_START(2);
+        r3 = churnTree<SplayTree<int, HeapNodeAllocator>>(keys, R);
+        PROFILE_STOP(2);
+
+        cout << "  SplayTree<int, PoolNodeAllocator> : ";
+        PROFILE_START(3);
+        r4 = churnTree<SplayTree<int, PoolNodeAllocator>>(keys, R);
+        PROFILE_STOP(3);
+
+        assert(r1 == r2 && r3 == r4);
+
+        vector<void*> ptrs(N);
+        cout << "  operator new / delete (24 bytes) : ";
+        PROFILE_START(4);
+        for (int r = 0; r < R; r++) {
+            for (int i = 0; i < N; i++)
+                ptrs[i] = ::operator new(24);
+            for (int i = N - 1; i >= 0; i -= 2)
+                ::operator delete(ptrs[i]);
+            for (int i = N - 2; i >= 0; i -= 2)
+                ::operator delete(ptrs[i]);
+        }
+        PROFILE_STOP(4);
+
+        cout << "  SizeClassAllocator (24 bytes) : ";
+        PROFILE_START(5);
+        for (int r = 0; r < R; r++) {
+            for (int i = 0; i < N; i++)
+                ptrs[i] = SizeClassAllocator::allocate(24);
+            for (int i = N - 1; i >= 0; i -= 2)
+                SizeClassAllocator::deallocate(ptrs[i], 24);
+            for (int i = N - 2; i >= 0; i -= 2)
+                SizeClassAllocator::deallocate(ptrs[i], 24);
+        }
+        PROFILE_STOP(5);
+    }
+    SizeClassAllocator::release();
+
+    cout << "OK!" << endl;
+}
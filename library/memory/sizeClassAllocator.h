@@ -0,0 +1,203 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <new>
+
+#include "nodeAllocator.h"
+
+// Size-class allocator with per-thread caches
+//  - requests up to MAX_BLOCK_SIZE bytes are rounded up to a multiple of ALIGN_SIZE, and
+//    each size class is served from a free list of the calling thread without any lock.
+//  - chunks are owned by a global pool, so a block can be freed by any thread.
+//  - release() frees all chunks at once. All blocks become invalid.
+//  - larger requests are forwarded to ::operator new / ::operator delete.
+struct SizeClassAllocator {
+    static const size_t ALIGN_SIZE = 16;
+    static const size_t MAX_BLOCK_SIZE = 512;
+    static const size_t CLASS_COUNT = MAX_BLOCK_SIZE / ALIGN_SIZE;
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    static void* allocate(size_t size) {
+        if (size > MAX_BLOCK_SIZE)
+            return ::operator new(size);
+
+        ThreadCache& cache = threadCache();
+        Pool& pool = globalPool();
+
+        unsigned epoch = pool.epoch.load(std::memory_order_acquire);
+        if (cache.epoch != epoch)
+            cache.reset(epoch);
+
+        size_t cls = sizeClass(size);
+        FreeBlockT* p = cache.freeList[cls];
+        if (p) {
+            cache.freeList[cls] = p->next;
+            return p;
+        }
+
+        size_t blockSize = (cls + 1) * ALIGN_SIZE;
+        if (cache.chunkRemain < blockSize) {
+            cache.chunkPtr = pool.allocateChunk();
+            cache.chunkRemain = CHUNK_SIZE;
+        }
+        void* res = cache.chunkPtr;
+        cache.chunkPtr += blockSize;
+        cache.chunkRemain -= blockSize;
+        return res;
+    }
+
+    // 'size' must be the same value as in allocate()
+    static void deallocate(void* p, size_t size) {
+        if (!p)
+            return;
+        if (size > MAX_BLOCK_SIZE) {
+            ::operator delete(p);
+            return;
+        }
+
+        ThreadCache& cache = threadCache();
+        size_t cls = sizeClass(size);
+        auto* blk = reinterpret_cast<FreeBlockT*>(p);
+        blk->next = cache.freeList[cls];
+        cache.freeList[cls] = blk;
+    }
+
+    template <typename T, typename... Args>
+    static T* construct(Args&&... args) {
+        return ::new (allocate(sizeof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static void destroy(T* obj) {
+        if (obj) {
+            obj->~T();
+            deallocate(obj, sizeof(T));
+        }
+    }
+
+    // frees all chunks of all threads, O(#chunks)
+    // No block allocated before this call may be used or freed after it.
+    static void release() {
+        Pool& pool = globalPool();
+        pool.release();
+        threadCache().reset(pool.epoch.load(std::memory_order_acquire));
+    }
+
+    // total bytes of chunks held by the global pool
+    static size_t getReservedSize() {
+        Pool& pool = globalPool();
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        return pool.chunks.size() * CHUNK_SIZE;
+    }
+
+private:
+    struct FreeBlockT {
+        FreeBlockT* next;
+    };
+
+    struct Pool {
+        std::mutex mutex;
+        std::atomic<unsigned> epoch;
+        std::vector<std::unique_ptr<unsigned char[]>> chunks;
+
+        Pool() : epoch(0) {
+        }
+
+        unsigned char* allocateChunk() {
+            std::unique_ptr<unsigned char[]> chunk(new unsigned char[CHUNK_SIZE]);
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.push_back(std::move(chunk));
+            return chunks.back().get();
+        }
+
+        void release() {
+            std::vector<std::unique_ptr<unsigned char[]>> tmp;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tmp.swap(chunks);
+                epoch.fetch_add(1, std::memory_order_acq_rel);
+            }
+        }
+    };
+
+    struct ThreadCache {
+        unsigned        epoch;
+        FreeBlockT*     freeList[CLASS_COUNT];
+        unsigned char*  chunkPtr;
+        size_t          chunkRemain;
+
+        ThreadCache() {
+            reset(0);
+        }
+
+        void reset(unsigned newEpoch) {
+            epoch = newEpoch;
+            for (size_t i = 0; i < CLASS_COUNT; i++)
+                freeList[i] = nullptr;
+            chunkPtr = nullptr;
+            chunkRemain = 0;
+        }
+    };
+
+    static size_t sizeClass(size_t size) {
+        return size ? (size - 1) / ALIGN_SIZE : 0;
+    }
+
+    static Pool& globalPool() {
+        static Pool pool;
+        return pool;
+    }
+
+    static ThreadCache& threadCache() {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+};
+
+// node allocation policy for node-based containers
+// ex) Treap<int, PoolNodeAllocator>, SplayTree<int, PoolNodeAllocator>
+struct PoolNodeAllocator {
+    template <typename NodeT>
+    static NodeT* create() {
+        return SizeClassAllocator::construct<NodeT>();
+    }
+
+    template <typename NodeT>
+    static void destroy(NodeT* node) {
+        SizeClassAllocator::destroy(node);
+    }
+};
+
+// STL-compatible allocator, ex) set<int, less<int>, SizeClassStdAllocator<int>>
+template <typename T>
+struct SizeClassStdAllocator {
+    typedef T value_type;
+
+    SizeClassStdAllocator() {
+    }
+
+    template <typename U>
+    SizeClassStdAllocator(const SizeClassStdAllocator<U>&) {
+    }
+
+    T* allocate(size_t n) {
+        return reinterpret_cast<T*>(SizeClassAllocator::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n) {
+        SizeClassAllocator::deallocate(p, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator ==(const SizeClassStdAllocator<U>&) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator !=(const SizeClassStdAllocator<U>&) const {
+        return false;
+    }
+};
@@ -1,4 +1,5 @@
 #include <vector>
+#include <thread>
 #include <algorithm>
 
 using namespace std;
@@ -65,6 +66,37 @@ void testConvolution() {
     cout << v2 << endl;
     assert(v == v2);
 
+    {
+        // concurrent calls
+        int T = 4;
+        vector<vector<int>> A(T), B(T), gt(T), gtMod(T), out(T), outMod(T);
+        for (int t = 0; t < T; t++) {
+            int n = 1000 + 500 * t;
+            A[t].resize(n);
+            B[t].resize(n);
+            for (int i = 0; i < n; i++) {
+                A[t][i] = RandInt32::get() % 1024;
+                B[t][i] = RandInt32::get() % 1024;
+            }
+            gt[t] = Convolution::multiplyFFT(A[t], B[t]);
+            gtMod[t] = Convolution::multiplyFFTMod(A[t], B[t], MOD);
+        }
+
+        vector<thread> threads;
+        for (int t = 0; t < T; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < 20; i++) {
+                    out[t] = Convolution::multiplyFFT(A[t], B[t]);
+                    outMod[t] = Convolution::multiplyFFTMod(A[t], B[t], MOD);
+                }
+            });
+        }
+        for (auto& th : threads)
+            th.join();
+        for (int t = 0; t < T; t++)
+            assert(out[t] == gt[t] && outMod[t] == gtMod[t]);
+    }
+
     cout << "*** Speed test ***" << endl;
     for (int n = 32; n <= 2048; n <<= 1) {
         vector<int> in1(n);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fft.h"
+#include "fftPlan.h"
 
 #ifndef SCALE
 #define SCALE   32768
@@ -37,41 +38,15 @@ struct Convolution {
 
     // It's better performance than convolution() when N >= 128
     static vector<int> multiplyFFT(const vector<int>& x, const vector<int>& h, bool reverseH = true) {
-        int sizeL = int(x.size());
-        int sizeR = int(h.size());
-        int sizeDst = sizeL + sizeR - 1;
-
-        int size = 1;
-        while (size < sizeDst)
-            size <<= 1;
-
-        vector<pair<double,double>> A(size);
-        vector<pair<double,double>> B(size);
-        for (int i = 0; i < sizeL; i++)
-            A[i].first = x[i];
-        if (reverseH) {
-            for (int i = 0; i < sizeR; i++)
-                B[i].first = h[i];
-        } else {
-            for (int i = 0, j = sizeR - 1; j >= 0; i++, j--)
-                B[i].first = h[j];
-        }
-
-        FFT::fft(A);
-        FFT::fft(B);
-
-        vector<pair<double,double>> C(size);
-        for (int i = 0; i < size; i++) {
-            //C[i] = A[i] * B[i];
-            C[i].first = A[i].first * B[i].first - A[i].second * B[i].second;
-            C[i].second = A[i].first * B[i].second + A[i].second * B[i].first;
-        }
+        vector<long long> C;
+        if (reverseH)
+            getPlan().multiplyInt(x, h, C);
+        else
+            getPlan().multiplyInt(x, vector<int>(h.rbegin(), h.rend()), C);
 
-        FFT::fft(C, true);
-
-        vector<int> res(sizeDst);
-        for (int i = 0; i < sizeDst; i++)
-            res[i] = int(C[i].first + 0.5);
+        vector<int> res(C.size());
+        for (int i = 0; i < int(C.size()); i++)
+            res[i] = int(C[i]);
 
         return res;
     }
@@ -108,67 +83,18 @@ struct Convolution {
 
     // It's better performance than multPoly() when N >= 64
     static vector<int> multiplyFFTMod(const vector<int>& x, const vector<int>& h, int MOD, bool reverseH = true) {
-        int sizeL = int(x.size());
-        int sizeR = int(h.size());
-        int sizeDst = sizeL + sizeR - 1;
-
-        int size = 1;
-        while (size < sizeDst)
-            size <<= 1;
-
-        vector<pair<double,double>> A1(size), A2(size);
-        vector<pair<double,double>> B1(size), B2(size);
-        for (int i = 0; i < sizeL; i++) {
-            A1[i].first = x[i] / SCALE;
-            A2[i].first = x[i] % SCALE;
-        }
-        if (reverseH) {
-            for (int i = 0; i < sizeR; i++) {
-                B1[i].first = h[i] / SCALE;
-                B2[i].first = h[i] % SCALE;
-            }
-        } else {
-            for (int i = 0, j = sizeR - 1; j >= 0; i++, j--) {
-                B1[i].first = h[j] / SCALE;
-                B2[i].first = h[j] % SCALE;
-            }
-        }
-
-        FFT::fft(A1); FFT::fft(A2);
-        FFT::fft(B1); FFT::fft(B2);
-
-        vector<int> res(sizeDst);
-        vector<pair<double,double>> C(size);
-
-        for (int i = 0; i < size; i++) {
-            //C[i] = A1[i] * B1[i];
-            C[i].first = A1[i].first * B1[i].first - A1[i].second * B1[i].second;
-            C[i].second = A1[i].first * B1[i].second + A1[i].second * B1[i].first;
-        }
-        FFT::fft(C, true);
-        for (int i = 0; i < sizeDst; i++)
-            res[i] = ((long long)fmod(C[i].first + 0.5, MOD) * SCALE * SCALE) % MOD;
-
-        for (int i = 0; i < size; i++) {
-            //C[i] = A1[i] * B2[i] + A2[i] * B1[i];
-            C[i].first = A1[i].first * B2[i].first - A1[i].second * B2[i].second
-                       + A2[i].first * B1[i].first - A2[i].second * B1[i].second;
-            C[i].second = A1[i].first * B2[i].second + A1[i].second * B2[i].first
-                        + A2[i].first * B1[i].second + A2[i].second * B1[i].first;
-        }
-        FFT::fft(C, true);
-        for (int i = 0; i < sizeDst; i++)
-            res[i] = (res[i] + (long long)fmod(C[i].first + 0.5, MOD) * SCALE) % MOD;
-
-        for (int i = 0; i < size; i++) {
-            //C[i] = A2[i] * B2[i];
-            C[i].first = A2[i].first * B2[i].first - A2[i].second * B2[i].second;
-            C[i].second = A2[i].first * B2[i].second + A2[i].second * B2[i].first;
-        }
-        FFT::fft(C, true);
-        for (int i = 0; i < sizeDst; i++)
-            res[i] = (res[i] + (long long)fmod(C[i].first + 0.5, MOD)) % MOD;
-
+        vector<int> res;
+        if (reverseH)
+            getPlan().multiplyMod(x, h, MOD, res);
+        else
+            getPlan().multiplyMod(x, vector<int>(h.rbegin(), h.rend()), MOD, res);
         return res;
     }
+
+private:
+    // roots and buffers are shared by the calls in a thread, so calls from different threads don't race
+    static FFTPlan& getPlan() {
+        static thread_local FFTPlan plan;
+        return plan;
+    }
 };
@@ -0,0 +1,152 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+#include "fftPlan.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+#include "fft.h"
+#include "convolution.h"
+
+// the previous implementation of Convolution::multiplyFFT()
+static vector<long long> multiplyFFTLegacy(const vector<int>& x, const vector<int>& h) {
+    int sizeDst = int(x.size() + h.size()) - 1;
+
+    int size = 1;
+    while (size < sizeDst)
+        size <<= 1;
+
+    vector<pair<double, double>> A(size), B(size), C(size);
+    for (int i = 0; i < int(x.size()); i++)
+        A[i].first = x[i];
+    for (int i = 0; i < int(h.size()); i++)
+        B[i].first = h[i];
+
+    FFT::fft(A);
+    FFT::fft(B);
+    for (int i = 0; i < size; i++) {
+        C[i].first = A[i].first * B[i].first - A[i].second * B[i].second;
+        C[i].second = A[i].first * B[i].second + A[i].second * B[i].first;
+    }
+    FFT::fft(C, true);
+
+    vector<long long> res(sizeDst);
+    for (int i = 0; i < sizeDst; i++)
+        res[i] = llround(C[i].first);
+
+    return res;
+}
+
+static vector<long long> multiplySlow(const vector<int>& x, const vector<int>& h, int MOD = 0) {
+    vector<long long> res(x.size() + h.size() - 1);
+    for (int i = 0; i < int(x.size()); i++) {
+        for (int j = 0; j < int(h.size()); j++) {
+            if (MOD)
+                res[i + j] = (res[i + j] + 1ll * x[i] * h[j]) % MOD;
+            else
+                res[i + j] += 1ll * x[i] * h[j];
+        }
+    }
+    return res;
+}
+
+void testFFTPlan() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- FFT Plan ------------------------------" << endl;
+    {
+        FFTPlan plan;
+        for (int n = 1; n <= 1024; n <<= 1) {
+            vector<pair<double, double>> in(n), out(n);
+            for (int i = 0; i < n; i++)
+                in[i] = make_pair(double(RandInt32::get() % 1000), double(RandInt32::get() % 1000));
+
+            FFT::fft(in, out);
+            vector<pair<double, double>> a = in;
+            plan.transform(a);
+            for (int i = 0; i < n; i++)
+                assert(fabs(a[i].first - out[i].first) < 1e-6 && fabs(a[i].second - out[i].second) < 1e-6);
+
+            plan.transform(a, true);
+            for (int i = 0; i < n; i++)
+                assert(fabs(a[i].first - in[i].first) < 1e-9 && fabs(a[i].second - in[i].second) < 1e-9);
+        }
+    }
+    {
+        FFTPlan plan;
+        vector<long long> out;
+        vector<int> outMod;
+        for (int t = 0; t < 100; t++) {
+            int xN = 1 + RandInt32::get() % 300;
+            int hN = 1 + RandInt32::get() % 300;
+            vector<int> x(xN), h(hN);
+            for (int i = 0; i < xN; i++)
+                x[i] = int(RandInt32::get() % 2001) - 1000;
+            for (int i = 0; i < hN; i++)
+                h[i] = int(RandInt32::get() % 2001) - 1000;
+
+            plan.multiplyInt(x, h, out);
+            assert(out == multiplySlow(x, h));
+
+            const int MOD = 1000000007;
+            for (int i = 0; i < xN; i++)
+                x[i] = RandInt32::get() % MOD;
+            for (int i = 0; i < hN; i++)
+                h[i] = RandInt32::get() % MOD;
+
+            plan.multiplyMod(x, h, MOD, outMod);
+            vector<long long> gt = multiplySlow(x, h, MOD);
+            assert(outMod.size() == gt.size());
+            for (int i = 0; i < int(gt.size()); i++)
+                assert(outMod[i] == gt[i]);
+            assert(Convolution::multiplyFFTMod(x, h, MOD) == outMod);
+        }
+    }
+    {
+        cout << "*** Speed test ***" << endl;
+
+        int T = 1000;
+#ifdef _DEBUG
+        T = 10;
+#endif
+        FFTPlan plan;
+        for (int n = 256; n <= 65536; n <<= 2) {
+            vector<int> x(n), h(n);
+            for (int i = 0; i < n; i++) {
+                x[i] = RandInt32::get() % 1024;
+                h[i] = RandInt32::get() % 1024;
+            }
+            int repeat = max(1, T * 256 / n);
+
+            vector<long long> out1, out2;
+            cout << "N = " << n << ", " << repeat << " times" << endl;
+
+            cout << "  FFT::fft() : ";
+            PROFILE_START(0);
+            for (int i = 0; i < repeat; i++)
+                out1 = multiplyFFTLegacy(x, h);
+            PROFILE_STOP(0);
+
+            cout << "  FFTPlan::multiplyInt() : ";
+            PROFILE_START(1);
+            for (int i = 0; i < repeat; i++)
+                plan.multiplyInt(x, h, out2);
+            PROFILE_STOP(1);
+
+            assert(out1 == out2);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cmath>
+
+// FFT plan
+//  - roots of unity and the bit-reversal table are computed once per size (no cos/sin per call)
+//  - transforms run in place, and the buffers of multiply() are reused across calls
+//  - two real sequences are packed into one complex transform, so a real convolution needs
+//    2 transforms instead of 3 (FFT::fft), and a modular convolution needs 4 instead of 7
+//  - an instance is not thread-safe
+struct FFTPlan {
+    typedef pair<double, double> ComplexT;
+
+    FFTPlan() : size(0), logSize(0) {
+    }
+
+    explicit FFTPlan(int maxSize) : size(0), logSize(0) {
+        prepare(maxSize);
+    }
+
+    // builds tables for transforms of up to 'n' points, O(n) only when the plan grows
+    void prepare(int n) {
+        if (n <= size)
+            return;
+
+        int newSize = 2, newLog = 1;
+        while (newSize < n) {
+            newSize <<= 1;
+            newLog++;
+        }
+
+        // roots[m + j] = e^(i * PI * j / m), 0 <= j < m
+        roots.resize(newSize);
+        roots[1] = ComplexT(1.0, 0.0);
+        for (int m = 2; m < newSize; m <<= 1) {
+            for (int j = 0; j < m; j++) {
+                if (j & 1) {
+                    long double angle = 3.14159265358979323846264338327950288L * j / m;
+                    roots[m + j] = ComplexT(double(cosl(angle)), double(sinl(angle)));
+                } else {
+                    roots[m + j] = roots[(m >> 1) + (j >> 1)];
+                }
+            }
+        }
+
+        rev.resize(newSize);
+        rev[0] = 0;
+        for (int i = 1; i < newSize; i++)
+            rev[i] = (rev[i >> 1] >> 1) | ((i & 1) << (newLog - 1));
+
+        size = newSize;
+        logSize = newLog;
+    }
+
+    // in-place transform, n is a power of 2
+    // forward : X[k] = SUM x[t] * e^(-2*PI*i*k*t/n), inverse : scaled by 1/n (same as FFT::fft())
+    void transform(ComplexT* a, int n, bool inverse = false) {
+        prepare(n);
+        fftCore(a, n, inverse ? 1.0 : -1.0);
+        if (inverse) {
+            double inv = 1.0 / n;
+            for (int i = 0; i < n; i++) {
+                a[i].first *= inv;
+                a[i].second *= inv;
+            }
+        }
+    }
+
+    void transform(vector<ComplexT>& a, bool inverse = false) {
+        transform(a.data(), int(a.size()), inverse);
+    }
+
+    //--- real convolution
+
+    // res = x * h
+    template <typename T>
+    void multiply(const vector<T>& x, const vector<T>& h, vector<double>& res) {
+        if (x.empty() || h.empty()) {
+            res.clear();
+            return;
+        }
+
+        int resN = int(x.size()) + int(h.size()) - 1;
+        int n = ceilPow2(resN);
+        prepare(n);
+        reserveBuffers(n, 2);
+
+        // pack two real sequences : x + i * h
+        ComplexT* in = bufA.data();
+        ComplexT* out = bufB.data();
+        for (int i = 0; i < n; i++) {
+            in[i].first = i < int(x.size()) ? double(x[i]) : 0.0;
+            in[i].second = i < int(h.size()) ? double(h[i]) : 0.0;
+        }
+        fftCore(in, n, 1.0);
+
+        // (X + iH)^2 = X^2 - H^2 + 2iXH, and X*H is extracted with the conjugate-symmetry
+        for (int i = 0; i < n; i++) {
+            double re = in[i].first, im = in[i].second;
+            in[i].first = re * re - im * im;
+            in[i].second = 2.0 * re * im;
+        }
+        for (int i = 0; i < n; i++) {
+            int j = (n - i) & (n - 1);
+            out[i].first = in[j].first - in[i].first;
+            out[i].second = in[j].second + in[i].second;
+        }
+        fftCore(out, n, 1.0);
+
+        res.resize(resN);
+        double scale = 1.0 / (4.0 * n);
+        for (int i = 0; i < resN; i++)
+            res[i] = out[i].second * scale;
+    }
+
+    // res = x * h, rounded to integers
+    template <typename T>
+    void multiplyInt(const vector<T>& x, const vector<T>& h, vector<long long>& res) {
+        vector<double>& tmp = resBuffer;
+        multiply(x, h, tmp);
+        res.resize(tmp.size());
+        for (int i = 0; i < int(tmp.size()); i++)
+            res[i] = llround(tmp[i]);
+    }
+
+    //--- modular convolution
+
+    // res = x * h (mod MOD), 0 <= x[i], h[i] < MOD <= 2^31 - 1, accurate up to about 2^20 points
+    void multiplyMod(const vector<int>& x, const vector<int>& h, int MOD, vector<int>& res) {
+        if (x.empty() || h.empty()) {
+            res.clear();
+            return;
+        }
+
+        int resN = int(x.size()) + int(h.size()) - 1;
+        int n = ceilPow2(resN);
+        prepare(n);
+        reserveBuffers(n, 4);
+
+        int cut = int(sqrt(double(MOD)));
+        if (1ll * cut * cut < MOD)
+            cut++;
+
+        ComplexT* L = bufA.data();
+        ComplexT* R = bufB.data();
+        ComplexT* outL = bufC.data();
+        ComplexT* outS = bufD.data();
+        for (int i = 0; i < n; i++) {
+            if (i < int(x.size()))
+                L[i] = ComplexT(double(x[i] / cut), double(x[i] % cut));
+            else
+                L[i] = ComplexT(0.0, 0.0);
+            if (i < int(h.size()))
+                R[i] = ComplexT(double(h[i] / cut), double(h[i] % cut));
+            else
+                R[i] = ComplexT(0.0, 0.0);
+        }
+        fftCore(L, n, 1.0);
+        fftCore(R, n, 1.0);
+
+        double scale = 1.0 / (2.0 * n);
+        for (int i = 0; i < n; i++) {
+            int j = (n - i) & (n - 1);
+            // p = (L[i] + conj(L[j])) / 2n, q = (L[i] - conj(L[j])) / 2n / i
+            double pRe = (L[i].first + L[j].first) * scale;
+            double pIm = (L[i].second - L[j].second) * scale;
+            double qRe = (L[i].second + L[j].second) * scale;
+            double qIm = -(L[i].first - L[j].first) * scale;
+            outL[j] = ComplexT(pRe * R[i].first - pIm * R[i].second, pRe * R[i].second + pIm * R[i].first);
+            outS[j] = ComplexT(qRe * R[i].first - qIm * R[i].second, qRe * R[i].second + qIm * R[i].first);
+        }
+        fftCore(outL, n, 1.0);
+        fftCore(outS, n, 1.0);
+
+        res.resize(resN);
+        for (int i = 0; i < resN; i++) {
+            long long av = llround(outL[i].first) % MOD;
+            long long bv = (llround(outL[i].second) + llround(outS[i].first)) % MOD;
+            long long cv = llround(outS[i].second) % MOD;
+            res[i] = int(((av * cut + bv) % MOD * cut + cv) % MOD);
+        }
+    }
+
+private:
+    int size;
+    int logSize;
+    vector<ComplexT> roots;
+    vector<int> rev;
+
+    vector<ComplexT> bufA, bufB, bufC, bufD;
+    vector<double> resBuffer;
+
+    static int ceilPow2(int n) {
+        int res = 1;
+        while (res < n)
+            res <<= 1;
+        return res;
+    }
+
+    void reserveBuffers(int n, int count) {
+        if (int(bufA.size()) < n)
+            bufA.resize(n);
+        if (int(bufB.size()) < n)
+            bufB.resize(n);
+        if (count > 2) {
+            if (int(bufC.size()) < n)
+                bufC.resize(n);
+            if (int(bufD.size()) < n)
+                bufD.resize(n);
+        }
+    }
+
+    // unscaled transform with e^(sign * 2*PI*i*k*t/n)
+    void fftCore(ComplexT* a, int n, double sign) {
+        int shift = logSize;
+        for (int m = n; m > 1; m >>= 1)
+            shift--;
+        for (int i = 0; i < n; i++) {
+            int j = rev[i] >> shift;
+            if (i < j)
+                swap(a[i], a[j]);
+        }
+
+        for (int m = 1; m < n; m <<= 1) {
+            const ComplexT* w = roots.data() + m;
+            for (int i = 0; i < n; i += 2 * m) {
+                ComplexT* p = a + i;
+                ComplexT* q = a + i + m;
+                for (int j = 0; j < m; j++) {
+                    double wRe = w[j].first, wIm = sign * w[j].second;
+                    double tRe = q[j].first * wRe - q[j].second * wIm;
+                    double tIm = q[j].first * wIm + q[j].second * wRe;
+                    q[j].first = p[j].first - tRe;
+                    q[j].second = p[j].second - tIm;
+                    p[j].first += tRe;
+                    p[j].second += tIm;
+                }
+            }
+        }
+    }
+};
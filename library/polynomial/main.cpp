@@ -7,10 +7,12 @@ using namespace std;
 
 int main(void) {
     TEST(FFT);
+    TEST(FFTPlan);
     TEST(Polynomial);
     TEST(PolynomialMod);
     TEST(Convolution);
     TEST(NTT);
+    TEST(NTTMontgomery);
     TEST(FactorialMod);
     TEST(RootFindingLaguerre);
 }
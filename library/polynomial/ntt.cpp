@@ -112,6 +112,165 @@ void testNTT() {
             assert(out1 == out2);
         }
     }
+    {
+        // full-range inputs, larger than the NTT primes
+        static const int M = 1000000007;
+        NTT ntt(MOD, 3);
+        for (int i = 0; i < 100; i++) {
+            vector<int> A(RandInt32::get() % 1200 + 1);
+            vector<int> B(RandInt32::get() % 1200 + 1);
+
+            for (int i = 0; i < int(A.size()); i++)
+                A[i] = RandInt32::get() % M;
+            for (int i = 0; i < int(B.size()); i++)
+                B[i] = RandInt32::get() % M;
+
+            vector<int> gt = PolyFFTMod::multiplySlow(A, B, M);
+            assert(PolyNTT::multiply(A, B, M) == gt);
+            assert(PolyNTT::multiplyFast(A, B, M) == gt);
+
+            for (int i = 0; i < int(A.size()); i++)
+                A[i] = RandInt32::get();
+            for (int i = 0; i < int(B.size()); i++)
+                B[i] = RandInt32::get();
+            assert(ntt.multiply(A, B) == PolyFFTMod::multiplySlow(A, B, MOD));
+        }
+    }
+    {
+        // multiply(a, b, true) is a cyclic convolution with b reversed into the end of the padded buffer
+        NTT ntt(MOD, 3);
+        for (int i = 0; i < 100; i++) {
+            vector<int> A(RandInt32::get() % 300 + 1);
+            vector<int> B(RandInt32::get() % 300 + 1);
+
+            for (int i = 0; i < int(A.size()); i++)
+                A[i] = RandInt32::get() % MOD;
+            for (int i = 0; i < int(B.size()); i++)
+                B[i] = RandInt32::get() % MOD;
+
+            int n = int(A.size() + B.size()) - 1;
+            int size = 1;
+            while (size < n)
+                size <<= 1;
+
+            vector<int> X(size), Y(size), gt(size);
+            copy(A.begin(), A.end(), X.begin());
+            copy(B.begin(), B.end(), Y.rbegin());
+            ntt.ntt(X);
+            ntt.ntt(Y);
+            for (int i = 0; i < size; i++)
+                gt[i] = int(1ll * X[i] * Y[i] % MOD);
+            ntt.ntt(gt, true);
+            gt.resize(n);
+
+            assert(ntt.multiply(A, B, true) == gt);
+            assert(ntt.convolute(A, B) == gt);
+        }
+    }
+    {
+        static const int M = 1000000007;
+        int TESTN = 10000;
+        for (int i = 0; i < 5; i++) {
+            vector<int> A(TESTN + RandInt32::get() % 100);
+            vector<int> B(TESTN + RandInt32::get() % 100);
+
+            for (int i = 0; i < int(A.size()); i++)
+                A[i] = RandInt32::get() % M;
+            for (int i = 0; i < int(B.size()); i++)
+                B[i] = RandInt32::get() % M;
+
+            vector<int> out1 = PolyFFTMod::multiply(A, B, M);
+            for (int threadCount = 1; threadCount <= 8; threadCount <<= 1) {
+                vector<int> out2 = PolyNTT::multiplyParallel(A, B, M, threadCount);
+                assert(out1 == out2);
+            }
+        }
+        for (int i = 0; i < 50; i++) {
+            vector<int> A(RandInt32::get() % 1200 + 1);
+            vector<int> B(RandInt32::get() % 1200 + 1);
+
+            for (int i = 0; i < int(A.size()); i++)
+                A[i] = RandInt32::get() % M;
+            for (int i = 0; i < int(B.size()); i++)
+                B[i] = RandInt32::get() % M;
+
+            vector<int> gt = PolyFFTMod::multiplySlow(A, B, M);
+            assert(PolyNTT::multiplyParallel(A, B, M, 1 + i % 3) == gt);
+        }
+    }
+    {
+        // products longer than the transform size, split into blocks
+        NTTMontgomery ntt(MOD, 3);
+        for (int i = 0; i < 50; i++) {
+            vector<int> A(RandInt32::get() % 300 + 1);
+            vector<int> B(RandInt32::get() % 300 + 1);
+
+            for (int i = 0; i < int(A.size()); i++)
+                A[i] = RandInt32::get() % MOD;
+            for (int i = 0; i < int(B.size()); i++)
+                B[i] = RandInt32::get() % MOD;
+
+            vector<int> out;
+            PolyNTT::multiplyBlocks(ntt, A, B, out, 2 << (i % 8));
+            assert(out == PolyFFTMod::multiplySlow(A, B, MOD));
+        }
+    }
+    {
+        // a product of about 1.8 * 10^7 coefficients, 2^25 transforms
+        static const int M = 1000000007;
+        int N = 9000000;
+#ifdef _DEBUG
+        N = 100000;
+#endif
+        vector<int> A(N), B(N);
+        for (int i = 0; i < N; i++) {
+            A[i] = RandInt32::get() % M;
+            B[i] = RandInt32::get() % M;
+        }
+        vector<int> C = PolyNTT::multiplyParallel(A, B, M, 3);
+        assert(int(C.size()) == 2 * N - 1);
+
+        // C(r) = A(r) * B(r) at random points
+        auto evaluate = [](const vector<int>& P, long long r) {
+            long long res = 0;
+            for (int i = int(P.size()) - 1; i >= 0; i--)
+                res = (res * r + P[i]) % M;
+            return res;
+        };
+        for (int i = 0; i < 3; i++) {
+            long long r = RandInt32::get() % M;
+            assert(evaluate(C, r) == evaluate(A, r) * evaluate(B, r) % M);
+        }
+    }
+    {
+        static const int M = 1000000007;
+        int N = 1000000;
+#ifdef _DEBUG
+        N = 10000;
+#endif
+        cout << "*** PolyNTT::multiplyParallel() scaling, N = " << N << " (hardware threads = "
+             << thread::hardware_concurrency() << ") ***" << endl;
+
+        vector<int> in1(N), in2(N);
+        for (int i = 0; i < N; i++) {
+            in1[i] = RandInt32::get() % M;
+            in2[i] = RandInt32::get() % M;
+        }
+
+        vector<int> out1, out2;
+        cout << "  PolyNTT::multiplyFast() : ";
+        PROFILE_HI_START(0);
+        out1 = PolyNTT::multiplyFast(in1, in2, M);
+        PROFILE_HI_STOP(0);
+
+        for (int threadCount = 1; threadCount <= 8; threadCount <<= 1) {
+            cout << "  PolyNTT::multiplyParallel(" << threadCount << " threads) : ";
+            PROFILE_HI_START(1);
+            out2 = PolyNTT::multiplyParallel(in1, in2, M, threadCount);
+            PROFILE_HI_STOP(1);
+            assert(out1 == out2);
+        }
+    }
     {
         //static const int M = 1000000007;
         static const int M = MOD;
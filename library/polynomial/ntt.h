@@ -1,5 +1,7 @@
 #pragma once
 
+#include "nttMontgomery.h"
+
 // Number Theoretic Transforms
 // M = 998244353 (119 * 2^23 + 1), primitive root = 3
 //
@@ -7,10 +9,15 @@
 // It's not working for below 'M's. Use PolyNTT for these
 //    - 10^9 + 7
 //    - 10^9 + 9
+//
+// multiply() uses NTTMontgomery (radix-4, AVX2 if available) when M < 2^30.
+//  - multiply(a, b, true) keeps the original result, a cyclic convolution with b reversed into the end
+//    of the zero-padded buffer
+//  - an instance owns scratch buffers, so it must not be shared by threads (PolyNTT uses static instances)
 struct NTT {
     int M, root;
 
-    NTT(int mod, int root) {
+    NTT(int mod, int root) : engine(mod, root) {
         this->M = mod;
         this->root = root;
     }
@@ -53,6 +60,15 @@ struct NTT {
     }
 
     vector<int> multiply(const vector<int>& a, const vector<int>& b, bool reverseB = false) {
+        if (M < (1 << 30)) {
+            vector<int> C;
+            if (!reverseB)
+                engine.multiply(a, b, C);
+            else
+                engine.multiplyReversedPadded(a, b, C);
+            return C;
+        }
+
         int n = int(a.size()) + int(b.size()) - 1;
 
         int size = 1;
@@ -85,6 +101,8 @@ struct NTT {
     }
 
 private:
+    NTTMontgomery engine;
+
     int modPow(int x, int n) {
         if (n == 0)
             return 1;
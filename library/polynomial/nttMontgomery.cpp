@@ -0,0 +1,148 @@
+#include <cassert>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+#include "ntt.h"
+#include "nttMontgomery.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+// NTT::multiply() without NTTMontgomery
+static vector<int> multiplyLegacy(NTT& ntt, const vector<int>& a, const vector<int>& b) {
+    int n = int(a.size()) + int(b.size()) - 1;
+
+    int size = 1;
+    while (size < n)
+        size <<= 1;
+
+    vector<int> A(size);
+    vector<int> B(size);
+    copy(a.begin(), a.end(), A.begin());
+    copy(b.begin(), b.end(), B.begin());
+
+    ntt.ntt(A);
+    ntt.ntt(B);
+    for (int i = 0; i < size; i++)
+        A[i] = int(1ll * A[i] * B[i] % ntt.M);
+    ntt.ntt(A, true);
+
+    A.resize(n);
+    return A;
+}
+
+void testNTTMontgomery() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- NTT with Montgomery multiplication ------------------------" << endl;
+    {
+        static const int MODS[][2] = { { 998244353, 3 }, { 469762049, 3 }, { 167772161, 3 } };
+        for (auto& mr : MODS) {
+            NTT ntt(mr[0], mr[1]);
+            NTTMontgomery nttMont(mr[0], mr[1]);
+            for (int i = 0; i < 50; i++) {
+                int N1 = 1 + RandInt32::get() % 3000;
+                int N2 = 1 + RandInt32::get() % 3000;
+                vector<int> A(N1), B(N2);
+                for (int j = 0; j < N1; j++)
+                    A[j] = RandInt32::get() % mr[0];
+                for (int j = 0; j < N2; j++)
+                    B[j] = RandInt32::get() % mr[0];
+                if (i == 0) {
+                    fill(A.begin(), A.end(), mr[0] - 1);
+                    fill(B.begin(), B.end(), mr[0] - 1);
+                }
+
+                vector<int> out1 = multiplyLegacy(ntt, A, B);
+                vector<int> out2 = nttMont.multiply(A, B);
+                if (out1 != out2) {
+                    cout << "Mismatched : " << endl;
+                    cout << out1 << endl;
+                    cout << out2 << endl;
+                }
+                assert(out1 == out2);
+
+                out1 = multiplyLegacy(ntt, A, A);
+                nttMont.multiply(A, A, out2);
+                assert(out1 == out2);
+
+                nttMont.useAVX2 = !nttMont.useAVX2;
+                assert(nttMont.multiply(A, B) == multiplyLegacy(ntt, A, B));
+                nttMont.useAVX2 = !nttMont.useAVX2;
+            }
+        }
+    }
+    if (NTTMontgomery::hasAVX2()) {
+        // AVX2 kernels must be bit-identical to the scalar kernels, including lazy [0, 2M) values
+        static const int M = 998244353;
+        NTTMontgomery nttScalar(M, 3);
+        NTTMontgomery nttAVX2(M, 3);
+        nttScalar.useAVX2 = false;
+        for (int n = 1; n <= (1 << 16); n <<= 1) {
+            vector<unsigned> A(n);
+            for (int i = 0; i < n; i++)
+                A[i] = unsigned(RandInt32::get()) % (2u * M);
+            vector<unsigned> B = A;
+
+            nttScalar.transform(A.data(), n);
+            nttAVX2.transform(B.data(), n);
+            assert(A == B);
+
+            nttScalar.inverseTransform(A.data(), n);
+            nttAVX2.inverseTransform(B.data(), n);
+            assert(A == B);
+        }
+    }
+    {
+        cout << "*** Speed test ***" << endl;
+
+        static const int M = 998244353;
+        NTT ntt(M, 3);
+        NTTMontgomery nttMont(M, 3);
+
+        for (int n = 1 << 10; n <= (1 << 20); n <<= 2) {
+            int T = max(1, (1 << 22) / n);
+#ifdef _DEBUG
+            T = 1;
+#endif
+            vector<int> in1(n), in2(n), out1, out2;
+            for (int i = 0; i < n; i++) {
+                in1[i] = RandInt32::get() % M;
+                in2[i] = RandInt32::get() % M;
+            }
+
+            cout << "N = " << n << ", " << T << " times" << endl;
+            cout << "  NTT::multiply() (legacy) : ";
+            PROFILE_START(0);
+            for (int i = 0; i < T; i++)
+                out1 = multiplyLegacy(ntt, in1, in2);
+            PROFILE_STOP(0);
+
+            nttMont.useAVX2 = false;
+            cout << "  NTTMontgomery::multiply() (scalar) : ";
+            PROFILE_START(1);
+            for (int i = 0; i < T; i++)
+                nttMont.multiply(in1, in2, out2);
+            PROFILE_STOP(1);
+            assert(out1 == out2);
+
+            nttMont.useAVX2 = NTTMontgomery::hasAVX2();
+            cout << "  NTTMontgomery::multiply() (AVX2) : ";
+            PROFILE_START(2);
+            for (int i = 0; i < T; i++)
+                nttMont.multiply(in1, in2, out2);
+            PROFILE_STOP(2);
+            assert(out1 == out2);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,500 @@
+#pragma once
+
+#include <cassert>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define NTT_USE_AVX2
+#define NTT_TARGET_AVX2     __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#define NTT_USE_AVX2
+#define NTT_TARGET_AVX2
+#endif
+
+// Number Theoretic Transforms with Montgomery multiplication
+//  - M must be an odd prime less than 2^30 (ex: 998244353, 469762049, 167772161)
+//  - twiddle factors are precomputed once in bit-reversed order and shared by all sizes
+//  - forward transform is DIF (natural order -> bit-reversed order), inverse is DIT (bit-reversed -> natural),
+//    so no bit-reversal pass is needed
+//  - two levels are processed in one pass (radix-4)
+//  - values are kept lazily in [0, 2M) during transforms, multiply() reduces inputs to [0, M) first
+//  - the transform size must be at most 2^k, 2^k | (M - 1) (2^23 for 998244353)
+//  - butterflies and pointwise products run 8 lanes at a time with AVX2 if the CPU supports it,
+//    and the results are bit-identical to the scalar kernels
+//  - scratch buffers are reused across multiply() calls, so an instance is not thread-safe
+struct NTTMontgomery {
+    unsigned M, root;
+    bool useAVX2;               // set false to force the scalar kernels
+
+    NTTMontgomery(int mod, int root) {
+        this->M = unsigned(mod);
+        this->root = unsigned(root);
+        this->M2 = this->M * 2;
+
+        unsigned inv = M;
+        for (int i = 0; i < 5; i++)
+            inv *= 2u - M * inv;
+        negInv = 0u - inv;
+
+        unsigned long long r = (1ull << 32) % M;
+        R2 = unsigned(r * r % M);
+
+        maxLevel = 0;
+        while (maxLevel < 31 && ((M - 1) >> maxLevel & 1) == 0)
+            maxLevel++;
+
+        rt.assign(1, toMont(1));
+        irt.assign(1, toMont(1));
+
+        useAVX2 = hasAVX2();
+    }
+
+    static bool hasAVX2() {
+#if !defined(NTT_USE_AVX2)
+        return false;
+#elif defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || (_xgetbv(0) & 6) != 6)
+            return false;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }
+
+    //--- Montgomery arithmetic
+
+    // x < M * 2^32, result in [0, 2M)
+    unsigned reduce(unsigned long long x) const {
+        unsigned m = unsigned(x) * negInv;
+        return unsigned((x + 1ull * m * M) >> 32);
+    }
+
+    // a * b < M * 2^32, result = a * b / 2^32 (mod M) in [0, 2M)
+    unsigned mul(unsigned a, unsigned b) const {
+        return reduce(1ull * a * b);
+    }
+
+    unsigned toMont(unsigned x) const {
+        return mul(x, R2);
+    }
+
+    // result in [0, M)
+    unsigned fromMont(unsigned x) const {
+        unsigned res = reduce(x);
+        return res >= M ? res - M : res;
+    }
+
+    //--- transforms
+
+    // forward transform, a[] in [0, 2M), natural order -> bit-reversed order
+    void transform(unsigned* a, int n) {
+        prepareRoots(n);
+
+        int blockSize = n;
+        if (log2Int(n) & 1) {
+            int h = n >> 1;
+            for (int i = 0; i < h; i++) {
+                unsigned x = a[i], y = a[i + h];
+                a[i] = reduce2M(x + y);
+                a[i + h] = reduce2M(x - y + M2);
+            }
+            blockSize = h;
+        }
+
+        for (int q = blockSize >> 2; q >= 1; q >>= 2) {
+#ifdef NTT_USE_AVX2
+            if (useAVX2 && q >= 8) {
+                transformPassAVX2(a, n, q);
+                continue;
+            }
+#endif
+            transformPass(a, n, q);
+        }
+    }
+
+    // inverse transform without 1/n scaling, a[] in [0, 2M), bit-reversed order -> natural order
+    void inverseTransform(unsigned* a, int n) {
+        prepareRoots(n);
+
+        int blockSize = (log2Int(n) & 1) ? (n >> 1) : n;
+        for (int q = 1; 4 * q <= blockSize; q <<= 2) {
+#ifdef NTT_USE_AVX2
+            if (useAVX2 && q >= 8) {
+                inverseTransformPassAVX2(a, n, q);
+                continue;
+            }
+#endif
+            inverseTransformPass(a, n, q);
+        }
+
+        if (blockSize != n) {
+            int h = n >> 1;
+            for (int i = 0; i < h; i++) {
+                unsigned x = a[i], y = a[i + h];
+                a[i] = reduce2M(x + y);
+                a[i + h] = reduce2M(x - y + M2);
+            }
+        }
+    }
+
+    //--- polynomial multiplication
+
+    void multiply(const vector<int>& a, const vector<int>& b, vector<int>& out) {
+        if (a.empty() || b.empty()) {
+            out.clear();
+            return;
+        }
+
+        int n = int(a.size()) + int(b.size()) - 1;
+        if (int(min(a.size(), b.size())) <= 32) {
+            multiplySlow(a, b, out);
+            return;
+        }
+
+        int size = 1;
+        while (size < n)
+            size <<= 1;
+
+        bool square = (&a == &b);
+        assert(log2Int(size) <= maxLevel);
+
+        loadInput(bufA, a, size, false);
+        if (!square)
+            loadInput(bufB, b, size, false);
+        convolveBuffers(square, size, n, out);
+    }
+
+    // cyclic convolution of size 2^k (>= |a| + |b| - 1) with b reversed into the tail of its buffer,
+    //   b[i] -> B[size - 1 - i], out[i] = sum(a[j] * B[(i - j) mod size]), 0 <= i < |a| + |b| - 1
+    //  - the same layout as copy(b.begin(), b.end(), B.rbegin()) of NTT::multiply(a, b, true)
+    void multiplyReversedPadded(const vector<int>& a, const vector<int>& b, vector<int>& out) {
+        if (a.empty() || b.empty()) {
+            out.assign(max(0, int(a.size()) + int(b.size()) - 1), 0);
+            return;
+        }
+
+        int n = int(a.size()) + int(b.size()) - 1;
+
+        int size = 1;
+        while (size < n)
+            size <<= 1;
+        assert(log2Int(size) <= maxLevel);
+
+        loadInput(bufA, a, size, false);
+        loadInput(bufB, b, size, true);
+        convolveBuffers(false, size, n, out);
+    }
+
+    // the largest transform size, 2^k | (M - 1)
+    int maxSize() const {
+        return 1 << min(maxLevel, 30);
+    }
+
+    vector<int> multiply(const vector<int>& a, const vector<int>& b) {
+        vector<int> res;
+        multiply(a, b, res);
+        return res;
+    }
+
+    vector<int> multiply(const vector<int>& a, const vector<int>& b, bool reverseB) {
+        if (!reverseB)
+            return multiply(a, b);
+
+        vector<int> revB(b.rbegin(), b.rend());
+        return multiply(a, revB);
+    }
+
+    vector<int> convolute(const vector<int>& x, const vector<int>& h, bool reverseH = true) {
+        return multiply(x, h, reverseH);
+    }
+
+private:
+    unsigned M2;
+    unsigned negInv;            // -M^-1 mod 2^32
+    unsigned R2;                // 2^64 mod M
+    int maxLevel;               // 2^maxLevel | (M - 1)
+
+    // rt[b] = twiddle factor of block b, in bit-reversed order (Montgomery form)
+    //   rt[0] = 1, rt[2^k] = 2^(k+2)-th root of unity, rt[2^k + j] = rt[2^k] * rt[j]
+    vector<unsigned> rt, irt;
+    vector<unsigned> bufA, bufB;
+
+    unsigned reduce2M(unsigned x) const {
+        return x >= M2 ? x - M2 : x;
+    }
+
+    // any int -> [0, M)
+    unsigned reduceInput(int x) const {
+        int r = x % int(M);
+        return unsigned(r < 0 ? r + int(M) : r);
+    }
+
+    // buf[0..size) = in[] reduced to [0, M), zero padded (or reversed into the tail)
+    void loadInput(vector<unsigned>& buf, const vector<int>& in, int size, bool reverseIntoTail) const {
+        if (int(buf.size()) < size)
+            buf.resize(size);
+        int n = int(in.size());
+        if (!reverseIntoTail) {
+            for (int i = 0; i < n; i++)
+                buf[i] = reduceInput(in[i]);
+            fill(buf.begin() + n, buf.begin() + size, 0u);
+        } else {
+            fill(buf.begin(), buf.begin() + (size - n), 0u);
+            for (int i = 0; i < n; i++)
+                buf[size - 1 - i] = reduceInput(in[i]);
+        }
+    }
+
+    // out[0..n) = first n values of the cyclic convolution of bufA and bufB (or bufA itself)
+    void convolveBuffers(bool square, int size, int n, vector<int>& out) {
+        transform(bufA.data(), size);
+        if (square) {
+            multiplyPointwise(bufA.data(), bufA.data(), size);
+        } else {
+            transform(bufB.data(), size);
+            multiplyPointwise(bufA.data(), bufB.data(), size);
+        }
+        inverseTransform(bufA.data(), size);
+
+        // (a * b) / R * n  ->  (a * b)
+        unsigned scale = toMont(toMont(modPow(unsigned(size), M - 2)));
+        out.resize(n);
+        scaleAndReduce(bufA.data(), n, scale);
+        copy(bufA.begin(), bufA.begin() + n, out.begin());
+    }
+
+    //--- scalar kernels
+
+    void transformPass(unsigned* a, int n, int q) const {
+        for (int j = 0, b = 0; j < n; j += 4 * q, b++) {
+            unsigned w1 = rt[b], w2 = rt[2 * b], w3 = rt[2 * b + 1];
+            unsigned* a0 = a + j;
+            unsigned* a1 = a0 + q;
+            unsigned* a2 = a1 + q;
+            unsigned* a3 = a2 + q;
+            for (int i = 0; i < q; i++) {
+                unsigned x2 = mul(a2[i], w1);
+                unsigned x3 = mul(a3[i], w1);
+                unsigned s0 = reduce2M(a0[i] + x2);
+                unsigned s2 = reduce2M(a0[i] - x2 + M2);
+                unsigned u1 = mul(reduce2M(a1[i] + x3), w2);
+                unsigned u3 = mul(reduce2M(a1[i] - x3 + M2), w3);
+                a0[i] = reduce2M(s0 + u1);
+                a1[i] = reduce2M(s0 - u1 + M2);
+                a2[i] = reduce2M(s2 + u3);
+                a3[i] = reduce2M(s2 - u3 + M2);
+            }
+        }
+    }
+
+    void inverseTransformPass(unsigned* a, int n, int q) const {
+        for (int j = 0, b = 0; j < n; j += 4 * q, b++) {
+            unsigned w1 = irt[b], w2 = irt[2 * b], w3 = irt[2 * b + 1];
+            unsigned* a0 = a + j;
+            unsigned* a1 = a0 + q;
+            unsigned* a2 = a1 + q;
+            unsigned* a3 = a2 + q;
+            for (int i = 0; i < q; i++) {
+                unsigned y0 = a0[i], y1 = a1[i], y2 = a2[i], y3 = a3[i];
+                unsigned s0 = reduce2M(y0 + y1);
+                unsigned s1 = mul(y0 - y1 + M2, w2);
+                unsigned s2 = reduce2M(y2 + y3);
+                unsigned s3 = mul(y2 - y3 + M2, w3);
+                a0[i] = reduce2M(s0 + s2);
+                a1[i] = reduce2M(s1 + s3);
+                a2[i] = mul(s0 - s2 + M2, w1);
+                a3[i] = mul(s1 - s3 + M2, w1);
+            }
+        }
+    }
+
+    // a[i] = a[i] * b[i] / R
+    void multiplyPointwise(unsigned* a, const unsigned* b, int n) const {
+        int i = 0;
+#ifdef NTT_USE_AVX2
+        if (useAVX2)
+            i = multiplyPointwiseAVX2(a, b, n);
+#endif
+        for (; i < n; i++)
+            a[i] = mul(a[i], b[i]);
+    }
+
+    // a[i] = a[i] * c / R, in [0, M)
+    void scaleAndReduce(unsigned* a, int n, unsigned c) const {
+        int i = 0;
+#ifdef NTT_USE_AVX2
+        if (useAVX2)
+            i = scaleAndReduceAVX2(a, n, c);
+#endif
+        for (; i < n; i++) {
+            unsigned x = mul(a[i], c);
+            a[i] = x >= M ? x - M : x;
+        }
+    }
+
+#ifdef NTT_USE_AVX2
+    //--- AVX2 kernels (8 lanes)
+
+    // same as mul() for each lane
+    NTT_TARGET_AVX2 static __m256i mulAVX2(__m256i a, __m256i b, __m256i vM, __m256i vNegInv) {
+        __m256i prodE = _mm256_mul_epu32(a, b);
+        __m256i prodO = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+        __m256i mE = _mm256_mul_epu32(prodE, vNegInv);
+        __m256i mO = _mm256_mul_epu32(prodO, vNegInv);
+        __m256i tE = _mm256_add_epi64(prodE, _mm256_mul_epu32(mE, vM));
+        __m256i tO = _mm256_add_epi64(prodO, _mm256_mul_epu32(mO, vM));
+        return _mm256_blend_epi32(_mm256_srli_epi64(tE, 32), tO, 0xAA);
+    }
+
+    // same as reduce2M() for each lane
+    NTT_TARGET_AVX2 static __m256i reduce2MAVX2(__m256i x, __m256i vM2) {
+        return _mm256_min_epu32(x, _mm256_sub_epi32(x, vM2));
+    }
+
+    NTT_TARGET_AVX2 void transformPassAVX2(unsigned* a, int n, int q) const {
+        const __m256i vM = _mm256_set1_epi32(int(M));
+        const __m256i vM2 = _mm256_set1_epi32(int(M2));
+        const __m256i vNegInv = _mm256_set1_epi32(int(negInv));
+        for (int j = 0, b = 0; j < n; j += 4 * q, b++) {
+            const __m256i w1 = _mm256_set1_epi32(int(rt[b]));
+            const __m256i w2 = _mm256_set1_epi32(int(rt[2 * b]));
+            const __m256i w3 = _mm256_set1_epi32(int(rt[2 * b + 1]));
+            __m256i* a0 = reinterpret_cast<__m256i*>(a + j);
+            __m256i* a1 = reinterpret_cast<__m256i*>(a + j + q);
+            __m256i* a2 = reinterpret_cast<__m256i*>(a + j + 2 * q);
+            __m256i* a3 = reinterpret_cast<__m256i*>(a + j + 3 * q);
+            for (int i = 0; i < (q >> 3); i++) {
+                __m256i v0 = _mm256_loadu_si256(a0 + i);
+                __m256i v1 = _mm256_loadu_si256(a1 + i);
+                __m256i x2 = mulAVX2(_mm256_loadu_si256(a2 + i), w1, vM, vNegInv);
+                __m256i x3 = mulAVX2(_mm256_loadu_si256(a3 + i), w1, vM, vNegInv);
+                __m256i s0 = reduce2MAVX2(_mm256_add_epi32(v0, x2), vM2);
+                __m256i s2 = reduce2MAVX2(_mm256_add_epi32(_mm256_sub_epi32(v0, x2), vM2), vM2);
+                __m256i u1 = mulAVX2(reduce2MAVX2(_mm256_add_epi32(v1, x3), vM2), w2, vM, vNegInv);
+                __m256i u3 = mulAVX2(reduce2MAVX2(_mm256_add_epi32(_mm256_sub_epi32(v1, x3), vM2), vM2), w3, vM, vNegInv);
+                _mm256_storeu_si256(a0 + i, reduce2MAVX2(_mm256_add_epi32(s0, u1), vM2));
+                _mm256_storeu_si256(a1 + i, reduce2MAVX2(_mm256_add_epi32(_mm256_sub_epi32(s0, u1), vM2), vM2));
+                _mm256_storeu_si256(a2 + i, reduce2MAVX2(_mm256_add_epi32(s2, u3), vM2));
+                _mm256_storeu_si256(a3 + i, reduce2MAVX2(_mm256_add_epi32(_mm256_sub_epi32(s2, u3), vM2), vM2));
+            }
+        }
+    }
+
+    NTT_TARGET_AVX2 void inverseTransformPassAVX2(unsigned* a, int n, int q) const {
+        const __m256i vM = _mm256_set1_epi32(int(M));
+        const __m256i vM2 = _mm256_set1_epi32(int(M2));
+        const __m256i vNegInv = _mm256_set1_epi32(int(negInv));
+        for (int j = 0, b = 0; j < n; j += 4 * q, b++) {
+            const __m256i w1 = _mm256_set1_epi32(int(irt[b]));
+            const __m256i w2 = _mm256_set1_epi32(int(irt[2 * b]));
+            const __m256i w3 = _mm256_set1_epi32(int(irt[2 * b + 1]));
+            __m256i* a0 = reinterpret_cast<__m256i*>(a + j);
+            __m256i* a1 = reinterpret_cast<__m256i*>(a + j + q);
+            __m256i* a2 = reinterpret_cast<__m256i*>(a + j + 2 * q);
+            __m256i* a3 = reinterpret_cast<__m256i*>(a + j + 3 * q);
+            for (int i = 0; i < (q >> 3); i++) {
+                __m256i y0 = _mm256_loadu_si256(a0 + i);
+                __m256i y1 = _mm256_loadu_si256(a1 + i);
+                __m256i y2 = _mm256_loadu_si256(a2 + i);
+                __m256i y3 = _mm256_loadu_si256(a3 + i);
+                __m256i s0 = reduce2MAVX2(_mm256_add_epi32(y0, y1), vM2);
+                __m256i s1 = mulAVX2(_mm256_add_epi32(_mm256_sub_epi32(y0, y1), vM2), w2, vM, vNegInv);
+                __m256i s2 = reduce2MAVX2(_mm256_add_epi32(y2, y3), vM2);
+                __m256i s3 = mulAVX2(_mm256_add_epi32(_mm256_sub_epi32(y2, y3), vM2), w3, vM, vNegInv);
+                _mm256_storeu_si256(a0 + i, reduce2MAVX2(_mm256_add_epi32(s0, s2), vM2));
+                _mm256_storeu_si256(a1 + i, reduce2MAVX2(_mm256_add_epi32(s1, s3), vM2));
+                _mm256_storeu_si256(a2 + i, mulAVX2(_mm256_add_epi32(_mm256_sub_epi32(s0, s2), vM2), w1, vM, vNegInv));
+                _mm256_storeu_si256(a3 + i, mulAVX2(_mm256_add_epi32(_mm256_sub_epi32(s1, s3), vM2), w1, vM, vNegInv));
+            }
+        }
+    }
+
+    // returns the number of processed elements
+    NTT_TARGET_AVX2 int multiplyPointwiseAVX2(unsigned* a, const unsigned* b, int n) const {
+        const __m256i vM = _mm256_set1_epi32(int(M));
+        const __m256i vNegInv = _mm256_set1_epi32(int(negInv));
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), mulAVX2(x, y, vM, vNegInv));
+        }
+        return i;
+    }
+
+    // returns the number of processed elements
+    NTT_TARGET_AVX2 int scaleAndReduceAVX2(unsigned* a, int n, unsigned c) const {
+        const __m256i vM = _mm256_set1_epi32(int(M));
+        const __m256i vNegInv = _mm256_set1_epi32(int(negInv));
+        const __m256i vC = _mm256_set1_epi32(int(c));
+        int i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i x = mulAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)), vC, vM, vNegInv);
+            x = _mm256_min_epu32(x, _mm256_sub_epi32(x, vM));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(a + i), x);
+        }
+        return i;
+    }
+#endif
+
+    static int log2Int(int n) {
+        int res = 0;
+        while ((1 << (res + 1)) <= n)
+            res++;
+        return res;
+    }
+
+    unsigned modPow(unsigned x, unsigned n) const {
+        unsigned long long res = 1, t = x % M;
+        for (; n > 0; n >>= 1) {
+            if (n & 1)
+                res = res * t % M;
+            t = t * t % M;
+        }
+        return unsigned(res);
+    }
+
+    void prepareRoots(int n) {
+        int half = max(1, n >> 1);
+        int cur = int(rt.size());
+        if (cur >= half)
+            return;
+
+        // n must divide (M - 1), log2(n) <= maxLevel
+        assert(log2Int(n) <= maxLevel);
+        rt.resize(half);
+        irt.resize(half);
+        for (int k = log2Int(cur); (1 << k) < half; k++) {
+            unsigned w = modPow(root, (M - 1) >> (k + 2));
+            unsigned wMont = toMont(w);
+            unsigned iwMont = toMont(modPow(w, M - 2));
+            int base = 1 << k;
+            for (int j = 0; j < base; j++) {
+                rt[base + j] = fromMontLazy(mul(wMont, rt[j]));
+                irt[base + j] = fromMontLazy(mul(iwMont, irt[j]));
+            }
+        }
+    }
+
+    // [0, 2M) -> [0, M)
+    unsigned fromMontLazy(unsigned x) const {
+        return x >= M ? x - M : x;
+    }
+
+    void multiplySlow(const vector<int>& a, const vector<int>& b, vector<int>& out) {
+        int n = int(a.size()) + int(b.size()) - 1;
+        vector<unsigned long long> res(n);
+        for (int i = 0; i < int(a.size()); i++) {
+            for (int j = 0; j < int(b.size()); j++)
+                res[i + j] = (res[i + j] + 1ull * reduceInput(a[i]) * reduceInput(b[j])) % M;
+        }
+        out.resize(n);
+        for (int i = 0; i < n; i++)
+            out[i] = int(res[i]);
+    }
+};
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <mutex>
+
+#include "../common/parallelFor.h"
 #include "ntt.h"
 
+// multiply() and multiplyFast() share static NTT instances with scratch buffers, they must not be called
+// concurrently, use multiplyParallel() from threads
 struct PolyNTT {
     static vector<int> multiply(const vector<int>& a, const vector<int>& b, int MOD) {
         static NTT ntt1(167772161, 3);
@@ -39,34 +44,83 @@ struct PolyNTT {
         auto y = ntt2.multiply(a, b);
         auto z = ntt3.multiply(a, b);
 
-        const int m1 = ntt1.M;
-        const int m2 = ntt2.M;
-        const int m3 = ntt3.M;
-
-        const int m1InvM2 = modInvIter(m1, m2);
-        const int m12InvM3 = modInvIter(1ll * m1 * m2 % m3, m3);
-        const int m12Mod = 1ll * m1 * m2 % MOD;
-
         vector<int> res(x.size());
-        for (int i = 0; i < int(x.size()); i++) {
-            int v1 = int(1ll * (y[i] - x[i]) *  m1InvM2 % m2);
-            if (v1 < 0)
-                v1 += m2;
+        garnerRange(x, y, z, ntt1.M, ntt2.M, ntt3.M, MOD, res, 0, int(x.size()));
 
-            int v2 = int(1ll * (z[i] - (x[i] + 1ll * m1 * v1) % m3) * m12InvM3 % m3);
-            if (v2 < 0)
-                v2 += m3;
+        return res;
+    }
 
-            int b3 = (x[i] + 1ll * m1 * v1 + 1ll * m12Mod * v2) % MOD;
-            if (b3 < 0)
-                b3 += MOD;
+    // multi-threaded multiplyFast()
+    //  - the three modular products run on up to three threads, with the primes
+    //    167772161 (2^25 | M - 1), 469762049 (2^26 | M - 1) and 754974721 (2^24 | M - 1)
+    //  - a product longer than the transform size of a prime is split into blocks (multiplyBlocks())
+    //  - CRT reconstruction is split into 'threadCount' ranges
+    //  - min(|a|, |b|) * (MOD - 1)^2 must be less than M1 * M2 * M3 (about 5.9 * 10^25)
+    //  - it's thread-safe, the cached engine of each prime is locked while it's used
+    static vector<int> multiplyParallel(const vector<int>& a, const vector<int>& b, int MOD, int threadCount) {
+        static const int M1 = 167772161;
+        static const int M2 = 469762049;
+        static const int M3 = 754974721;
+        static NTTMontgomery engines[3] = { NTTMontgomery(M1, 3), NTTMontgomery(M2, 3), NTTMontgomery(M3, 11) };
+        static mutex locks[3];
+
+        if (a.empty() || b.empty())
+            return vector<int>();
+        assert((long double)min(a.size(), b.size()) * (MOD - 1) * (MOD - 1) < (long double)M1 * M2 * M3);
+
+        // NTTMontgomery::multiply() reduces a[] and b[] mod each prime
+        vector<int> x, y, z;
+        vector<int>* outs[3] = { &x, &y, &z };
+        parallelFor(3, threadCount, [&a, &b, &outs](int first, int last) {
+            for (int i = first; i < last; i++) {
+                lock_guard<mutex> lock(locks[i]);
+                multiplyBlocks(engines[i], a, b, *outs[i], engines[i].maxSize());
+            }
+        });
 
-            res[i] = b3;
-        }
+        int n = int(x.size());
+        vector<int> res(n);
+        parallelFor(n, max(1, min(threadCount, n / 4096)), [&](int first, int last) {
+            garnerRange(x, y, z, M1, M2, M3, MOD, res, first, last);
+        });
 
         return res;
     }
 
+    // out = a * b mod ntt.M, split into blocks whose products are not longer than 'maxSize' (a power of 2)
+    static void multiplyBlocks(NTTMontgomery& ntt, const vector<int>& a, const vector<int>& b, vector<int>& out,
+                               int maxSize) {
+        int n = int(a.size()) + int(b.size()) - 1;
+        if (n <= maxSize) {
+            ntt.multiply(a, b, out);
+            return;
+        }
+        assert(maxSize >= 2);
+
+        const vector<int>& s = (a.size() <= b.size()) ? a : b;
+        const vector<int>& l = (a.size() <= b.size()) ? b : a;
+        int sN = int(s.size()), lN = int(l.size());
+        int sBlock = min(sN, maxSize / 2);
+        int lBlock = maxSize + 1 - sBlock;
+
+        int M = int(ntt.M);
+        out.assign(n, 0);
+
+        vector<int> sPart, lPart, prod;
+        for (int i = 0; i < sN; i += sBlock) {
+            sPart.assign(s.begin() + i, s.begin() + min(sN, i + sBlock));
+            for (int j = 0; j < lN; j += lBlock) {
+                lPart.assign(l.begin() + j, l.begin() + min(lN, j + lBlock));
+                ntt.multiply(sPart, lPart, prod);
+
+                int* dst = out.data() + i + j;
+                for (int k = 0; k < int(prod.size()); k++) {
+                    int v = dst[k] + prod[k];
+                    dst[k] = (v >= M) ? v - M : v;
+                }
+            }
+        }
+    }
 
     static vector<int> multiply(const vector<int>& a, const vector<int>& b, int MOD, bool reverseB) {
         if (!reverseB)
@@ -82,6 +136,30 @@ struct PolyNTT {
     }
 
 private:
+    // res[i] = CRT(x[i] mod m1, y[i] mod m2, z[i] mod m3) mod MOD, first <= i < last
+    static void garnerRange(const vector<int>& x, const vector<int>& y, const vector<int>& z,
+                            int m1, int m2, int m3, int MOD, vector<int>& res, int first, int last) {
+        const int m1InvM2 = modInvIter(m1, m2);
+        const int m12InvM3 = modInvIter(1ll * m1 * m2 % m3, m3);
+        const int m12Mod = 1ll * m1 * m2 % MOD;
+
+        for (int i = first; i < last; i++) {
+            int v1 = int(1ll * (y[i] - x[i]) *  m1InvM2 % m2);
+            if (v1 < 0)
+                v1 += m2;
+
+            int v2 = int(1ll * (z[i] - (x[i] + 1ll * m1 * v1) % m3) * m12InvM3 % m3);
+            if (v2 < 0)
+                v2 += m3;
+
+            int b3 = (x[i] + 1ll * m1 * v1 + 1ll * m12Mod * v2) % MOD;
+            if (b3 < 0)
+                b3 += MOD;
+
+            res[i] = b3;
+        }
+    }
+
     static int garner(vector<pair<int, int>> p, int MOD) {
         int n = int(p.size());
 
@@ -0,0 +1,186 @@
+#include <vector>
+#include <limits>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+#include "fenwickTree.h"
+#include "segmentTreeCompact.h"
+#include "segmentTreeRMQ.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+static vector<pair<int, int>> makeRandomRanges(int N, int Q) {
+    vector<pair<int, int>> res(Q);
+    for (int i = 0; i < Q; i++) {
+        int L = RandInt32::get() % N;
+        int R = RandInt32::get() % N;
+        if (L > R)
+            swap(L, R);
+        res[i] = make_pair(L, R);
+    }
+    return res;
+}
+
+static vector<pair<int, int>> makeRandomUpdates(int N, int Q) {
+    vector<pair<int, int>> res(Q);
+    for (int i = 0; i < Q; i++)
+        res[i] = make_pair(int(RandInt32::get() % N), int(RandInt32::get() % 100));
+    return res;
+}
+
+void testBatchQuery() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Batch Query ---------------------------------" << endl;
+    {
+        for (int N = 1; N <= 300; N += 13) {
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = RandInt32::get() % 1000;
+
+            FenwickTree<int> ft1(in), ft2(in);
+            CompactSegmentTree<int, MinOp<int>> st1(in), st2(in);
+            CompactSegmentTree<int, SumOp<int>> st3(in, SumOp<int>(), 0, true), st4(in, SumOp<int>(), 0, true);
+            RMQ rmq1(in), rmq2(in);
+
+            for (int t = 0; t < 10; t++) {
+                // duplicated indices in a batch must keep the last value
+                vector<pair<int, int>> upd = makeRandomUpdates(N, 50);
+                for (auto& it : upd) {
+                    ft1.add(it.first, it.second);
+                    st1.update(it.first, it.second);
+                    st3.update(it.first, it.second);
+                    rmq1.update(it.first, it.second);
+                }
+                ft2.updateBatch(upd);
+                st2.updateBatch(upd);
+                st4.updateBatch(upd);
+                rmq2.updateBatch(upd);
+                assert(ft1.tree == ft2.tree);
+                assert(st1.tree == st2.tree);
+                assert(st3.tree == st4.tree);
+                assert(rmq1.value == rmq2.value && rmq1.valueId == rmq2.valueId);
+
+                vector<pair<int, int>> qry = makeRandomRanges(N, 100);
+                vector<int> ans1 = ft2.queryBatch(qry);
+                vector<int> ans2 = st2.queryBatch(qry);
+                vector<int> ans3 = st4.queryBatch(qry);
+                vector<int> ans4 = rmq2.queryBatch(qry);
+                for (int i = 0; i < int(qry.size()); i++) {
+                    assert(ans1[i] == ft1.sumRange(qry[i].first, qry[i].second));
+                    assert(ans2[i] == st1.query(qry[i].first, qry[i].second));
+                    assert(ans3[i] == st3.query(qry[i].first, qry[i].second));
+                    assert(ans4[i] == rmq1.query(qry[i].first, qry[i].second));
+                }
+            }
+        }
+    }
+    {
+        cout << "*** Speed test : one by one vs. batch ***" << endl;
+
+        int N = 1 << 23;
+        int Q = 1000000;
+#ifdef _DEBUG
+        N = 1 << 16;
+        Q = 100000;
+#endif
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get() % 100;
+        vector<pair<int, int>> qry = makeRandomRanges(N, Q);
+        vector<pair<int, int>> upd = makeRandomUpdates(N, Q);
+        vector<int> ans1(Q), ans2(Q);
+
+        cout << "N = " << N << ", Q = " << Q << endl;
+        {
+            FenwickTree<int> ft1(in), ft2(in);
+            cout << "  FenwickTree::sumRange() : ";
+            PROFILE_START(0);
+            for (int i = 0; i < Q; i++)
+                ans1[i] = ft1.sumRange(qry[i].first, qry[i].second);
+            PROFILE_STOP(0);
+
+            cout << "  FenwickTree::queryBatch() : ";
+            PROFILE_START(1);
+            ft1.queryBatch(qry.data(), Q, ans2.data());
+            PROFILE_STOP(1);
+            assert(ans1 == ans2);
+
+            cout << "  FenwickTree::add() : ";
+            PROFILE_START(2);
+            for (auto& it : upd)
+                ft1.add(it.first, it.second);
+            PROFILE_STOP(2);
+
+            cout << "  FenwickTree::updateBatch() : ";
+            PROFILE_START(3);
+            ft2.updateBatch(upd);
+            PROFILE_STOP(3);
+            assert(ft1.tree == ft2.tree);
+        }
+        {
+            CompactSegmentTree<int, SumOp<int>> st1(in), st2(in);
+            cout << "  CompactSegmentTree::query() : ";
+            PROFILE_START(4);
+            for (int i = 0; i < Q; i++)
+                ans1[i] = st1.query(qry[i].first, qry[i].second);
+            PROFILE_STOP(4);
+
+            cout << "  CompactSegmentTree::queryBatch() : ";
+            PROFILE_START(5);
+            st1.queryBatch(qry.data(), Q, ans2.data());
+            PROFILE_STOP(5);
+            assert(ans1 == ans2);
+
+            cout << "  CompactSegmentTree::update() : ";
+            PROFILE_START(6);
+            for (auto& it : upd)
+                st1.update(it.first, it.second);
+            PROFILE_STOP(6);
+
+            cout << "  CompactSegmentTree::updateBatch() : ";
+            PROFILE_START(7);
+            st2.updateBatch(upd);
+            PROFILE_STOP(7);
+            assert(st1.tree == st2.tree);
+        }
+        {
+            RMQ rmq1(in), rmq2(in);
+            cout << "  RMQ::query() : ";
+            PROFILE_START(8);
+            for (int i = 0; i < Q; i++)
+                ans1[i] = rmq1.query(qry[i].first, qry[i].second);
+            PROFILE_STOP(8);
+
+            cout << "  RMQ::queryBatch() : ";
+            PROFILE_START(9);
+            rmq1.queryBatch(qry.data(), Q, ans2.data());
+            PROFILE_STOP(9);
+            assert(ans1 == ans2);
+
+            cout << "  RMQ::update() : ";
+            PROFILE_START(10);
+            for (auto& it : upd)
+                rmq1.update(it.first, it.second);
+            PROFILE_STOP(10);
+
+            cout << "  RMQ::updateBatch() : ";
+            PROFILE_START(11);
+            rmq2.updateBatch(upd);
+            PROFILE_STOP(11);
+            assert(rmq1.value == rmq2.value);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef __GNUC__
+#include <xmmintrin.h>
+#endif
+
+// Helpers for queryBatch()/updateBatch() of the range query trees
+//  - queries of a batch are independent, so while the i-th query walks the tree, the leaves of the
+//    (i + QUERY_PREFETCH_DISTANCE)-th query are prefetched
+//  - upper levels are shared by all queries and stay in cache, so only the bottom of each path misses
+
+#ifndef QUERY_PREFETCH_DISTANCE
+#define QUERY_PREFETCH_DISTANCE     16
+#endif
+
+inline void prefetchRead(const void* p) {
+#ifndef __GNUC__
+    _mm_prefetch((const char*)p, _MM_HINT_T0);
+#else
+    __builtin_prefetch(p, 0, 3);
+#endif
+}
+
+inline void prefetchWrite(const void* p) {
+#ifndef __GNUC__
+    _mm_prefetch((const char*)p, _MM_HINT_T0);
+#else
+    __builtin_prefetch(p, 1, 3);
+#endif
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "monoid.h"
+
 template <typename T, typename MergeOp = function<T(T, T)>, typename BlockOp = function<T(T, int)>>
 struct DynamicSegmentTreeLazy {
     struct Node {
@@ -31,7 +33,7 @@ struct DynamicSegmentTreeLazy {
     MergeOp mergeOp;
     BlockOp blockOp;
 
-    DynamicSegmentTreeLazy(int rangeMin, int rangeMax, MergeOp mop, BlockOp bop, T dflt = T())
+    DynamicSegmentTreeLazy(int rangeMin, int rangeMax, MergeOp mop = MergeOp(), BlockOp bop = BlockOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : rangeMin(rangeMin), rangeMax(rangeMax), defaultValue(dflt), mergeOp(mop), blockOp(bop) {
         root = createNode(defaultValue);
     }
@@ -140,6 +142,6 @@ private:
 
 template <typename T, typename MergeOp, typename BlockOp>
 inline DynamicSegmentTreeLazy<T, MergeOp, BlockOp>
-makeDynamicSegmentTreeLazy(int left, int right, MergeOp mop, BlockOp bop, T dfltValue = T()) {
-    return SegmentTreeLazy<T, MergeOp, BlockOp>(left, right, mop, bop, dfltValue);
+makeDynamicSegmentTreeLazy(int left, int right, MergeOp mop, BlockOp bop, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
+    return DynamicSegmentTreeLazy<T, MergeOp, BlockOp>(left, right, mop, bop, dfltValue);
 }
@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include "batchQuery.h"
+
 //--------- Fenwick Tree (Binary Indexed Tree) --------------------------------
 
 /*
@@ -136,6 +138,48 @@ struct FenwickTree {
         add(pos, val - get(pos));
     }
 
+    //--- batch
+
+    // res[i] = sumRange(qry[i].first, qry[i].second), see batchQuery.h
+    void queryBatch(const pair<int, int> qry[], int n, T res[]) const {
+        const T* tr = tree.data();
+        for (int i = 0; i < n; i++) {
+            if (i + QUERY_PREFETCH_DISTANCE < n) {
+                prefetchRead(tr + qry[i + QUERY_PREFETCH_DISTANCE].first);
+                prefetchRead(tr + qry[i + QUERY_PREFETCH_DISTANCE].second + 1);
+            }
+
+            // the two walks stop where their paths meet, because the rest cancels out
+            int R = qry[i].second + 1;
+            int L = qry[i].first;
+            T sum = 0;
+            for (; R > L; R &= R - 1)
+                sum += tr[R];
+            for (; L > R; L &= L - 1)
+                sum -= tr[L];
+            res[i] = sum;
+        }
+    }
+
+    vector<T> queryBatch(const vector<pair<int, int>>& qry) const {
+        vector<T> res(qry.size());
+        queryBatch(qry.data(), int(qry.size()), res.data());
+        return res;
+    }
+
+    // add(upd[i].first, upd[i].second) for all i
+    void updateBatch(const pair<int, T> upd[], int n) {
+        for (int i = 0; i < n; i++) {
+            if (i + QUERY_PREFETCH_DISTANCE < n)
+                prefetchWrite(&tree[upd[i + QUERY_PREFETCH_DISTANCE].first + 1]);
+            add(upd[i].first, upd[i].second);
+        }
+    }
+
+    void updateBatch(const vector<pair<int, T>>& upd) {
+        updateBatch(upd.data(), int(upd.size()));
+    }
+
     //--- lower bound
 
     // PRECONDITION: tree's values are monotonically increasing (ex: positive values)
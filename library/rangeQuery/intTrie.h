@@ -1,5 +1,7 @@
 #pragma once
 
+#include "monoid.h"
+
 // Trie Forest
 template <typename T, typename IntT = int, typename GetOp = function<IntT(T)>, typename MergeOp = function<T(T,T)>>
 struct IntTrie {
@@ -16,7 +18,7 @@ struct IntTrie {
     int nodeN;
     vector<Node> nodes;
 
-    IntTrie(int bitSize, GetOp getOp, MergeOp mergeOp)
+    explicit IntTrie(int bitSize, GetOp getOp = GetOp(), MergeOp mergeOp = MergeOp())
         : bitSize(bitSize), getOp(getOp), mergeOp(mergeOp), nodeN(0) {
     }
 
@@ -10,6 +10,7 @@ int main(void) {
     TEST(SqrtDecompositionSum);
     TEST(MOAlgorithm);
     TEST(FenwickTree);
+    TEST(BatchQuery);
     TEST(FenwickTreeXor);
     TEST(FenwickTree2D);
     TEST(FenwickTreeMultAdd);
@@ -17,18 +18,21 @@ int main(void) {
     TEST(GeneralizedBIT);
     TEST(PersistentFenwickTree);
     TEST(PersistentFenwickTreeMultAdd);
+    TEST(Monoid);
     TEST(SegmentTree);
     TEST(SegmentTreePersistent);
     TEST(SegmentTreePartiallyPersistent);
     TEST(SegmentTreePersistentSimple);
     TEST(SegmentTreePersistentLazySimple);
     TEST(SegmentTreeCompact);
+    TEST(SegmentTreeBlocked);
     TEST(SegmentTreeCompactLazy);
     TEST(SegmentTreeCompactLazyAdd);
     TEST(SegmentTreeMaxSubarray);
     TEST(DynamicSegmentTree);
     TEST(DynamicSegmentTreeMaxSubarray);
     TEST(SparseTable);
+    TEST(SparseTableBlocked);
     TEST(SparseTable2D);
     TEST(DisjointSparseTable);
     TEST(SparseTableSimpleRMQ);
@@ -38,6 +42,7 @@ int main(void) {
     TEST(SegmentTreeLineSegment2D);
     TEST(SegmentTreeLineSegment2DSum);
     TEST(SqrtTree);
+    TEST(ParallelFor);
     TEST(CompactSqrtTree);
     TEST(FastSqrtTree);
     TEST(MergeSortTree);
@@ -49,6 +54,7 @@ int main(void) {
     TEST(MergeSortTreeCompact);
     TEST(MergeSortTreeCompactWithSum);
     TEST(MergeSortTreeConvexHull);
+    TEST(MergeSortTreeCascading);
     TEST(ReverseSparseTable);
     TEST(SegmentTreeBitFlip);
     TEST(OfflineRMQ);
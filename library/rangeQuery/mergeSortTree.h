@@ -1,5 +1,7 @@
 #pragma once
 
+#include <thread>
+
 // space : O(NlogN)
 template <typename T>
 struct MergeSortTree {
@@ -18,15 +20,15 @@ struct MergeSortTree {
     }
 
 
-    // O(NlogN)
-    void build(const T arr[], int n) {
+    // O(NlogN), subtrees of the top log2(threadCount) levels are built by separate threads
+    void build(const T arr[], int n, int threadCount = 1) {
         N = n;
         tree.resize(n * 4);
-        buildSub(arr, 0, n - 1, 0);
+        buildSub(arr, 0, n - 1, 0, threadCount);
     }
 
-    void build(const vector<T>& v) {
-        build(&v[0], int(v.size()));
+    void build(const vector<T>& v, int threadCount = 1) {
+        build(&v[0], int(v.size()), threadCount);
     }
 
 
@@ -82,18 +84,30 @@ struct MergeSortTree {
 
 private:
     // inclusive
-    void buildSub(const T arr[], int left, int right, int node) {
+    void buildSub(const T arr[], int left, int right, int node, int threadCount = 1) {
         if (left == right) {
-            tree[node].push_back(arr[left]);
+            tree[node].assign(1, arr[left]);
             return;
         }
 
         int mid = left + (right - left) / 2;
-        buildSub(arr, left, mid, node * 2 + 1);
-        buildSub(arr, mid + 1, right, node * 2 + 2);
-        merge(tree[2 * node + 1].begin(), tree[2 * node + 1].end(),
-              tree[2 * node + 2].begin(), tree[2 * node + 2].end(),
-              back_inserter(tree[node]));
+        if (threadCount > 1) {
+            // the two subtrees use disjoint nodes
+            int threadCountL = threadCount / 2;
+            thread th([this, arr, left, mid, node, threadCountL]() {
+                buildSub(arr, left, mid, node * 2 + 1, threadCountL);
+            });
+            buildSub(arr, mid + 1, right, node * 2 + 2, threadCount - threadCountL);
+            th.join();
+        } else {
+            buildSub(arr, left, mid, node * 2 + 1);
+            buildSub(arr, mid + 1, right, node * 2 + 2);
+        }
+
+        tree[node].resize(tree[node * 2 + 1].size() + tree[node * 2 + 2].size());
+        merge(tree[node * 2 + 1].begin(), tree[node * 2 + 1].end(),
+              tree[node * 2 + 2].begin(), tree[node * 2 + 2].end(),
+              tree[node].begin());
     }
 
     int countLessThanOrEqualSub(int left, int right, T k, int node, int nodeLeft, int nodeRight) const {
@@ -0,0 +1,156 @@
+#include <limits>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+#include "mergeSortTreeCascading.h"
+#include "mergeSortTreeCascadingWithSum.h"
+#include "mergeSortTreeCascadingIndex.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+#include "mergeSortTree.h"
+#include "mergeSortTreeWithSum.h"
+#include "mergeSortTreeIndex.h"
+
+void testMergeSortTreeCascading() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Merge Sort Tree with Fractional Cascading ---" << endl;
+    {
+        for (int N = 1; N <= 200; N += 7) {
+            for (int maxValue : { 10, 1000 }) {
+                vector<int> in(N);
+                for (int i = 0; i < N; i++)
+                    in[i] = RandInt32::get() % maxValue;
+
+                MergeSortTree<int> tree1(in);
+                CascadingMergeSortTree<int> tree2(in);
+                MergeSortTreeWithSum<int> tree3(in);
+                CascadingMergeSortTreeWithSum<int> tree4(in);
+                MergeSortTreeIndex<int> tree5(in);
+                CascadingMergeSortTreeIndex<int> tree6(in);
+
+                for (int t = 0; t < 100; t++) {
+                    int L = RandInt32::get() % N;
+                    int R = RandInt32::get() % N;
+                    if (L > R)
+                        swap(L, R);
+                    int K = RandInt32::get() % (R - L + 1);
+                    int lo = RandInt32::get() % maxValue;
+                    int hi = RandInt32::get() % maxValue;
+                    if (lo > hi)
+                        swap(lo, hi);
+
+                    assert(tree1.countLessThanOrEqual(L, R, lo) == tree2.countLessThanOrEqual(L, R, lo));
+                    assert(tree1.countLessThanOrEqual(lo) == tree2.countLessThanOrEqual(lo));
+                    assert(tree1.count(L, R, lo) == tree2.count(L, R, lo));
+                    assert(tree1.count(L, R, lo, hi) == tree2.count(L, R, lo, hi));
+                    assert(tree1.count(lo, hi) == tree2.count(lo, hi));
+                    assert(tree1.kth(L, R, K, 0, maxValue - 1) == tree2.kth(L, R, K, 0, maxValue - 1));
+                    assert(tree1.kth(L, R, K, lo, hi) == tree2.kth(L, R, K, lo, hi));
+                    assert(tree1.kth(K) == tree2.kth(K));
+
+                    assert(tree3.countLessThanOrEqual(L, R, lo) == tree4.countLessThanOrEqual(L, R, lo));
+                    assert(tree3.countLessThanOrEqual(lo) == tree4.countLessThanOrEqual(lo));
+                    assert(tree3.count(L, R, lo, hi) == tree4.count(L, R, lo, hi));
+                    assert(tree3.count(lo, hi) == tree4.count(lo, hi));
+                    assert(tree3.kth(L, R, K, lo, hi) == tree4.kth(L, R, K, lo, hi));
+
+                    assert(tree1.countLessThanOrEqual(L, R, lo) == tree6.countLessThanOrEqual(L, R, lo));
+                    assert(tree1.countLessThanOrEqual(lo) == tree6.countLessThanOrEqual(lo));
+                    assert(tree1.count(L, R, lo, hi) == tree6.count(L, R, lo, hi));
+                    assert(tree5.kthIndex(L, R, K) == tree6.kthIndex(L, R, K));
+                    assert(tree5.kthIndex(K) == tree6.kthIndex(K));
+                    assert(tree5.kth(L, R, K) == tree6.kth(L, R, K));
+                    assert(tree5.kth(K) == tree6.kth(K));
+                }
+            }
+        }
+    }
+    {
+        cout << "*** Speed test ***" << endl;
+
+        int N = 1 << 20;
+        int Q = 1000000;
+#ifdef _DEBUG
+        N = 1 << 14;
+        Q = 10000;
+#endif
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get() % 1000000000;
+
+        vector<int> qL(Q), qR(Q), qK(Q), qV(Q);
+        for (int i = 0; i < Q; i++) {
+            qL[i] = RandInt32::get() % N;
+            qR[i] = RandInt32::get() % N;
+            if (qL[i] > qR[i])
+                swap(qL[i], qR[i]);
+            qK[i] = RandInt32::get() % (qR[i] - qL[i] + 1);
+            qV[i] = RandInt32::get() % 1000000000;
+        }
+
+        cout << "N = " << N << ", Q = " << Q << endl;
+
+        long long sum1 = 0, sum2 = 0;
+        {
+            cout << "  MergeSortTree::build() : ";
+            PROFILE_START(0);
+            MergeSortTree<int> tree(in);
+            PROFILE_STOP(0);
+
+            cout << "  MergeSortTree::countLessThanOrEqual() : ";
+            PROFILE_START(1);
+            for (int i = 0; i < Q; i++)
+                sum1 += tree.countLessThanOrEqual(qL[i], qR[i], qV[i]);
+            PROFILE_STOP(1);
+        }
+        {
+            cout << "  CascadingMergeSortTree::build() : ";
+            PROFILE_START(2);
+            CascadingMergeSortTree<int> tree(in);
+            PROFILE_STOP(2);
+
+            cout << "  CascadingMergeSortTree::countLessThanOrEqual() : ";
+            PROFILE_START(3);
+            for (int i = 0; i < Q; i++)
+                sum2 += tree.countLessThanOrEqual(qL[i], qR[i], qV[i]);
+            PROFILE_STOP(3);
+        }
+        assert(sum1 == sum2);
+
+        sum1 = sum2 = 0;
+        {
+            MergeSortTreeIndex<int> tree(in);
+            cout << "  MergeSortTreeIndex::kthIndex() : ";
+            PROFILE_START(4);
+            for (int i = 0; i < Q; i++)
+                sum1 += tree.kthIndex(qL[i], qR[i], qK[i]);
+            PROFILE_STOP(4);
+        }
+        {
+            CascadingMergeSortTreeIndex<int> tree(in);
+            cout << "  CascadingMergeSortTreeIndex::kthIndex() : ";
+            PROFILE_START(5);
+            for (int i = 0; i < Q; i++)
+                sum2 += tree.kthIndex(qL[i], qR[i], qK[i]);
+            PROFILE_STOP(5);
+        }
+        assert(sum1 == sum2);
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+// Merge sort tree with fractional cascading
+//  - all levels are stored in one flat array, the node [nodeLeft, nodeRight] of a level keeps the sorted
+//    values of arr[nodeLeft..nodeRight] at value[level * N + nodeLeft .. level * N + nodeRight]
+//  - leftCount[] maps a position in a node to the positions in its children in O(1), so only the root
+//    needs a binary search and countLessThanOrEqual() is O(logN) instead of O((logN)^2)
+//  - same API as MergeSortTree
+// space : O(NlogN), about (sizeof(T) + 4) * N * (logN + 1) bytes without per-node vectors
+template <typename T>
+struct CascadingMergeSortTree {
+    int         N;          // the size of array
+    int         H;          // the number of levels
+    vector<T>   value;      // value[level * N + i]
+    vector<int> leftCount;  // leftCount[level * (N + 1) + i] = # of values in [0, i) of the level going to left children
+
+    CascadingMergeSortTree() : N(0), H(0) {
+    }
+
+    CascadingMergeSortTree(const T arr[], int n) {
+        build(arr, n);
+    }
+
+    explicit CascadingMergeSortTree(const vector<T>& v) {
+        build(v);
+    }
+
+
+    // O(NlogN)
+    void build(const T arr[], int n) {
+        N = n;
+        H = 1;
+        while ((1 << (H - 1)) < n)
+            H++;
+
+        value.resize(size_t(N) * H);
+        leftCount.assign(size_t(N + 1) * H, 0);
+
+        // the indexes of values go down with them to decide left or right
+        vector<int> index(n), next(n);
+        for (int i = 0; i < n; i++)
+            index[i] = i;
+        stable_sort(index.begin(), index.end(), [arr](int a, int b) { return arr[a] < arr[b]; });
+        for (int i = 0; i < n; i++)
+            value[i] = arr[index[i]];
+
+        for (int level = 0; level + 1 < H; level++) {
+            buildLevel(level, 0, 0, n - 1, index, next);
+            swap(index, next);
+        }
+    }
+
+    void build(const vector<T>& v) {
+        build(&v[0], int(v.size()));
+    }
+
+
+    // O(logN), inclusive (0 <= left <= right < N)
+    int countLessThanOrEqual(int left, int right, T val) const {
+        return countLessThanOrEqualSub(left, right, countLessThanOrEqual(val), 0, 0, N - 1);
+    }
+
+    // O(logN)
+    int countLessThanOrEqual(T val) const {
+        return int(upper_bound(value.begin(), value.begin() + N, val) - value.begin());
+    }
+
+    // count a value k, O(logN), inclusive (0 <= left <= right < N)
+    int count(int left, int right, T val) const {
+        return countLessThanOrEqual(left, right, val) - countLessThanOrEqual(left, right, val - 1);
+    }
+
+    // O(logN)
+    int count(T val) const {
+        return countLessThanOrEqual(val) - countLessThanOrEqual(val - 1);
+    }
+
+    // count a value k, O(logN), inclusive (0 <= left <= right < N)
+    int count(int left, int right, T valLow, T valHigh) const {
+        return countLessThanOrEqual(left, right, valHigh) - countLessThanOrEqual(left, right, valLow - 1);
+    }
+
+    // O(logN)
+    int count(T valLow, T valHigh) const {
+        return countLessThanOrEqual(valHigh) - countLessThanOrEqual(valLow - 1);
+    }
+
+    // O((logN)^2), inclusive (0 <= left <= right < N, 0 <= k <= right - left)
+    // binary search on the sorted values of the root, the result is the same lower bound in [valLow, valHigh + 1]
+    // as MergeSortTree::kth()
+    T kth(int left, int right, int k, T valLow, T valHigh) const {
+        int lo = 0, hi = N - 1;
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (countLessThanOrEqual(left, right, value[mid]) >= k + 1)
+                hi = mid - 1;
+            else
+                lo = mid + 1;
+        }
+
+        if (lo >= N || valHigh < value[lo])
+            return valHigh + 1;
+        return max(value[lo], valLow);
+    }
+
+    // O(1), inclusive (0 <= k < N)
+    T kth(int k) const {
+        return value[k];
+    }
+
+
+private:
+    // stable partition of the nodes in 'level' to their children in 'level + 1', inclusive
+    void buildLevel(int level, int depth, int nodeLeft, int nodeRight, const vector<int>& index, vector<int>& next) {
+        const T* curr = &value[size_t(level) * N];
+        T* down = &value[size_t(level + 1) * N];
+        int* lc = &leftCount[size_t(level) * (N + 1)];
+
+        if (nodeLeft == nodeRight) {
+            // leaves above the bottom level are copied down to keep the levels complete
+            down[nodeLeft] = curr[nodeLeft];
+            next[nodeLeft] = index[nodeLeft];
+            lc[nodeLeft + 1] = lc[nodeLeft];
+            return;
+        }
+
+        int mid = nodeLeft + (nodeRight - nodeLeft) / 2;
+        if (depth < level) {
+            buildLevel(level, depth + 1, nodeLeft, mid, index, next);
+            buildLevel(level, depth + 1, mid + 1, nodeRight, index, next);
+            return;
+        }
+
+        int L = nodeLeft, R = mid + 1;
+        for (int i = nodeLeft; i <= nodeRight; i++) {
+            bool toLeft = index[i] <= mid;
+            if (toLeft) {
+                down[L] = curr[i];
+                next[L++] = index[i];
+            } else {
+                down[R] = curr[i];
+                next[R++] = index[i];
+            }
+            lc[i + 1] = lc[i] + toLeft;
+        }
+    }
+
+    // cnt = # of values <= val in the node
+    int countLessThanOrEqualSub(int left, int right, int cnt, int level, int nodeLeft, int nodeRight) const {
+        if (cnt == 0 || right < nodeLeft || nodeRight < left)
+            return 0;
+
+        if (left <= nodeLeft && nodeRight <= right)
+            return cnt;
+
+        const int* lc = &leftCount[size_t(level) * (N + 1)];
+        int cntL = lc[nodeLeft + cnt] - lc[nodeLeft];
+
+        int mid = nodeLeft + (nodeRight - nodeLeft) / 2;
+        return countLessThanOrEqualSub(left, right, cntL, level + 1, nodeLeft, mid)
+             + countLessThanOrEqualSub(left, right, cnt - cntL, level + 1, mid + 1, nodeRight);
+    }
+};
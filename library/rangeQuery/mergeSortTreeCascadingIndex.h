@@ -0,0 +1,189 @@
+#pragma once
+
+// Merge sort tree of indexes with fractional cascading
+//  - the node [nodeLeft, nodeRight] of a level keeps the indexes of the values with ranks in [nodeLeft, nodeRight]
+//    in ascending order, the root is 0..N-1, so only leftCount[] is stored and no binary search is needed
+//  - kthIndex() and countLessThanOrEqual() go down one path in O(logN), like a wavelet matrix
+//  - same API as MergeSortTreeIndex
+// space : O(NlogN)
+template <typename T>
+struct CascadingMergeSortTreeIndex {
+    int         N;              // the size of array
+    int         H;              // the number of levels
+    vector<T>   values;         // 
+    vector<T>   sortedValues;   // sortedValues[rank]
+    vector<int> order;          // order[rank] = index
+    vector<int> leftCount;      // leftCount[level * (N + 1) + i] = # of indexes in [0, i) of the level going to left children
+
+    CascadingMergeSortTreeIndex() : N(0), H(0) {
+    }
+
+    CascadingMergeSortTreeIndex(const T arr[], int n) {
+        build(arr, n);
+    }
+
+    explicit CascadingMergeSortTreeIndex(const vector<T>& v) {
+        build(v);
+    }
+
+
+    // O(NlogN)
+    void build(const T arr[], int n) {
+        N = n;
+        H = 1;
+        while ((1 << (H - 1)) < n)
+            H++;
+
+        values.assign(arr, arr + n);
+
+        order.resize(n);
+        for (int i = 0; i < n; i++)
+            order[i] = i;
+        stable_sort(order.begin(), order.end(), [arr](int a, int b) { return arr[a] < arr[b]; });
+
+        sortedValues.resize(n);
+        for (int i = 0; i < n; i++)
+            sortedValues[i] = arr[order[i]];
+
+        // the ranks go down with the indexes to decide left or right
+        vector<int> rank(n), next(n);
+        for (int i = 0; i < n; i++)
+            rank[order[i]] = i;
+
+        leftCount.assign(size_t(N + 1) * H, 0);
+        for (int level = 0; level + 1 < H; level++) {
+            buildLevel(level, 0, 0, n - 1, rank, next);
+            swap(rank, next);
+        }
+    }
+
+    void build(const vector<T>& v) {
+        build(&v[0], int(v.size()));
+    }
+
+
+    // O(logN), inclusive (0 <= left <= right < N)
+    int countLessThanOrEqual(int left, int right, T val) const {
+        int r = int(upper_bound(sortedValues.begin(), sortedValues.end(), val) - sortedValues.begin());
+
+        int res = 0;
+        int posL = left, posR = right + 1;      // [posL, posR) in the node
+        int nodeLeft = 0, nodeRight = N - 1;
+        for (int level = 0; posL < posR && nodeLeft < r; level++) {
+            if (nodeRight < r) {
+                res += posR - posL;
+                break;
+            }
+
+            const int* lc = &leftCount[size_t(level) * (N + 1)];
+            int leftL = lc[nodeLeft + posL] - lc[nodeLeft];
+            int leftR = lc[nodeLeft + posR] - lc[nodeLeft];
+
+            int mid = nodeLeft + (nodeRight - nodeLeft) / 2;
+            if (mid < r) {
+                res += leftR - leftL;
+                posL -= leftL;
+                posR -= leftR;
+                nodeLeft = mid + 1;
+            } else {
+                posL = leftL;
+                posR = leftR;
+                nodeRight = mid;
+            }
+        }
+        return res;
+    }
+
+    // O(logN)
+    int countLessThanOrEqual(T val) const {
+        return int(upper_bound(sortedValues.begin(), sortedValues.end(), val) - sortedValues.begin());
+    }
+
+    // count a value k, O(logN), inclusive (0 <= left <= right < N)
+    int count(int left, int right, T val) const {
+        return countLessThanOrEqual(left, right, val) - countLessThanOrEqual(left, right, val - 1);
+    }
+
+    int count(T val) const {
+        return countLessThanOrEqual(val) - countLessThanOrEqual(val - 1);
+    }
+
+    // count a value k, O(logN), inclusive (0 <= left <= right < N)
+    int count(int left, int right, T valLow, T valHigh) const {
+        return countLessThanOrEqual(left, right, valHigh) - countLessThanOrEqual(left, right, valLow - 1);
+    }
+
+    int count(T valLow, T valHigh) const {
+        return countLessThanOrEqual(valHigh) - countLessThanOrEqual(valLow - 1);
+    }
+
+
+    // O(logN), inclusive (0 <= left <= right < N, 0 <= k <= right - left)
+    int kthIndex(int left, int right, int k) const {
+        int posL = left, posR = right + 1;      // [posL, posR) in the node
+        int nodeLeft = 0, nodeRight = N - 1;
+        for (int level = 0; nodeLeft < nodeRight; level++) {
+            const int* lc = &leftCount[size_t(level) * (N + 1)];
+            int leftL = lc[nodeLeft + posL] - lc[nodeLeft];
+            int leftR = lc[nodeLeft + posR] - lc[nodeLeft];
+
+            int mid = nodeLeft + (nodeRight - nodeLeft) / 2;
+            if (k < leftR - leftL) {
+                posL = leftL;
+                posR = leftR;
+                nodeRight = mid;
+            } else {
+                k -= leftR - leftL;
+                posL -= leftL;
+                posR -= leftR;
+                nodeLeft = mid + 1;
+            }
+        }
+        return order[nodeLeft];
+    }
+
+    // O(1), inclusive (0 <= k < N)
+    int kthIndex(int k) const {
+        return order[k];
+    }
+
+    // O(logN), inclusive (0 <= left <= right < N, 0 <= k <= right - left)
+    T kth(int left, int right, int k) const {
+        return values[kthIndex(left, right, k)];
+    }
+
+    // O(1), inclusive (0 <= k < N)
+    T kth(int k) const {
+        return sortedValues[k];
+    }
+
+
+private:
+    // stable partition of the nodes in 'level' to their children in 'level + 1', inclusive
+    void buildLevel(int level, int depth, int nodeLeft, int nodeRight, const vector<int>& rank, vector<int>& next) {
+        int* lc = &leftCount[size_t(level) * (N + 1)];
+
+        if (nodeLeft == nodeRight) {
+            next[nodeLeft] = rank[nodeLeft];
+            lc[nodeLeft + 1] = lc[nodeLeft];
+            return;
+        }
+
+        int mid = nodeLeft + (nodeRight - nodeLeft) / 2;
+        if (depth < level) {
+            buildLevel(level, depth + 1, nodeLeft, mid, rank, next);
+            buildLevel(level, depth + 1, mid + 1, nodeRight, rank, next);
+            return;
+        }
+
+        int L = nodeLeft, R = mid + 1;
+        for (int i = nodeLeft; i <= nodeRight; i++) {
+            bool toLeft = rank[i] <= mid;
+            if (toLeft)
+                next[L++] = rank[i];
+            else
+                next[R++] = rank[i];
+            lc[i + 1] = lc[i] + toLeft;
+        }
+    }
+};
@@ -0,0 +1,181 @@
+#pragma once
+
+// Merge sort tree with sums and fractional cascading
+//  - the flat layout of CascadingMergeSortTree, and sum[] keeps prefix sums of each level
+//  - same API as MergeSortTreeWithSum, countLessThanOrEqual() is O(logN)
+// space : O(NlogN)
+template <typename T, typename SumT = T>
+struct CascadingMergeSortTreeWithSum {
+    int             N;          // the size of array
+    int             H;          // the number of levels
+    vector<T>       value;      // value[level * N + i]
+    vector<int>     leftCount;  // leftCount[level * (N + 1) + i] = # of values in [0, i) of the level going to left children
+    vector<SumT>    sum;        // sum[level * (N + 1) + i] = sum of values in [0, i) of the level
+
+    CascadingMergeSortTreeWithSum() : N(0), H(0) {
+    }
+
+    CascadingMergeSortTreeWithSum(const T arr[], int n) {
+        build(arr, n);
+    }
+
+    explicit CascadingMergeSortTreeWithSum(const vector<T>& v) {
+        build(v);
+    }
+
+
+    // O(NlogN)
+    void build(const T arr[], int n) {
+        N = n;
+        H = 1;
+        while ((1 << (H - 1)) < n)
+            H++;
+
+        value.resize(size_t(N) * H);
+        leftCount.assign(size_t(N + 1) * H, 0);
+        sum.resize(size_t(N + 1) * H);
+
+        vector<int> index(n), next(n);
+        for (int i = 0; i < n; i++)
+            index[i] = i;
+        stable_sort(index.begin(), index.end(), [arr](int a, int b) { return arr[a] < arr[b]; });
+        for (int i = 0; i < n; i++)
+            value[i] = arr[index[i]];
+
+        for (int level = 0; level + 1 < H; level++) {
+            buildLevel(level, 0, 0, n - 1, index, next);
+            swap(index, next);
+        }
+
+        for (int level = 0; level < H; level++) {
+            const T* v = &value[size_t(level) * N];
+            SumT* s = &sum[size_t(level) * (N + 1)];
+            s[0] = SumT(0);
+            for (int i = 0; i < n; i++)
+                s[i + 1] = s[i] + v[i];
+        }
+    }
+
+    void build(const vector<T>& v) {
+        build(&v[0], int(v.size()));
+    }
+
+
+    // O(logN), inclusive (0 <= left <= right < N)
+    pair<int, SumT> countLessThanOrEqual(int left, int right, T val) const {
+        int cnt = int(upper_bound(value.begin(), value.begin() + N, val) - value.begin());
+        return countLessThanOrEqualSub(left, right, cnt, 0, 0, N - 1);
+    }
+
+    // O(logN)
+    pair<int, SumT> countLessThanOrEqual(T val) const {
+        int cnt = int(upper_bound(value.begin(), value.begin() + N, val) - value.begin());
+        return make_pair(cnt, sum[cnt]);
+    }
+
+    // count a value k, O(logN), inclusive (0 <= left <= right < N)
+    pair<int, SumT> count(int left, int right, T val) const {
+        auto r = countLessThanOrEqual(left, right, val);
+        auto l = countLessThanOrEqual(left, right, val - 1);
+        return make_pair(r.first - l.first, r.second - l.second);
+    }
+
+    // O(logN)
+    pair<int, SumT> count(T val) const {
+        auto r = countLessThanOrEqual(val);
+        auto l = countLessThanOrEqual(val - 1);
+        return make_pair(r.first - l.first, r.second - l.second);
+    }
+
+    // count a value k, O(logN), inclusive (0 <= left <= right < N)
+    pair<int, SumT> count(int left, int right, T valLow, T valHigh) const {
+        auto r = countLessThanOrEqual(left, right, valHigh);
+        auto l = countLessThanOrEqual(left, right, valLow - 1);
+        return make_pair(r.first - l.first, r.second - l.second);
+    }
+
+    // O(logN)
+    pair<int, SumT> count(T valLow, T valHigh) const {
+        auto r = countLessThanOrEqual(valHigh);
+        auto l = countLessThanOrEqual(valLow - 1);
+        return make_pair(r.first - l.first, r.second - l.second);
+    }
+
+    // O((logN)^2), inclusive (0 <= left <= right < N, 0 <= k <= right - left)
+    // binary search on the sorted values of the root, the result is the same lower bound in [valLow, valHigh + 1]
+    // as MergeSortTreeWithSum::kth()
+    T kth(int left, int right, int k, T valLow, T valHigh) const {
+        int lo = 0, hi = N - 1;
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (countLessThanOrEqual(left, right, value[mid]).first >= k + 1)
+                hi = mid - 1;
+            else
+                lo = mid + 1;
+        }
+
+        if (lo >= N || valHigh < value[lo])
+            return valHigh + 1;
+        return max(value[lo], valLow);
+    }
+
+    // O(1), inclusive (0 <= k < N)
+    T kth(int k) const {
+        return value[k];
+    }
+
+
+private:
+    // stable partition of the nodes in 'level' to their children in 'level + 1', inclusive
+    void buildLevel(int level, int depth, int nodeLeft, int nodeRight, const vector<int>& index, vector<int>& next) {
+        const T* curr = &value[size_t(level) * N];
+        T* down = &value[size_t(level + 1) * N];
+        int* lc = &leftCount[size_t(level) * (N + 1)];
+
+        if (nodeLeft == nodeRight) {
+            down[nodeLeft] = curr[nodeLeft];
+            next[nodeLeft] = index[nodeLeft];
+            lc[nodeLeft + 1] = lc[nodeLeft];
+            return;
+        }
+
+        int mid = nodeLeft + (nodeRight - nodeLeft) / 2;
+        if (depth < level) {
+            buildLevel(level, depth + 1, nodeLeft, mid, index, next);
+            buildLevel(level, depth + 1, mid + 1, nodeRight, index, next);
+            return;
+        }
+
+        int L = nodeLeft, R = mid + 1;
+        for (int i = nodeLeft; i <= nodeRight; i++) {
+            bool toLeft = index[i] <= mid;
+            if (toLeft) {
+                down[L] = curr[i];
+                next[L++] = index[i];
+            } else {
+                down[R] = curr[i];
+                next[R++] = index[i];
+            }
+            lc[i + 1] = lc[i] + toLeft;
+        }
+    }
+
+    // cnt = # of values <= val in the node
+    pair<int, SumT> countLessThanOrEqualSub(int left, int right, int cnt, int level, int nodeLeft, int nodeRight) const {
+        if (cnt == 0 || right < nodeLeft || nodeRight < left)
+            return make_pair(0, SumT(0));
+
+        if (left <= nodeLeft && nodeRight <= right) {
+            const SumT* s = &sum[size_t(level) * (N + 1)];
+            return make_pair(cnt, s[nodeLeft + cnt] - s[nodeLeft]);
+        }
+
+        const int* lc = &leftCount[size_t(level) * (N + 1)];
+        int cntL = lc[nodeLeft + cnt] - lc[nodeLeft];
+
+        int mid = nodeLeft + (nodeRight - nodeLeft) / 2;
+        auto l = countLessThanOrEqualSub(left, right, cntL, level + 1, nodeLeft, mid);
+        auto r = countLessThanOrEqualSub(left, right, cnt - cntL, level + 1, mid + 1, nodeRight);
+        return make_pair(l.first + r.first, l.second + r.second);
+    }
+};
@@ -0,0 +1,184 @@
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+#include "monoid.h"
+#include "segmentTree.h"
+#include "segmentTreeLazy.h"
+#include "segmentTreeCompact.h"
+#include "sparseTable.h"
+#include "sqrtTree.h"
+#include "dynamicSegmentTree.h"
+#include "intTrie.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+void testMonoid() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Monoid Policies ---------------------------" << endl;
+    {
+        assert((MonoidIdentity<MinOp<int>, int>::get()) == numeric_limits<int>::max());
+        assert((MonoidIdentity<MaxOp<int>, int>::get()) == numeric_limits<int>::min());
+        assert((MonoidIdentity<LcmOp<int>, int>::get()) == 1);
+        assert(GcdOp<int>()(12, 18) == 6 && GcdOp<int>()(0, 7) == 7);
+        assert(LcmOp<int>()(4, 6) == 12 && LcmOp<int>()(0, 5) == 0);
+        assert((MonoidIdentity<function<int(int, int)>, int>::get()) == 0);
+    }
+    {
+        int N = 1000;
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get() % 1000000;
+
+        SegmentTree<int, MinOp<int>> segMin(in);
+        SegmentTree<int, SumOp<int>> segSum(in);
+        CompactSegmentTree<int, MaxOp<int>> compMax(in);
+        SparseTable<int, GcdOp<int>> sparseGcd(in);
+        SqrtTree<int, XorOp<int>> sqrtXor(in);
+        SegmentTreeLazy<int, SumOp<int>, SumBlockOp<int>> lazySum(in);
+        SegmentTreeLazy<int, MinOp<int>, IdempotentBlockOp<int>> lazyMin(in);
+        DynamicSegmentTreeLazy<int, SumOp<int>, SumBlockOp<int>> dynSum(0, N - 1);
+
+        vector<int> v = in;
+        for (int i = 0; i < N; i++)
+            dynSum.update(i, i, v[i]);
+
+        for (int t = 0; t < 1000; t++) {
+            int L = RandInt32::get() % N;
+            int R = RandInt32::get() % N;
+            if (L > R)
+                swap(L, R);
+
+            int gtMin = numeric_limits<int>::max(), gtMax = numeric_limits<int>::min();
+            int gtSum = 0, gtGcd = 0, gtXor = 0;
+            for (int i = L; i <= R; i++) {
+                gtMin = min(gtMin, v[i]);
+                gtSum += v[i];
+            }
+            for (int i = L; i <= R; i++) {
+                gtMax = max(gtMax, in[i]);
+                gtGcd = GcdOp<int>()(gtGcd, in[i]);
+                gtXor ^= in[i];
+            }
+            assert(compMax.query(L, R) == gtMax);
+            assert(sparseGcd.query(L, R) == gtGcd);
+            assert(sqrtXor.query(L, R) == gtXor);
+            assert(lazySum.query(L, R) == gtSum);
+            assert(lazyMin.query(L, R) == gtMin);
+            assert(dynSum.query(L, R) == gtSum);
+
+            // range assignment
+            int x = RandInt32::get() % 1000;
+            lazySum.updateRange(L, R, x);
+            lazyMin.updateRange(L, R, x);
+            dynSum.update(L, R, x);
+            for (int i = L; i <= R; i++)
+                v[i] = x;
+        }
+        for (int t = 0; t < 1000; t++) {
+            int L = RandInt32::get() % N;
+            int R = RandInt32::get() % N;
+            if (L > R)
+                swap(L, R);
+            int gtMin = numeric_limits<int>::max(), gtSum = 0;
+            for (int i = L; i <= R; i++) {
+                gtMin = min(gtMin, in[i]);
+                gtSum += in[i];
+            }
+            assert(segMin.query(L, R) == gtMin);
+            assert(segSum.query(L, R) == gtSum);
+        }
+
+        vector<int> keys = in;
+        sort(keys.begin(), keys.end());
+        keys.erase(unique(keys.begin(), keys.end()), keys.end());
+        IntTrie<int, int, IdentityOp<int>, FirstOp<int>> trie(20);
+        int root = trie.build(keys);
+        for (int i = 0; i < N; i++)
+            assert(trie.exist(root, in[i]));
+    }
+    {
+        cout << "*** Speed test : policy vs. std::function ***" << endl;
+
+        int N = 1000000;
+        int Q = 1000000;
+#ifdef _DEBUG
+        N = 10000;
+        Q = 100000;
+#endif
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get() % 1000000;
+
+        vector<pair<int, int>> qry(Q);
+        for (int i = 0; i < Q; i++) {
+            int L = RandInt32::get() % N;
+            int R = RandInt32::get() % N;
+            if (L > R)
+                swap(L, R);
+            qry[i] = make_pair(L, R);
+        }
+
+        auto benchmark = [&](const char* name, auto& tree) {
+            cout << "  " << name << " : ";
+            long long sum = 0;
+            PROFILE_START(0);
+            for (auto& it : qry)
+                sum += tree.query(it.first, it.second);
+            PROFILE_STOP(0);
+            return sum;
+        };
+
+        cout << "N = " << N << ", Q = " << Q << endl;
+        {
+            SegmentTree<int> tree1(in, [](int a, int b) { return min(a, b); }, numeric_limits<int>::max());
+            SegmentTree<int, MinOp<int>> tree2(in);
+            long long ans1 = benchmark("SegmentTree (min, std::function)", tree1);
+            long long ans2 = benchmark("SegmentTree (min, MinOp)", tree2);
+            assert(ans1 == ans2);
+        }
+        {
+            CompactSegmentTree<int> tree1(in, [](int a, int b) { return a + b; });
+            CompactSegmentTree<int, SumOp<int>> tree2(in);
+            long long ans1 = benchmark("CompactSegmentTree (sum, std::function)", tree1);
+            long long ans2 = benchmark("CompactSegmentTree (sum, SumOp)", tree2);
+            assert(ans1 == ans2);
+        }
+        {
+            SparseTable<int> tree1(in, [](int a, int b) { return min(a, b); }, numeric_limits<int>::max());
+            SparseTable<int, MinOp<int>> tree2(in);
+            long long ans1 = benchmark("SparseTable (min, std::function)", tree1);
+            long long ans2 = benchmark("SparseTable (min, MinOp)", tree2);
+            assert(ans1 == ans2);
+        }
+        {
+            SqrtTree<int> tree1(in, [](int a, int b) { return a + b; });
+            SqrtTree<int, SumOp<int>> tree2(in);
+            long long ans1 = benchmark("SqrtTree (sum, std::function)", tree1);
+            long long ans2 = benchmark("SqrtTree (sum, SumOp)", tree2);
+            assert(ans1 == ans2);
+        }
+        {
+            SegmentTreeLazy<int> tree1(in, [](int a, int b) { return a + b; }, [](int x, int n) { return x * n; });
+            SegmentTreeLazy<int, SumOp<int>, SumBlockOp<int>> tree2(in);
+            long long ans1 = benchmark("SegmentTreeLazy (sum, std::function)", tree1);
+            long long ans2 = benchmark("SegmentTreeLazy (sum, SumOp)", tree2);
+            assert(ans1 == ans2);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <limits>
+#include <type_traits>
+
+// Monoid policies for the segment-tree family
+//  - passing one of these as 'MergeOp' instead of the default std::function lets the compiler
+//    inline every merge, and 'identity()' is used when the default value is omitted
+//      ex) SegmentTree<int, MinOp<int>> tree(v);
+//  - any callable still works, and without 'identity()' the default value falls back to T()
+
+//--------- Monoids -----------------------------------------------------------
+
+template <typename T>
+struct MaxOp {
+    T operator()(T a, T b) const {
+        return max(a, b);
+    }
+
+    static T identity() {
+        return numeric_limits<T>::lowest();
+    }
+};
+
+template <typename T>
+struct MinOp {
+    T operator()(T a, T b) const {
+        return min(a, b);
+    }
+
+    static T identity() {
+        return numeric_limits<T>::max();
+    }
+};
+
+template <typename T>
+struct SumOp {
+    T operator()(T a, T b) const {
+        return a + b;
+    }
+
+    static T identity() {
+        return T(0);
+    }
+};
+
+// for non-negative values
+template <typename T>
+struct GcdOp {
+    T operator()(T a, T b) const {
+        while (b != 0) {
+            T t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    static T identity() {
+        return T(0);
+    }
+};
+
+// for non-negative values
+template <typename T>
+struct LcmOp {
+    T operator()(T a, T b) const {
+        if (a == 0 || b == 0)
+            return T(0);
+        return a / GcdOp<T>()(a, b) * b;
+    }
+
+    static T identity() {
+        return T(1);
+    }
+};
+
+template <typename T>
+struct XorOp {
+    T operator()(T a, T b) const {
+        return a ^ b;
+    }
+
+    static T identity() {
+        return T(0);
+    }
+};
+
+// MonoidIdentity<MergeOp, T>::get() = MergeOp::identity() if it exists, otherwise T()
+template <typename MergeOp, typename T, typename = void>
+struct MonoidIdentity {
+    static T get() {
+        return T();
+    }
+};
+
+template <typename MergeOp, typename T>
+struct MonoidIdentity<MergeOp, T, decltype((void)MergeOp::identity(), void())> {
+    static T get() {
+        return T(MergeOp::identity());
+    }
+};
+
+//--------- Block operations (for range assignment of lazy trees) -------------
+// blockOp(value, count) = merge of 'count' copies of 'value'
+// A pending assignment is simply overwritten by a newer one, so no separate composition is needed.
+
+// for SumOp
+template <typename T>
+struct SumBlockOp {
+    T operator()(T value, int count) const {
+        return value * count;
+    }
+};
+
+// for idempotent monoids (MaxOp, MinOp, GcdOp, LcmOp, ...)
+template <typename T>
+struct IdempotentBlockOp {
+    T operator()(T value, int /*count*/) const {
+        return value;
+    }
+};
+
+// for XorOp
+template <typename T>
+struct XorBlockOp {
+    T operator()(T value, int count) const {
+        return (count & 1) ? value : T(0);
+    }
+};
+
+//--------- Other policies ----------------------------------------------------
+
+// key of IntTrie
+template <typename T>
+struct IdentityOp {
+    T operator()(T x) const {
+        return x;
+    }
+};
+
+// keeps the existing value of IntTrie
+template <typename T>
+struct FirstOp {
+    T operator()(T a, T b) const {
+        return a;
+    }
+};
@@ -0,0 +1,100 @@
+#include <vector>
+#include <limits>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+#include "../common/parallelFor.h"
+#include "sparseTable.h"
+#include "sqrtTree.h"
+#include "mergeSortTree.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+void testParallelFor() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Parallel Build ------------------------------------" << endl;
+    {
+        for (int n = 0; n < 100; n++) {
+            for (int threadCount = 1; threadCount <= 5; threadCount++) {
+                vector<int> cnt(n);
+                parallelFor(n, threadCount, [&cnt](int first, int last) {
+                    for (int i = first; i < last; i++)
+                        cnt[i]++;
+                });
+                assert(count(cnt.begin(), cnt.end(), 1) == n);
+            }
+        }
+    }
+    {
+        for (int N : { 1, 2, 3, 17, 100, 1000, 12345 }) {
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = RandInt32::get() % 1000000;
+
+            for (int threadCount = 2; threadCount <= 5; threadCount++) {
+                SparseTable<int, MinOp<int>> st1(in), st2(MinOp<int>{});
+                st2.build(in, threadCount);
+                assert(st1.value == st2.value);
+
+                SqrtTree<int, SumOp<int>> sq1(in), sq2(SumOp<int>{});
+                sq2.build(in, threadCount);
+                assert(sq1.prefix == sq2.prefix && sq1.suffix == sq2.suffix && sq1.between == sq2.between);
+
+                MergeSortTree<int> ms1(in), ms2;
+                ms2.build(in, threadCount);
+                assert(ms1.tree == ms2.tree);
+            }
+        }
+    }
+    {
+        cout << "*** Speed test : build time ***" << endl;
+
+        int N = 1 << 22;
+#ifdef _DEBUG
+        N = 1 << 16;
+#endif
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get();
+
+        int maxThreads = max(4, int(thread::hardware_concurrency()));
+        cout << "N = " << N << ", hardware threads = " << thread::hardware_concurrency() << endl;
+        for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+            cout << "  threads = " << threadCount << endl;
+            {
+                SparseTable<int, MinOp<int>> tree(MinOp<int>{});
+                cout << "    SparseTable : ";
+                PROFILE_HI_START(0);
+                tree.build(in, threadCount);
+                PROFILE_HI_STOP(0);
+            }
+            {
+                SqrtTree<int, MinOp<int>> tree(MinOp<int>{});
+                cout << "    SqrtTree : ";
+                PROFILE_HI_START(1);
+                tree.build(in, threadCount);
+                PROFILE_HI_STOP(1);
+            }
+            {
+                MergeSortTree<int> tree;
+                cout << "    MergeSortTree : ";
+                PROFILE_HI_START(2);
+                tree.build(in, threadCount);
+                PROFILE_HI_STOP(2);
+            }
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -3,42 +3,7 @@
 #include <vector>
 #include <functional>
 
-//--------- Operations --------------------------------------------------------
-
-template <typename T>
-struct MaxOp {
-    T operator()(T a, T b) const {
-        return max(a, b);
-    }
-};
-
-template <typename T>
-struct MinOp {
-    T operator()(T a, T b) const {
-        return min(a, b);
-    }
-};
-
-template <typename T>
-struct SumOp {
-    T operator()(T a, T b) const {
-        return a + b;
-    }
-};
-
-template <typename T>
-struct GcdOp {
-    T operator()(T a, T b) const {
-        return gcd(a, b);
-    }
-};
-
-template <typename T>
-struct LcmOp {
-    T operator()(T a, T b) const {
-        return lcm(a, b);
-    }
-};
+#include "monoid.h"
 
 //--------- General Segment Tree ----------------------------------------------
 
@@ -52,25 +17,25 @@ struct SegmentTree {
     MergeOp   mergeOp;
     T         defaultValue;
 
-    explicit SegmentTree(MergeOp op, T dflt = T())
+    explicit SegmentTree(MergeOp op, T dflt = MonoidIdentity<MergeOp, T>::get())
         : N(0), tree(), mergeOp(op), defaultValue(dflt) {
     }
 
-    SegmentTree(int size, MergeOp op, T dflt = T())
+    SegmentTree(int size, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : N(size), tree(size * 4, dflt), mergeOp(op), defaultValue(dflt) {
     }
 
-    SegmentTree(T value, int n, MergeOp op, T dflt = T())
+    SegmentTree(T value, int n, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dflt) {
         build(value, n);
     }
 
-    SegmentTree(const T arr[], int n, MergeOp op, T dflt = T())
+    SegmentTree(const T arr[], int n, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dflt) {
         build(arr, n);
     }
 
-    SegmentTree(const vector<T>& v, MergeOp op, T dflt = T())
+    SegmentTree(const vector<T>& v, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dflt) {
         build(v);
     }
@@ -207,17 +172,17 @@ private:
 };
 
 template <typename T, typename MergeOp>
-inline SegmentTree<T, MergeOp> makeSegmentTree(int size, MergeOp op, T dfltValue = T()) {
+inline SegmentTree<T, MergeOp> makeSegmentTree(int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SegmentTree<T, MergeOp>(size, op, dfltValue);
 }
 
 template <typename T, typename MergeOp>
-inline SegmentTree<T, MergeOp> makeSegmentTree(const T arr[], int size, MergeOp op, T dfltValue = T()) {
+inline SegmentTree<T, MergeOp> makeSegmentTree(const T arr[], int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SegmentTree<T, MergeOp>(arr, size, op, dfltValue);
 }
 
 template <typename T, typename MergeOp>
-inline SegmentTree<T, MergeOp> makeSegmentTree(const vector<T>& v, MergeOp op, T dfltValue = T()) {
+inline SegmentTree<T, MergeOp> makeSegmentTree(const vector<T>& v, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SegmentTree<T, MergeOp>(v, op, dfltValue);
 }
 
@@ -0,0 +1,145 @@
+#include <vector>
+#include <limits>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+#include "segmentTreeBlocked.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iomanip>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+#include "segmentTreeCompact.h"
+#include "sparseTable.h"
+#include "sparseTableBlocked.h"
+
+// nanoseconds per query
+template <typename Tree>
+static double benchmarkQuery(const Tree& tree, const vector<pair<int, int>>& qry, long long& checksum) {
+    AccumulateTimer timer;
+    timer.start();
+    for (auto& it : qry)
+        checksum += tree.query(it.first, it.second);
+    timer.stop();
+    return double(timer.getNanosec()) / qry.size();
+}
+
+void testSegmentTreeBlocked() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Blocked Segment Tree -----------------------------" << endl;
+    {
+        for (int N = 1; N <= 1000; N += (N < 40) ? 1 : 97) {
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = RandInt32::get() % 1000;
+
+            BlockedSegmentTree<int, MinOp<int>> treeMin(in);
+            BlockedSegmentTree<int, SumOp<int>> treeSum(in);
+            // non-commutative : polynomial hash (hash, base^length)
+            typedef pair<long long, long long> HashT;
+            const long long MOD = 1000000007;
+            BlockedSegmentTree<HashT> treeHash(vector<HashT>(N, HashT(1, 7)), [MOD](const HashT& a, const HashT& b) {
+                return HashT((a.first * b.second + b.first) % MOD, a.second * b.second % MOD);
+            }, HashT(0, 1));
+
+            for (int t = 0; t < 300; t++) {
+                int L = RandInt32::get() % N;
+                int R = RandInt32::get() % N;
+                if (L > R)
+                    swap(L, R);
+
+                int gtMin = numeric_limits<int>::max(), gtSum = 0;
+                long long gtHash = 0;
+                for (int i = L; i <= R; i++) {
+                    gtMin = min(gtMin, in[i]);
+                    gtSum += in[i];
+                    gtHash = (gtHash * 7 + treeHash.query(i).first) % MOD;
+                }
+                assert(treeMin.query(L, R) == gtMin);
+                assert(treeSum.query(L, R) == gtSum);
+                assert(treeHash.query(L, R).first == gtHash);
+
+                int index = RandInt32::get() % N;
+                int value = RandInt32::get() % 1000;
+                in[index] = value;
+                treeMin.update(index, value);
+                treeSum.update(index, value);
+                treeHash.update(index, HashT(value, 7));
+            }
+        }
+    }
+    {
+        cout << "*** Speed test : range minimum query, N from L1 to DRAM size ***" << endl;
+
+        int maxLog = 26;
+        int maxSparseTableLog = 22;     // N * log(N) values
+        int Q = 1000000;
+#ifdef _DEBUG
+        maxLog = 20;
+        maxSparseTableLog = 18;
+        Q = 100000;
+#endif
+        cout << setw(10) << "N" << setw(10) << "memory"
+             << setw(12) << "Compact" << setw(12) << "Blocked"
+             << setw(12) << "Sparse" << setw(12) << "BlockedST" << "  (ns/query)" << endl;
+
+        for (int logN = 10; logN <= maxLog; logN += 2) {
+            int N = 1 << logN;
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = RandInt32::get();
+
+            vector<pair<int, int>> qry(Q);
+            for (int i = 0; i < Q; i++) {
+                int L = RandInt32::get() % N;
+                int R = RandInt32::get() % N;
+                if (L > R)
+                    swap(L, R);
+                qry[i] = make_pair(L, R);
+            }
+
+            long long checksum[4] = { 0, 0, 0, 0 };
+            double ns[4] = { 0, 0, 0, 0 };
+            {
+                CompactSegmentTree<int, MinOp<int>> tree(in);
+                ns[0] = benchmarkQuery(tree, qry, checksum[0]);
+            }
+            {
+                BlockedSegmentTree<int, MinOp<int>> tree(in);
+                ns[1] = benchmarkQuery(tree, qry, checksum[1]);
+            }
+            if (logN <= maxSparseTableLog) {
+                SparseTable<int, MinOp<int>> tree(in);
+                ns[2] = benchmarkQuery(tree, qry, checksum[2]);
+            } else {
+                checksum[2] = checksum[0];
+            }
+            {
+                BlockedSparseTable<int, MinOp<int>> tree(in);
+                ns[3] = benchmarkQuery(tree, qry, checksum[3]);
+            }
+            assert(checksum[0] == checksum[1] && checksum[0] == checksum[2] && checksum[0] == checksum[3]);
+
+            cout << setw(10) << N << setw(8) << (N * sizeof(int) >> 10) << "KB" << fixed << setprecision(1);
+            for (int i = 0; i < 4; i++) {
+                if (ns[i] > 0)
+                    cout << setw(12) << ns[i];
+                else
+                    cout << setw(12) << "-";
+            }
+            cout << endl;
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "monoid.h"
+
+//--------- Blocked Segment Tree ----------------------------------------------
+// B-ary bottom-up segment tree
+//  - the children of a node are SEGMENT_TREE_BLOCK_SIZE consecutive values (a cache line for 32-bit T),
+//    and there are only log_B(N) levels
+//  - prefix[]/suffix[] keep in-block prefix/suffix merges, so a query reads at most 2 values per level
+//  - every level is stored contiguously in one array, and padded to a multiple of the block size
+//  - same query API as CompactSegmentTree, but update() is O(B * log_B(N)) and the memory is about 3N
+
+#ifndef SEGMENT_TREE_BLOCK_SIZE
+#define SEGMENT_TREE_BLOCK_SIZE     16      // must be a power of 2
+#endif
+
+template <typename T, typename MergeOp = function<T(T, T)>>
+struct BlockedSegmentTree {
+    static const int B = SEGMENT_TREE_BLOCK_SIZE;
+
+    int         N;              // the size of array
+    vector<T>   tree;           // all levels, the leaves first
+    vector<T>   prefix;         // prefix[i] = tree[i & ~(B - 1)] + ... + tree[i]
+    vector<T>   suffix;         // suffix[i] = tree[i] + ... + tree[i | (B - 1)]
+    vector<int> levelOffset;    // the start of each level in 'tree'
+
+    MergeOp     mergeOp;
+    T           defaultValue;
+
+    explicit BlockedSegmentTree(MergeOp op, T dflt = MonoidIdentity<MergeOp, T>::get())
+        : N(0), tree(), mergeOp(op), defaultValue(dflt) {
+    }
+
+    BlockedSegmentTree(int size, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
+        : mergeOp(op), defaultValue(dflt) {
+        init(size);
+    }
+
+    BlockedSegmentTree(T value, int n, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
+        : mergeOp(op), defaultValue(dflt) {
+        build(value, n);
+    }
+
+    BlockedSegmentTree(const T arr[], int n, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
+        : mergeOp(op), defaultValue(dflt) {
+        build(arr, n);
+    }
+
+    BlockedSegmentTree(const vector<T>& v, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
+        : mergeOp(op), defaultValue(dflt) {
+        build(v);
+    }
+
+
+    void init(int size) {
+        N = size;
+
+        levelOffset.clear();
+        int total = 0;
+        int count = size;
+        while (true) {
+            levelOffset.push_back(total);
+            total += (count + B - 1) & ~(B - 1);
+            if (count <= B)
+                break;
+            count = (count + B - 1) / B;
+        }
+        levelOffset.push_back(total);
+
+        tree.assign(total, defaultValue);
+        prefix.assign(total, defaultValue);
+        suffix.assign(total, defaultValue);
+    }
+
+    void build(T value, int size) {
+        init(size);
+        for (int i = 0; i < size; i++)
+            tree[i] = value;
+        buildUpper();
+    }
+
+    void build(const T arr[], int size) {
+        init(size);
+        for (int i = 0; i < size; i++)
+            tree[i] = arr[i];
+        buildUpper();
+    }
+
+    void build(const vector<T>& v) {
+        build(&v[0], int(v.size()));
+    }
+
+    //--- query
+
+    T query(int index) const {
+        return tree[index];
+    }
+
+    // inclusive
+    T query(int left, int right) const {
+        T resL = defaultValue;
+        T resR = defaultValue;
+
+        int topLevel = int(levelOffset.size()) - 2;
+        for (int level = 0; left <= right; level++) {
+            int offset = levelOffset[level];
+            int blockL = left / B;
+            int blockR = right / B;
+            bool fullL = (left & (B - 1)) == 0;
+            bool fullR = (right & (B - 1)) == B - 1;
+            if (blockL == blockR) {
+                // a whole block is left to the upper level
+                if (fullL && fullR && level < topLevel) {
+                    left = right = blockL;
+                    continue;
+                }
+                if (fullL)
+                    resL = mergeOp(resL, prefix[offset + right]);
+                else if (fullR)
+                    resL = mergeOp(resL, suffix[offset + left]);
+                else {
+                    for (int i = offset + left; i <= offset + right; i++)
+                        resL = mergeOp(resL, tree[i]);
+                }
+                break;
+            }
+
+            if (!fullL) {
+                resL = mergeOp(resL, suffix[offset + left]);
+                blockL++;
+            }
+            if (!fullR) {
+                resR = mergeOp(prefix[offset + right], resR);
+                blockR--;
+            }
+            left = blockL;
+            right = blockR;
+        }
+
+        return mergeOp(resL, resR);
+    }
+
+    //--- update
+
+    void update(int index, T newValue) {
+        tree[index] = newValue;
+        updateUpper(index);
+    }
+
+    void add(int index, T value) {
+        tree[index] += value;
+        updateUpper(index);
+    }
+
+private:
+    void buildUpper() {
+        for (int level = 0; level + 1 < int(levelOffset.size()); level++) {
+            int count = (levelOffset[level + 1] - levelOffset[level]) / B;
+            for (int i = 0; i < count; i++) {
+                int block = levelOffset[level] + i * B;
+                buildBlock(block);
+                if (level + 2 < int(levelOffset.size()))
+                    tree[levelOffset[level + 1] + i] = suffix[block];
+            }
+        }
+    }
+
+    void updateUpper(int index) {
+        for (int level = 0; level + 1 < int(levelOffset.size()); level++) {
+            int block = levelOffset[level] + (index & ~(B - 1));
+            buildBlock(block);
+            index /= B;
+            if (level + 2 < int(levelOffset.size()))
+                tree[levelOffset[level + 1] + index] = suffix[block];
+        }
+    }
+
+    void buildBlock(int block) {
+        prefix[block] = tree[block];
+        for (int i = block + 1; i < block + B; i++)
+            prefix[i] = mergeOp(prefix[i - 1], tree[i]);
+        suffix[block + B - 1] = tree[block + B - 1];
+        for (int i = block + B - 2; i >= block; i--)
+            suffix[i] = mergeOp(tree[i], suffix[i + 1]);
+    }
+};
+
+template <typename T, typename MergeOp>
+inline BlockedSegmentTree<T, MergeOp> makeBlockedSegmentTree(int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
+    return BlockedSegmentTree<T, MergeOp>(size, op, dfltValue);
+}
+
+template <typename T, typename MergeOp>
+inline BlockedSegmentTree<T, MergeOp> makeBlockedSegmentTree(const vector<T>& v, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
+    return BlockedSegmentTree<T, MergeOp>(v, op, dfltValue);
+}
+
+template <typename T, typename MergeOp>
+inline BlockedSegmentTree<T, MergeOp> makeBlockedSegmentTree(const T arr[], int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
+    return BlockedSegmentTree<T, MergeOp>(arr, size, op, dfltValue);
+}
@@ -3,6 +3,9 @@
 #include <vector>
 #include <functional>
 
+#include "monoid.h"
+#include "batchQuery.h"
+
 //--------- Compact Segment Tree ----------------------------------------------
 // http://codeforces.com/blog/entry/18051
 
@@ -16,26 +19,26 @@ struct CompactSegmentTree {
     MergeOp   mergeOp;
     T         defaultValue;
 
-    explicit CompactSegmentTree(MergeOp op, T dflt = T())
+    explicit CompactSegmentTree(MergeOp op, T dflt = MonoidIdentity<MergeOp, T>::get())
         : RealN(0), N(0), tree(), mergeOp(op), defaultValue(dflt) {
     }
 
-    CompactSegmentTree(int size, MergeOp op, T dflt = T(), bool alignPowerOf2 = false)
+    CompactSegmentTree(int size, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get(), bool alignPowerOf2 = false)
         : mergeOp(op), defaultValue(dflt) {
         init(size, alignPowerOf2);
     }
 
-    CompactSegmentTree(T value, int n, MergeOp op, T dflt = T(), bool alignPowerOf2 = false)
+    CompactSegmentTree(T value, int n, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get(), bool alignPowerOf2 = false)
         : mergeOp(op), defaultValue(dflt) {
         build(value, n, alignPowerOf2);
     }
 
-    CompactSegmentTree(const T arr[], int n, MergeOp op, T dflt = T(), bool alignPowerOf2 = false)
+    CompactSegmentTree(const T arr[], int n, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get(), bool alignPowerOf2 = false)
         : mergeOp(op), defaultValue(dflt) {
         build(arr, n, alignPowerOf2);
     }
 
-    CompactSegmentTree(const vector<T>& v, MergeOp op, T dflt = T(), bool alignPowerOf2 = false)
+    CompactSegmentTree(const vector<T>& v, MergeOp op = MergeOp(), T dflt = MonoidIdentity<MergeOp, T>::get(), bool alignPowerOf2 = false)
         : mergeOp(op), defaultValue(dflt) {
         build(v, alignPowerOf2);
     }
@@ -138,20 +141,59 @@ struct CompactSegmentTree {
                 tree[i] = mergeOp(tree[i << 1], tree[(i << 1) | 1]);
         }
     }
+
+    //--- batch
+
+    // res[i] = query(qry[i].first, qry[i].second), see batchQuery.h
+    void queryBatch(const pair<int, int> qry[], int n, T res[]) const {
+        for (int i = 0; i < n; i++) {
+            if (i + QUERY_PREFETCH_DISTANCE < n) {
+                int left = qry[i + QUERY_PREFETCH_DISTANCE].first + N;
+                int right = qry[i + QUERY_PREFETCH_DISTANCE].second + N;
+                prefetchRead(&tree[left]);
+                prefetchRead(&tree[right]);
+                prefetchRead(&tree[left >> 1]);
+                prefetchRead(&tree[right >> 1]);
+            }
+            res[i] = query(qry[i].first, qry[i].second);
+        }
+    }
+
+    vector<T> queryBatch(const vector<pair<int, int>>& qry) const {
+        vector<T> res(qry.size());
+        queryBatch(qry.data(), int(qry.size()), res.data());
+        return res;
+    }
+
+    // update(upd[i].first, upd[i].second) for all i, in order
+    void updateBatch(const pair<int, T> upd[], int n) {
+        for (int i = 0; i < n; i++) {
+            if (i + QUERY_PREFETCH_DISTANCE < n) {
+                int x = upd[i + QUERY_PREFETCH_DISTANCE].first + N;
+                prefetchWrite(&tree[x]);
+                prefetchWrite(&tree[x >> 1]);
+            }
+            update(upd[i].first, upd[i].second);
+        }
+    }
+
+    void updateBatch(const vector<pair<int, T>>& upd) {
+        updateBatch(upd.data(), int(upd.size()));
+    }
 };
 
 template <typename T, typename MergeOp>
-inline CompactSegmentTree<T, MergeOp> makeCompactSegmentTree(int size, MergeOp op, T dfltValue = T(), bool alignPowerOf2 = false) {
+inline CompactSegmentTree<T, MergeOp> makeCompactSegmentTree(int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get(), bool alignPowerOf2 = false) {
     return CompactSegmentTree<T, MergeOp>(size, op, dfltValue, alignPowerOf2);
 }
 
 template <typename T, typename MergeOp>
-inline CompactSegmentTree<T, MergeOp> makeCompactSegmentTree(const vector<T>& v, MergeOp op, T dfltValue = T(), bool alignPowerOf2 = false) {
+inline CompactSegmentTree<T, MergeOp> makeCompactSegmentTree(const vector<T>& v, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get(), bool alignPowerOf2 = false) {
     return CompactSegmentTree<T, MergeOp>(v, op, dfltValue, alignPowerOf2);
 }
 
 template <typename T, typename MergeOp>
-inline CompactSegmentTree<T, MergeOp> makeCompactSegmentTree(const T arr[], int size, MergeOp op, T dfltValue = T(), bool alignPowerOf2 = false) {
+inline CompactSegmentTree<T, MergeOp> makeCompactSegmentTree(const T arr[], int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get(), bool alignPowerOf2 = false) {
     return CompactSegmentTree<T, MergeOp>(arr, size, op, dfltValue, alignPowerOf2);
 }
 
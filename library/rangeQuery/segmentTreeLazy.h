@@ -1,5 +1,7 @@
 #pragma once
 
+#include "monoid.h"
+
 // The first 'node' number is 1, not 0
 // Others('left', 'right', 'nodeLeft', 'nodeRight', 'index') are started from 0
 template <typename T, typename MergeOp = function<T(T, T)>, typename BlockOp = function<T(T, int)>>
@@ -13,26 +15,26 @@ struct SegmentTreeLazy {
     MergeOp   mergeOp;
     BlockOp   blockOp;
 
-    SegmentTreeLazy(MergeOp mop, BlockOp bop, T dflt = T())
+    SegmentTreeLazy(MergeOp mop, BlockOp bop, T dflt = MonoidIdentity<MergeOp, T>::get())
         : defaultValue(dflt), mergeOp(mop), blockOp(bop) {
     }
 
-    SegmentTreeLazy(int size, MergeOp mop, BlockOp bop, T dflt = T())
+    SegmentTreeLazy(int size, MergeOp mop = MergeOp(), BlockOp bop = BlockOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : defaultValue(dflt), mergeOp(mop), blockOp(bop) {
         init(size);
     }
 
-    SegmentTreeLazy(T value, int n, MergeOp mop, BlockOp bop, T dflt = T())
+    SegmentTreeLazy(T value, int n, MergeOp mop = MergeOp(), BlockOp bop = BlockOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : defaultValue(dflt), mergeOp(mop), blockOp(bop) {
         build(value, n);
     }
 
-    SegmentTreeLazy(const T arr[], int n, MergeOp mop, BlockOp bop, T dflt = T())
+    SegmentTreeLazy(const T arr[], int n, MergeOp mop = MergeOp(), BlockOp bop = BlockOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : defaultValue(dflt), mergeOp(mop), blockOp(bop) {
         build(arr, n);
     }
 
-    SegmentTreeLazy(const vector<T> &v, MergeOp mop, BlockOp bop, T dflt = T())
+    SegmentTreeLazy(const vector<T> &v, MergeOp mop = MergeOp(), BlockOp bop = BlockOp(), T dflt = MonoidIdentity<MergeOp, T>::get())
         : defaultValue(dflt), mergeOp(mop), blockOp(bop) {
         build(v);
     }
@@ -207,18 +209,18 @@ private:
 };
 
 template <typename T, typename MergeOp, typename BlockOp>
-inline SegmentTreeLazy<T, MergeOp, BlockOp> makeSegmentTreeLazy(int size, MergeOp mop, BlockOp bop, T dfltValue = T()) {
+inline SegmentTreeLazy<T, MergeOp, BlockOp> makeSegmentTreeLazy(int size, MergeOp mop, BlockOp bop, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SegmentTreeLazy<T, MergeOp, BlockOp>(size, mop, bop, dfltValue);
 }
 
 template <typename T, typename MergeOp, typename BlockOp>
-inline SegmentTreeLazy<T, MergeOp, BlockOp> makeSegmentTreeLazy(const vector<T>& v, MergeOp mop, BlockOp bop, T dfltValue = T()) {
+inline SegmentTreeLazy<T, MergeOp, BlockOp> makeSegmentTreeLazy(const vector<T>& v, MergeOp mop, BlockOp bop, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     auto segTree = SegmentTreeLazy<T, MergeOp, BlockOp>(v, mop, bop, dfltValue);
     return segTree;
 }
 
 template <typename T, typename MergeOp, typename BlockOp>
-inline SegmentTreeLazy<T, MergeOp, BlockOp> makeSegmentTreeLazy(const T arr[], int size, MergeOp mop, BlockOp bop, T dfltValue = T()) {
+inline SegmentTreeLazy<T, MergeOp, BlockOp> makeSegmentTreeLazy(const T arr[], int size, MergeOp mop, BlockOp bop, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     auto segTree = SegmentTreeLazy<T, MergeOp, BlockOp>(arr, size, mop, bop, dfltValue);
     return segTree;
 }
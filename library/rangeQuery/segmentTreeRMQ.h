@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include "batchQuery.h"
+
 //--------- RMQ (Range Minimum Query) - Min Segment Tree ----------------------
 
 // RMQ (Range Minimum Query)
@@ -89,4 +91,44 @@ struct RMQ {
         }
         return ret;
     }
+
+    //--- batch
+
+    // res[i] = query(qry[i].first, qry[i].second), see batchQuery.h
+    void queryBatch(const pair<int, int> qry[], int n, int res[]) const {
+        for (int i = 0; i < n; i++) {
+            if (i + QUERY_PREFETCH_DISTANCE < n) {
+                int left = qry[i + QUERY_PREFETCH_DISTANCE].first + N;
+                int right = qry[i + QUERY_PREFETCH_DISTANCE].second + N;
+                prefetchRead(&value[left]);
+                prefetchRead(&value[right]);
+                prefetchRead(&value[left >> 1]);
+                prefetchRead(&value[right >> 1]);
+            }
+            res[i] = query(qry[i].first, qry[i].second);
+        }
+    }
+
+    vector<int> queryBatch(const vector<pair<int, int>>& qry) const {
+        vector<int> res(qry.size());
+        queryBatch(qry.data(), int(qry.size()), res.data());
+        return res;
+    }
+
+    // update(upd[i].first, upd[i].second) for all i, in order
+    void updateBatch(const pair<int, int> upd[], int n) {
+        for (int i = 0; i < n; i++) {
+            if (i + QUERY_PREFETCH_DISTANCE < n) {
+                int x = upd[i + QUERY_PREFETCH_DISTANCE].first + N;
+                prefetchWrite(&value[x]);
+                prefetchWrite(&value[x >> 1]);
+                prefetchWrite(&valueId[x >> 1]);
+            }
+            update(upd[i].first, upd[i].second);
+        }
+    }
+
+    void updateBatch(const vector<pair<int, int>>& upd) {
+        updateBatch(upd.data(), int(upd.size()));
+    }
 };
@@ -3,6 +3,9 @@
 #include <vector>
 #include <functional>
 
+#include "monoid.h"
+#include "../common/parallelFor.h"
+
 //--------- General Sparse Table ----------------------------------------------
 
 template <typename T, typename MergeOp = function<T(T,T)>>
@@ -13,16 +16,16 @@ struct SparseTable {
     MergeOp             mergeOp;
     T                   defaultValue;
 
-    explicit SparseTable(MergeOp op, T dfltValue = T())
+    explicit SparseTable(MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dfltValue) {
     }
 
-    SparseTable(const T a[], int n, MergeOp op, T dfltValue = T())
+    SparseTable(const T a[], int n, MergeOp op = MergeOp(), T dfltValue = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dfltValue) {
         build(a, n);
     }
 
-    SparseTable(const vector<T>& a, MergeOp op, T dfltValue = T())
+    SparseTable(const vector<T>& a, MergeOp op = MergeOp(), T dfltValue = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dfltValue) {
         build(a);
     }
@@ -33,7 +36,8 @@ struct SparseTable {
     }
 
 
-    void build(const T a[], int n) {
+    // O(NlogN), each level is split among 'threadCount' threads
+    void build(const T a[], int n, int threadCount = 1) {
         this->N = n;
 
         H.resize(n + 1);
@@ -41,24 +45,32 @@ struct SparseTable {
         for (int i = 2; i < int(H.size()); i++)
             H[i] = H[i >> 1] + 1;
 
-        value.assign(H.back() + 1, vector<T>(n, defaultValue));
+        int levels = H.back() + 1;
+        value.resize(levels);
+        parallelFor(levels, threadCount, [this, n](int first, int last) {
+            for (int i = first; i < last; i++)
+                value[i].resize(n);
+        });
         for (int i = 0; i < n; i++)
             value[0][i] = a[i];
 
-        for (int i = 1; i < int(value.size()); i++) {
-            vector<T>& prev = value[i - 1];
+        for (int i = 1; i < levels; i++) {
+            const vector<T>& prev = value[i - 1];
             vector<T>& curr = value[i];
-            for (int v = 0; v < n; v++) {
-                if (v + (1 << (i - 1)) < n)
-                    curr[v] = mergeOp(prev[v], prev[v + (1 << (i - 1))]);
-                else
-                    curr[v] = prev[v];
-            }
+            int half = 1 << (i - 1);
+            parallelFor(n, threadCount, [this, &prev, &curr, half, n](int first, int last) {
+                for (int v = first; v < last; v++) {
+                    if (v + half < n)
+                        curr[v] = mergeOp(prev[v], prev[v + half]);
+                    else
+                        curr[v] = prev[v];
+                }
+            });
         }
     }
 
-    void build(const vector<T>& a) {
-        build(&a[0], int(a.size()));
+    void build(const vector<T>& a, int threadCount = 1) {
+        build(&a[0], int(a.size()), threadCount);
     }
 
 
@@ -99,12 +111,12 @@ struct SparseTable {
 };
 
 template <typename T, typename MergeOp>
-inline SparseTable<T, MergeOp> makeSparseTable(const vector<T>& arr, MergeOp op, T dfltValue = T()) {
+inline SparseTable<T, MergeOp> makeSparseTable(const vector<T>& arr, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SparseTable<T, MergeOp>(arr, op, dfltValue);
 }
 
 template <typename T, typename MergeOp>
-inline SparseTable<T, MergeOp> makeSparseTable(const T arr[], int size, MergeOp op, T dfltValue = T()) {
+inline SparseTable<T, MergeOp> makeSparseTable(const T arr[], int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SparseTable<T, MergeOp>(arr, size, op, dfltValue);
 }
 
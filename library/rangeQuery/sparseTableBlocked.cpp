@@ -0,0 +1,54 @@
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <functional>
+#include <algorithm>
+
+using namespace std;
+
+#include "sparseTableBlocked.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/rand.h"
+
+void testSparseTableBlocked() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Blocked Sparse Table -----------------------------" << endl;
+    {
+        for (int N = 1; N <= 2000; N += (N < 70) ? 1 : 193) {
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = RandInt32::get() % 1000000;
+
+            BlockedSparseTable<int, MinOp<int>> tableMin(in);
+            BlockedSparseTable<int, MaxOp<int>> tableMax(in);
+            BlockedSparseTable<int, GcdOp<int>> tableGcd(in);
+            BlockedSparseTable<int, SumOp<int>> tableSum(in);
+            auto tableLambda = makeBlockedSparseTable(in, [](int a, int b) { return min(a, b); }, numeric_limits<int>::max());
+
+            for (int L = 0; L < N; L += 1 + N / 50) {
+                int gtMin = numeric_limits<int>::max(), gtMax = numeric_limits<int>::min(), gtGcd = 0, gtSum = 0;
+                for (int R = L; R < N; R++) {
+                    gtMin = min(gtMin, in[R]);
+                    gtMax = max(gtMax, in[R]);
+                    gtGcd = GcdOp<int>()(gtGcd, in[R]);
+                    gtSum += in[R];
+                    assert(tableMin.query(L, R) == gtMin);
+                    assert(tableMax.query(L, R) == gtMax);
+                    assert(tableGcd.query(L, R) == gtGcd);
+                    assert(tableSum.queryNoOverlap(L, R) == gtSum);
+                    assert(tableLambda.query(L, R) == gtMin);
+                }
+            }
+        }
+    }
+
+    cout << "OK!" << endl;
+}
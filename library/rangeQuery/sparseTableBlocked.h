@@ -0,0 +1,150 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "monoid.h"
+
+//--------- Blocked Sparse Table ----------------------------------------------
+// Sparse table on blocks of SPARSE_TABLE_BLOCK_SIZE values
+//  - value[] keeps the array, prefix[]/suffix[] keep in-block prefix/suffix merges, and the sparse table
+//    is built on the merged value of each block, so the memory is about 3N instead of N*logN
+//  - a query spanning blocks reads suffix[left], prefix[right] and two cells of the small table,
+//    a query inside one block scans at most one block of contiguous values
+//  - all levels of the table are stored in one array
+//  - same query API as SparseTable, query() needs an idempotent operation (min, max, gcd, ...)
+
+#ifndef SPARSE_TABLE_BLOCK_SIZE
+#define SPARSE_TABLE_BLOCK_SIZE     16      // must be a power of 2
+#endif
+
+template <typename T, typename MergeOp = function<T(T, T)>>
+struct BlockedSparseTable {
+    static const int B = SPARSE_TABLE_BLOCK_SIZE;
+
+    int         N;
+    int         blockN;
+    vector<T>   value;
+    vector<T>   prefix;         // prefix[i] = value[i & ~(B - 1)] + ... + value[i]
+    vector<T>   suffix;         // suffix[i] = value[i] + ... + value[i | (B - 1)]
+    vector<T>   table;          // table[k * blockN + i] = merge of blocks [i, i + 2^k)
+    vector<int> H;              // floor(log2(i))
+
+    MergeOp     mergeOp;
+    T           defaultValue;
+
+    explicit BlockedSparseTable(MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get())
+        : N(0), blockN(0), mergeOp(op), defaultValue(dfltValue) {
+    }
+
+    BlockedSparseTable(const T a[], int n, MergeOp op = MergeOp(), T dfltValue = MonoidIdentity<MergeOp, T>::get())
+        : mergeOp(op), defaultValue(dfltValue) {
+        build(a, n);
+    }
+
+    BlockedSparseTable(const vector<T>& a, MergeOp op = MergeOp(), T dfltValue = MonoidIdentity<MergeOp, T>::get())
+        : mergeOp(op), defaultValue(dfltValue) {
+        build(a);
+    }
+
+
+    void build(const T a[], int n) {
+        N = n;
+        blockN = (n + B - 1) / B;
+
+        value.assign(a, a + n);
+        prefix.resize(n);
+        suffix.resize(n);
+        for (int start = 0; start < n; start += B) {
+            int end = (start + B < n) ? start + B : n;
+            prefix[start] = a[start];
+            for (int i = start + 1; i < end; i++)
+                prefix[i] = mergeOp(prefix[i - 1], a[i]);
+            suffix[end - 1] = a[end - 1];
+            for (int i = end - 2; i >= start; i--)
+                suffix[i] = mergeOp(a[i], suffix[i + 1]);
+        }
+
+        H.assign(blockN + 1, 0);
+        for (int i = 2; i <= blockN; i++)
+            H[i] = H[i >> 1] + 1;
+
+        int levels = blockN > 0 ? H[blockN] + 1 : 0;
+        table.resize(size_t(levels) * blockN);
+        for (int i = 0; i < blockN; i++)
+            table[i] = suffix[i * B];
+        for (int k = 1; k < levels; k++) {
+            const T* prev = &table[size_t(k - 1) * blockN];
+            T* curr = &table[size_t(k) * blockN];
+            int half = 1 << (k - 1);
+            for (int i = 0; i + (1 << k) <= blockN; i++)
+                curr[i] = mergeOp(prev[i], prev[i + half]);
+        }
+    }
+
+    void build(const vector<T>& a) {
+        build(&a[0], int(a.size()));
+    }
+
+
+    // O(1) for queries spanning blocks, O(B) inside a block, inclusive
+    T query(int left, int right) const {
+        if (right < left)
+            return defaultValue;
+
+        int blockL = left / B;
+        int blockR = right / B;
+        if (blockL == blockR) {
+            if ((right & (B - 1)) == B - 1 || right == N - 1)
+                return suffix[left];
+            if ((left & (B - 1)) == 0)
+                return prefix[right];
+            T res = value[left];
+            for (int i = left + 1; i <= right; i++)
+                res = mergeOp(res, value[i]);
+            return res;
+        }
+
+        T res = suffix[left];
+        if (blockL + 1 < blockR)
+            res = mergeOp(res, queryBlocks(blockL + 1, blockR - 1));
+        return mergeOp(res, prefix[right]);
+    }
+
+    // O(log(right - left + 1)), inclusive, for non-idempotent operations
+    T queryNoOverlap(int left, int right) const {
+        if (right < left)
+            return defaultValue;
+
+        int blockL = left / B;
+        int blockR = right / B;
+        if (blockL == blockR)
+            return query(left, right);
+
+        T res = suffix[left];
+        for (int i = blockL + 1; i < blockR; ) {
+            int k = H[blockR - i];
+            res = mergeOp(res, table[size_t(k) * blockN + i]);
+            i += 1 << k;
+        }
+        return mergeOp(res, prefix[right]);
+    }
+
+private:
+    // inclusive
+    T queryBlocks(int left, int right) const {
+        int k = H[right - left + 1];
+        const T* row = &table[size_t(k) * blockN];
+        return mergeOp(row[left], row[right - (1 << k) + 1]);
+    }
+};
+
+template <typename T, typename MergeOp>
+inline BlockedSparseTable<T, MergeOp> makeBlockedSparseTable(const vector<T>& arr, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
+    return BlockedSparseTable<T, MergeOp>(arr, op, dfltValue);
+}
+
+template <typename T, typename MergeOp>
+inline BlockedSparseTable<T, MergeOp> makeBlockedSparseTable(const T arr[], int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
+    return BlockedSparseTable<T, MergeOp>(arr, size, op, dfltValue);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "monoid.h"
+#include "../common/parallelFor.h"
+
 // https://e-maxx-eng.appspot.com/data_structures/sqrt-tree.html
 
 template <typename T, typename MergeOp = function<T(T, T)>>
@@ -18,42 +21,42 @@ struct SqrtTree {
     MergeOp mergeOp;
     T       defaultValue;
 
-    explicit SqrtTree(MergeOp op, T dfltValue = T())
+    explicit SqrtTree(MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dfltValue) {
     }
 
-    SqrtTree(int n, const T& val, MergeOp op, T dfltValue = T())
+    SqrtTree(int n, const T& val, MergeOp op = MergeOp(), T dfltValue = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dfltValue) {
         build(n, val);
     }
 
-    SqrtTree(const T a[], int n, MergeOp op, T dfltValue = T())
+    SqrtTree(const T a[], int n, MergeOp op = MergeOp(), T dfltValue = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dfltValue) {
         build(a, n);
     }
 
-    SqrtTree(const vector<T>& a, MergeOp op, T dfltValue = T())
+    SqrtTree(const vector<T>& a, MergeOp op = MergeOp(), T dfltValue = MonoidIdentity<MergeOp, T>::get())
         : mergeOp(op), defaultValue(dfltValue) {
         build(a);
     }
 
 
-    // O(N*loglogN)
-    void build(int n, const T& val) {
+    // O(N*loglogN), the blocks of the top layer are split among 'threadCount' threads
+    void build(int n, const T& val, int threadCount = 1) {
         N = n;
         value.assign(n, val);
-        buildTree(n);
+        buildTree(n, threadCount);
     }
 
-    // O(N*loglogN)
-    void build(const T arr[], int n) {
+    // O(N*loglogN), the blocks of the top layer are split among 'threadCount' threads
+    void build(const T arr[], int n, int threadCount = 1) {
         N = n;
         value.assign(arr, arr + n);
-        buildTree(n);
+        buildTree(n, threadCount);
     }
 
-    void build(const vector<T>& v) {
-        build(&v[0], int(v.size()));
+    void build(const vector<T>& v, int threadCount = 1) {
+        build(&v[0], int(v.size()), threadCount);
     }
 
 
@@ -106,7 +109,7 @@ struct SqrtTree {
     }
 
 private:
-    void buildTree(int n) {
+    void buildTree(int n, int threadCount = 1) {
         H = 0;
         while ((1 << H) < n)
             H++;
@@ -127,7 +130,27 @@ private:
         suffix.assign(layers.size(), vector<T>(n));
         between.assign(layers.size(), vector<T>(size_t(1) << H));
 
-        buildSub(0, 0, n - 1);
+        if (threadCount <= 1 || layers.empty()) {
+            buildSub(0, 0, n - 1);
+            return;
+        }
+
+        // the blocks of the top layer are independent
+        int sizeLog = (layers[0] + 1) >> 1;
+        int countLog = layers[0] >> 1;
+        int size = 1 << sizeLog;
+        int count = (n - 1) / size + 1;
+        parallelFor(count, threadCount, [this, n, size](int first, int last) {
+            for (int i = first; i < last; i++) {
+                int L = i * size;
+                int R = min(L + size - 1, n - 1);
+                buildPrefixSuffix(0, L, R);
+                buildSub(1, L, R);
+            }
+        });
+        parallelFor(count, threadCount, [this, n, sizeLog, countLog](int first, int last) {
+            buildBetween(0, 0, n - 1, sizeLog, countLog, first, last);
+        });
     }
 
     void buildPrefixSuffix(int layer, int left, int right) {
@@ -143,9 +166,14 @@ private:
     }
 
     void buildBetween(int layer, int left, int right, int sizeLog, int countLog) {
+        buildBetween(layer, left, right, sizeLog, countLog, 0, (right - left) / (1 << sizeLog) + 1);
+    }
+
+    // rows [firstRow, lastRow) of between[layer]
+    void buildBetween(int layer, int left, int right, int sizeLog, int countLog, int firstRow, int lastRow) {
         int count = (right - left) / (1 << sizeLog) + 1;
 
-        for (int i = 0; i < count; i++) {
+        for (int i = firstRow; i < lastRow; i++) {
             T ans = defaultValue;
             for (int j = i; j < count; j++) {
                 ans = mergeOp(ans, suffix[layer][left + (j << sizeLog)]);
@@ -246,16 +274,16 @@ private:
 };
 
 template <typename T, typename MergeOp>
-SqrtTree<T, MergeOp> makeSqrtTree(int n, const T& val, MergeOp op, T dfltValue = T()) {
+SqrtTree<T, MergeOp> makeSqrtTree(int n, const T& val, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SqrtTree<T, MergeOp>(n, val, op, dfltValue);
 }
 
 template <typename T, typename MergeOp>
-SqrtTree<T, MergeOp> makeSqrtTree(const vector<T>& arr, MergeOp op, T dfltValue = T()) {
+SqrtTree<T, MergeOp> makeSqrtTree(const vector<T>& arr, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SqrtTree<T, MergeOp>(arr, op, dfltValue);
 }
 
 template <typename T, typename MergeOp>
-SqrtTree<T, MergeOp> makeSqrtTree(const T arr[], int size, MergeOp op, T dfltValue = T()) {
+SqrtTree<T, MergeOp> makeSqrtTree(const T arr[], int size, MergeOp op, T dfltValue = MonoidIdentity<MergeOp, T>::get()) {
     return SqrtTree<T, MergeOp>(arr, size, op, dfltValue);
 }
@@ -0,0 +1,236 @@
+#include <memory.h>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <stack>
+#include <queue>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+#include "ahoCorasickDFA.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <ctime>
+#include <cstdio>
+#include <cassert>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/rand.h"
+
+static string makeRandomString(int n, int charCnt, int charMin = 'a') {
+    string s;
+    s.reserve(n);
+    for (int i = 0; i < n; i++)
+        s.push_back(char(RandInt32::get() % charCnt + charMin));
+    return s;
+}
+
+// lines like "2019-05-21 12:34:56 INFO [worker-3] user=1234 op=read bytes=5678\n"
+static string makeLogLines(int n) {
+    static const char* levels[] = { "INFO", "WARN", "DEBUG", "ERROR" };
+    static const char* ops[] = { "read", "write", "open", "close", "stat" };
+
+    string s;
+    s.reserve(n + 128);
+    char line[128];
+    while (int(s.length()) < n) {
+        snprintf(line, sizeof(line), "2019-05-%02d %02d:%02d:%02d %s [worker-%d] user=%d op=%s bytes=%d\n",
+            RandInt32::get() % 31 + 1, RandInt32::get() % 24, RandInt32::get() % 60, RandInt32::get() % 60,
+            levels[RandInt32::get() % 4], RandInt32::get() % 16, RandInt32::get() % 10000,
+            ops[RandInt32::get() % 5], RandInt32::get() % 100000);
+        s += line;
+    }
+    s.resize(n);
+    return s;
+}
+
+static vector<pair<int, int>> searchNaive(const string& s, const vector<string>& patterns) {
+    vector<pair<int, int>> res;
+    for (int id = 0; id < int(patterns.size()); id++) {
+        const string& p = patterns[id];
+        if (p.empty())
+            continue;
+        for (size_t i = s.find(p); i != string::npos; i = s.find(p, i + 1))
+            res.emplace_back(int(i + p.length()) - 1, id);
+    }
+    sort(res.begin(), res.end());
+    return res;
+}
+
+void testAhoCorasickDFA() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "-- Aho-Corasick with a Dense DFA -------------------------" << endl;
+    {
+        AhoCorasickAM ac;
+        ac.insert("she", 0);
+        ac.insert("he", 1);
+        ac.insert("hers", 2);
+        ac.insert("his", 3);
+
+        AhoCorasickDFA dfa(ac);
+        assert(dfa.classCount() == 6);
+
+        //                            012345678
+        auto ans = dfa.doAhoCorasick("hershishe");
+        sort(ans.begin(), ans.end());
+
+        vector<pair<int, int>> gt{ { 1, 1 }, { 3, 2 }, { 6, 3 }, { 8, 0 }, { 8, 1 } };
+        assert(ans == gt);
+    }
+    {
+        // premultiplied states must fit in int
+        assert(AhoCorasickDFA::isTableSizeValid(INT_MAX / 256, 256));
+        assert(!AhoCorasickDFA::isTableSizeValid(INT_MAX / 256 + 1, 256));
+        assert(!AhoCorasickDFA::isTableSizeValid(1ll << 31, 1));
+
+        AhoCorasickDFA dfa;
+        assert(dfa.build(vector<string>{ "ab", "b" }) && dfa.stateCount() == 4);
+    }
+    {
+        int T = 100;
+        while (T-- > 0) {
+            int charCnt = (T & 1) ? int(RandInt32::get() % 4 + 1) : 256;
+            int charMin = (charCnt == 256) ? 0 : 'a';
+            int M = RandInt32::get() % 50 + 1;
+            vector<string> patterns(M);
+            for (auto& p : patterns)
+                p = makeRandomString(RandInt32::get() % 6, charCnt, charMin);
+            if (M > 1)
+                patterns[M - 1] = patterns[0];
+
+            string s = makeRandomString(RandInt32::get() % 3000, charCnt, charMin);
+            auto gt = searchNaive(s, patterns);
+
+            AhoCorasickDFA dfa(patterns);
+            for (int prefilter = 0; prefilter < 2; prefilter++) {
+                dfa.usePrefilter = (prefilter != 0);
+
+                auto ans = dfa.doAhoCorasick(s);
+                sort(ans.begin(), ans.end());
+                assert(ans == gt);
+
+                // chunks
+                ans.clear();
+                AhoCorasickDFA::StreamState st;
+                for (int i = 0; i < int(s.length()); ) {
+                    int len = min(int(s.length()) - i, int(RandInt32::get() % 40 + 1));
+                    dfa.scan(st, s.data() + i, len, [&ans](long long pos, int id) {
+                        ans.emplace_back(int(pos), id);
+                    });
+                    i += len;
+                }
+                assert(st.offset == (long long)s.length());
+                sort(ans.begin(), ans.end());
+                assert(ans == gt);
+            }
+        }
+    }
+    {
+        // the same as AhoCorasickAM
+        int T = 20;
+        while (T-- > 0) {
+            int M = RandInt32::get() % 100 + 1;
+            AhoCorasickAM ac;
+            for (int id = 0; id < M; id++)
+                ac.insert(makeRandomString(RandInt32::get() % 5 + 1, 3), id);
+            ac.build();
+
+            AhoCorasickDFA dfa(ac);
+            string s = makeRandomString(1000, 3);
+            auto gt = ac.doAhoCorasick(s);
+            auto ans = dfa.doAhoCorasick(s);
+            sort(gt.begin(), gt.end());
+            sort(ans.begin(), ans.end());
+            assert(ans == gt);
+        }
+    }
+    cout << "*** FILE stream ***" << endl;
+    {
+        string s = makeLogLines(100000);
+        vector<string> patterns{ "ERROR [worker-1]", "user=12", "op=stat", "\n2019-05-31", "=" };
+        auto gt = searchNaive(s, patterns);
+
+        const char* path = "ahoCorasickDFA_text.txt";
+        FILE* fp = fopen(path, "wb");
+        assert(fp != nullptr);
+        fwrite(s.data(), 1, s.length(), fp);
+        fclose(fp);
+
+        AhoCorasickDFA dfa(patterns);
+        vector<pair<int, int>> ans;
+        AhoCorasickDFA::StreamState st;
+        fp = fopen(path, "rb");
+        assert(fp != nullptr);
+        assert(dfa.scan(st, fp, [&ans](long long pos, int id) { ans.emplace_back(int(pos), id); }, 1000) == (long long)s.length());
+        fclose(fp);
+        remove(path);
+
+        sort(ans.begin(), ans.end());
+        assert(ans == gt);
+    }
+    cout << "*** Speed test ***" << endl;
+    {
+        int N = 100000000;
+        int M = 100000;
+#ifdef _DEBUG
+        N = 1000000;
+        M = 1000;
+#endif
+        {
+            // 26 letters
+            string s = makeRandomString(N, 26);
+            AhoCorasickAM ac;
+            for (int id = 0; id < M; id++)
+                ac.insert(makeRandomString(RandInt32::get() % 9 + 4, 26), id);
+            ac.build();
+
+            clock_t start = clock();
+            AhoCorasickDFA dfa(ac);
+            double buildSec = double(clock() - start) / CLOCKS_PER_SEC;
+            cout << "26 letters, N = " << N << ", M = " << M << " : " << dfa.stateCount() << " states, "
+                 << dfa.classCount() << " classes, " << dfa.memoryBytes() / 1048576.0 << " MB, build " << buildSec << " sec" << endl;
+
+            long long cnt1 = 0, cnt2 = 0;
+            start = clock();
+            cnt1 = ac.doAhoCorasick(s).size();
+            cout << "  AhoCorasickAM : " << double(clock() - start) / CLOCKS_PER_SEC << " sec" << endl;
+
+            start = clock();
+            dfa.scan(s.data(), N, [&cnt2](long long, int) { cnt2++; });
+            cout << "  AhoCorasickDFA : " << double(clock() - start) / CLOCKS_PER_SEC << " sec" << endl;
+            assert(cnt1 == cnt2);
+        }
+        {
+            // log lines with patterns of rare first bytes
+            string s = makeLogLines(N);
+            vector<string> patterns(M);
+            char buf[64];
+            for (int id = 0; id < M; id++) {
+                snprintf(buf, sizeof(buf), "%s [worker-%d] user=%d ", (id & 1) ? "ERROR" : "WARN",
+                         RandInt32::get() % 16, RandInt32::get() % 10000);
+                patterns[id] = buf;
+            }
+
+            AhoCorasickDFA dfa(patterns);
+            cout << "log lines, N = " << N << ", M = " << M << " : " << dfa.stateCount() << " states, "
+                 << dfa.classCount() << " classes, " << dfa.startByteN << " start bytes" << endl;
+
+            long long cnt[2] = { 0, 0 };
+            for (int prefilter = 0; prefilter < 2; prefilter++) {
+                dfa.usePrefilter = (prefilter != 0);
+                clock_t start = clock();
+                dfa.scan(s.data(), N, [&cnt, prefilter](long long, int) { cnt[prefilter]++; });
+                cout << "  AhoCorasickDFA, prefilter " << (prefilter ? "on" : "off") << " : "
+                     << double(clock() - start) / CLOCKS_PER_SEC << " sec" << endl;
+            }
+            assert(cnt[0] == cnt[1]);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+#include "ahoCorasickAM.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define AHO_CORASICK_USE_SIMD
+#define AHO_CORASICK_TARGET_SSSE3   __attribute__((target("ssse3")))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define AHO_CORASICK_USE_SIMD
+#define AHO_CORASICK_TARGET_SSSE3
+#endif
+
+//--- Aho-Corasick with a dense DFA -------------------------------------------
+// Multi-pattern matcher compiled from byte patterns or an AhoCorasickAM
+//  - a flat transition table : one load per byte, no suffix link walk at search time
+//  - byte classes : bytes in no pattern share one column, so a row has (distinct pattern bytes + 1) entries
+//  - states are premultiplied by the row size, and the states with outputs are numbered last,
+//    so the hot loop is "state = table[state + byteClass[ch]]; if (state >= matchStart) report"
+//  - prefilter : in the root state, the text is skipped 16 bytes at a time (SSSE3 shufti) to the next byte
+//    that can start a match. It's on by default when few bytes can start a match (PREFILTER_MAX_START_BYTES).
+//  - streaming : scan() continues a StreamState, so matches across buffer boundaries are found
+//  - memory is stateCount() * classCount() * 4 bytes, stateCount() <= the sum of pattern lengths + 1
+//  - premultiplied states are ints, so build() fails if stateCount() * classCount() > INT_MAX
+struct AhoCorasickDFA {
+    static const int PREFILTER_MAX_START_BYTES = 32;
+
+    // the state of a stream to be scanned in chunks
+    struct StreamState {
+        int         state = 0;
+        long long   offset = 0;             // the position of the next byte in the stream
+    };
+
+    int             classN;                 // the number of byte classes, class 0 is the bytes in no pattern
+    unsigned char   byteClass[256];
+    vector<int>     table;                  // the next state of (state, ch) is table[state + byteClass[ch]]
+    int             matchStart;             // premultiplied states >= matchStart have outputs
+
+    // by state index (= state / classN)
+    vector<int>     outStart;               // the pattern ids ending at a state : outIds[outStart[u] .. outStart[u + 1])
+    vector<int>     outIds;
+    vector<int>     outLink;                // the longest proper suffix state with outputs, -1 if not exists
+
+    vector<int>     patternLen;             // by pattern id
+
+    bool            startByte[256];         // bytes that leave the root
+    int             startByteN;
+    unsigned char   loMask[16];             // shufti masks of start bytes, by the low and high nibbles
+    unsigned char   hiMask[16];
+    bool            usePrefilter;
+    bool            useSIMD;
+
+    AhoCorasickDFA() {
+        build(vector<string>());
+    }
+
+    explicit AhoCorasickDFA(const vector<string>& patterns) {
+        build(patterns);
+    }
+
+    explicit AhoCorasickDFA(const AhoCorasickAM& ac) {
+        build(ac);
+    }
+
+    // the id of patterns[i] is i, empty patterns are ignored
+    // returns false and keeps no patterns if the table can't be indexed by int (see isTableSizeValid())
+    bool build(const vector<string>& patterns) {
+        bool used[256] = { false, };
+        for (auto& p : patterns) {
+            for (char ch : p)
+                used[(unsigned char)ch] = true;
+        }
+        classN = 1;
+        for (int b = 0; b < 256; b++)
+            byteClass[b] = used[b] ? (unsigned char)(classN++) : 0;
+
+        // trie in the table, 0 is 'no child' (the root can't be a child)
+        table.assign(classN, 0);
+        patternLen.assign(patterns.size(), 0);
+        vector<pair<int, int>> terminals;   // (state index, pattern id)
+        for (int id = 0; id < int(patterns.size()); id++) {
+            const string& p = patterns[id];
+            patternLen[id] = int(p.length());
+            if (p.empty())
+                continue;
+
+            int u = 0;
+            for (char ch : p) {
+                size_t i = size_t(u) * classN + byteClass[(unsigned char)ch];
+                if (!table[i]) {
+                    if (!isTableSizeValid(stateCount() + 1ll, classN)) {
+                        build(vector<string>());
+                        return false;
+                    }
+                    table[i] = int(table.size() / classN);
+                    table.resize(table.size() + classN, 0);
+                }
+                u = table[i];
+            }
+            terminals.emplace_back(u, id);
+        }
+
+        compile(terminals);
+        return true;
+    }
+
+    // from the trie of an AhoCorasickAM ('a' ~ 'z'), AhoCorasickAM::build() is not needed
+    bool build(const AhoCorasickAM& ac) {
+        vector<string> patterns;
+        string s;
+        collectPatterns(&ac.mRoot, s, patterns);
+        return build(patterns);
+    }
+
+    // the premultiplied states (state index * classN) and the indexes of the table (state + class) are ints
+    static bool isTableSizeValid(long long stateN, int classN) {
+        return stateN * classN <= INT_MAX;
+    }
+
+
+    int stateCount() const {
+        return int(table.size() / classN);
+    }
+
+    int classCount() const {
+        return classN;
+    }
+
+    size_t memoryBytes() const {
+        return (table.capacity() + outStart.capacity() + outIds.capacity() + outLink.capacity()
+              + patternLen.capacity()) * sizeof(int);
+    }
+
+    //--- search
+
+    // f(last_position_in_stream, pattern_id) for all matches in s[0..len), in the order of positions
+    template <typename F>
+    void scan(StreamState& st, const char* s, int len, F f) const {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(s);
+        const int* next = table.data();
+        int state = st.state;
+        for (int i = 0; i < len; i++) {
+            if (state == 0 && usePrefilter) {
+                i = skipToStart(p, i, len);
+                if (i >= len)
+                    break;
+            }
+            state = next[state + byteClass[p[i]]];
+            if (state >= matchStart)
+                report(state, st.offset + i, f);
+        }
+        st.state = state;
+        st.offset += len;
+    }
+
+    template <typename F>
+    void scan(const char* s, int len, F f) const {
+        StreamState st;
+        scan(st, s, len, f);
+    }
+
+    // reads the rest of a file in chunks, returns the number of bytes read
+    template <typename F>
+    long long scan(StreamState& st, FILE* fp, F f, int chunkSize = 1 << 16) const {
+        vector<char> buffer(chunkSize);
+        long long res = 0;
+        size_t n;
+        while ((n = fread(buffer.data(), 1, buffer.size(), fp)) > 0) {
+            scan(st, buffer.data(), int(n), f);
+            res += (long long)n;
+        }
+        return res;
+    }
+
+    // search all patterns in s, the same as AhoCorasickAM::doAhoCorasick()
+    // return (last_character_in_s, pattern_id)s
+    vector<pair<int, int>> doAhoCorasick(const string& s) const {
+        return doAhoCorasick(s.data(), int(s.length()));
+    }
+
+    vector<pair<int, int>> doAhoCorasick(const char* s, int len) const {
+        vector<pair<int, int>> res;
+        scan(s, len, [&res](long long pos, int id) {
+            res.emplace_back(int(pos), id);
+        });
+        return res;
+    }
+
+private:
+    void collectPatterns(const AhoCorasickAM::Node* p, string& s, vector<string>& patterns) {
+        if (p->isTerminal()) {
+            if (int(patterns.size()) <= p->terminal)
+                patterns.resize(p->terminal + 1);
+            patterns[p->terminal] = s;
+        }
+        for (int c = 0; c < int(AhoCorasickAM::MaxCharN); c++) {
+            const AhoCorasickAM::Node* child = p->getChild(c);
+            if (child) {
+                s.push_back(char('a' + c));
+                collectPatterns(child, s, patterns);
+                s.pop_back();
+            }
+        }
+    }
+
+    // completes the trie in the table to a DFA, and renumbers the states
+    void compile(vector<pair<int, int>>& terminals) {
+        int stateN = stateCount();
+
+        vector<char> hasOwn(stateN, 0);
+        for (auto& t : terminals)
+            hasOwn[t.first] = 1;
+
+        // BFS : a missing transition of u is the transition of fail[u], which is shallower and done
+        vector<int> fail(stateN, 0), order, link(stateN, -1);
+        vector<char> hasOut(hasOwn);
+        order.reserve(stateN);
+        order.push_back(0);
+        for (int k = 0; k < int(order.size()); k++) {
+            int u = order[k];
+            int* row = table.data() + size_t(u) * classN;
+            const int* failRow = table.data() + size_t(fail[u]) * classN;
+            for (int c = 0; c < classN; c++) {
+                int v = row[c];
+                if (v) {
+                    fail[v] = (u == 0) ? 0 : failRow[c];
+                    link[v] = hasOwn[fail[v]] ? fail[v] : link[fail[v]];
+                    hasOut[v] |= hasOut[fail[v]];
+                    order.push_back(v);
+                } else {
+                    row[c] = (u == 0) ? 0 : failRow[c];
+                }
+            }
+        }
+
+        // states without outputs first, in BFS order
+        vector<int> newId(stateN), oldId(stateN);
+        int n = 0;
+        for (int u : order) {
+            if (!hasOut[u])
+                newId[u] = n++;
+        }
+        matchStart = n * classN;
+        for (int u : order) {
+            if (hasOut[u])
+                newId[u] = n++;
+        }
+        for (int u = 0; u < stateN; u++)
+            oldId[newId[u]] = u;
+
+        // no overflow, build() checked isTableSizeValid(stateN, classN)
+        for (auto& v : table)
+            v = newId[v] * classN;
+
+        // move rows along the cycles of the permutation
+        vector<int> tmp(classN);
+        vector<char> done(stateN, 0);
+        for (int u = 0; u < stateN; u++) {
+            if (done[u] || oldId[u] == u)
+                continue;
+            copy(table.begin() + size_t(u) * classN, table.begin() + size_t(u + 1) * classN, tmp.begin());
+            int pos = u;
+            while (true) {
+                done[pos] = 1;
+                int src = oldId[pos];
+                if (src == u) {
+                    copy(tmp.begin(), tmp.end(), table.begin() + size_t(pos) * classN);
+                    break;
+                }
+                copy(table.begin() + size_t(src) * classN, table.begin() + size_t(src + 1) * classN,
+                     table.begin() + size_t(pos) * classN);
+                pos = src;
+            }
+        }
+
+        // outputs
+        for (auto& t : terminals)
+            t.first = newId[t.first];
+        sort(terminals.begin(), terminals.end());
+        outStart.assign(stateN + 1, 0);
+        outIds.resize(terminals.size());
+        for (int i = 0; i < int(terminals.size()); i++) {
+            outStart[terminals[i].first + 1]++;
+            outIds[i] = terminals[i].second;
+        }
+        for (int u = 0; u < stateN; u++)
+            outStart[u + 1] += outStart[u];
+        outLink.assign(stateN, -1);
+        for (int u = 0; u < stateN; u++)
+            outLink[newId[u]] = (link[u] < 0) ? -1 : newId[link[u]];
+
+        buildPrefilter();
+    }
+
+    void buildPrefilter() {
+        startByteN = 0;
+        for (int b = 0; b < 256; b++) {
+            startByte[b] = table[byteClass[b]] != 0;
+            startByteN += startByte[b];
+        }
+
+        // a bucket for each high nibble, and high nibbles share buckets when there are more than 8
+        // (false positives are fine, the DFA checks every byte the prefilter stops at)
+        int bucketN = 0;
+        int bucket[16];
+        for (int h = 0; h < 16; h++) {
+            bucket[h] = -1;
+            for (int l = 0; l < 16; l++) {
+                if (startByte[h * 16 + l]) {
+                    bucket[h] = bucketN++ % 8;
+                    break;
+                }
+            }
+        }
+        memset(loMask, 0, sizeof(loMask));
+        memset(hiMask, 0, sizeof(hiMask));
+        for (int b = 0; b < 256; b++) {
+            if (startByte[b]) {
+                loMask[b & 15] |= (unsigned char)(1 << bucket[b >> 4]);
+                hiMask[b >> 4] |= (unsigned char)(1 << bucket[b >> 4]);
+            }
+        }
+
+        usePrefilter = startByteN <= PREFILTER_MAX_START_BYTES;
+#ifdef AHO_CORASICK_USE_SIMD
+        useSIMD = hasSSSE3();
+#else
+        useSIMD = false;
+#endif
+    }
+
+    // the first position >= i that can start a match, or len
+    // it may stop at a byte that can't start a match with SIMD
+    int skipToStart(const unsigned char* s, int i, int len) const {
+#ifdef AHO_CORASICK_USE_SIMD
+        if (useSIMD) {
+            i = skipToStartSSSE3(s, i, len);
+            if (i + 16 <= len)
+                return i;
+        }
+#endif
+        while (i < len && !startByte[s[i]])
+            i++;
+        return i;
+    }
+
+#ifdef AHO_CORASICK_USE_SIMD
+    static bool hasSSSE3() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 9)) != 0;
+#else
+        return __builtin_cpu_supports("ssse3") != 0;
+#endif
+    }
+
+    // returns a candidate position, or the first position of the last less than 16 bytes
+    AHO_CORASICK_TARGET_SSSE3 int skipToStartSSSE3(const unsigned char* s, int i, int len) const {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(loMask));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hiMask));
+        __m128i nibble = _mm_set1_epi8(0x0F);
+        __m128i zero = _mm_setzero_si128();
+        for (; i + 16 <= len; i += 16) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(v, nibble));
+            __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+            unsigned mask = ~unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(l, h), zero))) & 0xFFFF;
+            if (mask) {
+#ifdef _MSC_VER
+                unsigned long k;
+                _BitScanForward(&k, mask);
+                return i + int(k);
+#else
+                return i + __builtin_ctz(mask);
+#endif
+            }
+        }
+        return i;
+    }
+#endif
+
+    template <typename F>
+    void report(int state, long long pos, F& f) const {
+        int u = state / classN;
+        do {
+            for (int k = outStart[u]; k < outStart[u + 1]; k++)
+                f(pos, outIds[k]);
+            u = outLink[u];
+        } while (u >= 0);
+    }
+};
@@ -0,0 +1,151 @@
+#include <memory.h>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <stack>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+#include "doubleArrayTrie.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+static string makeRandomString(int minLen, int maxLen, int charCnt = 26) {
+    int n = minLen + RandInt32::get() % (maxLen - minLen + 1);
+    string s;
+    s.reserve(n);
+    for (int i = 0; i < n; i++)
+        s.push_back(char(RandInt32::get() % charCnt + 'a'));
+    return s;
+}
+
+void testDoubleArrayTrie() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Double-Array Trie ------------------" << endl;
+    {
+        const char* keys[] = { "the", "a", "there", "answer", "any", "by", "bye", "their", "the" };
+        Trie trie;
+        for (auto* s : keys)
+            trie.insert(s, int(strlen(s)));
+
+        DoubleArrayTrie dat(trie);
+        assert(dat.units[dat.find("the")].leafCount == 2);
+        assert(dat.units[dat.find("their")].leafCount == 1);
+        assert(dat.find("these") < 0 && dat.find("th") < 0 && dat.find("") < 0);
+        assert(dat.search("thaw") == make_pair(2, false));
+        assert(dat.search("there") == make_pair(5, true));
+        assert(dat.commonPrefixSearch("therefore") == vector<int>({ 3, 5 }));
+        assert(dat.longestMatch("byes") == 3);
+        assert(dat.longestMatch("cat") == 0);
+        assert(dat.predictiveSearch("th") == vector<string>({ "the", "their", "there" }));
+        assert(dat.predictiveSearch("an") == vector<string>({ "answer", "any" }));
+        assert(dat.predictiveSearch("x").empty());
+    }
+    {
+        int T = 20;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 2000 + 1;
+            int charCnt = RandInt32::get() % 26 + 1;
+
+            Trie trie;
+            TrieAM trieAM;
+            vector<string> keys(N);
+            for (auto& s : keys) {
+                s = makeRandomString(1, 8, charCnt);
+                trie.insert(s);
+                trieAM.insert(s);
+            }
+            sort(keys.begin(), keys.end());
+
+            DoubleArrayTrie dat(trie), datAM(trieAM);
+            assert(dat.units.size() == datAM.units.size());
+
+            for (int i = 0; i < 200; i++) {
+                string s = makeRandomString(1, 12, charCnt);
+
+                assert(dat.search(s) == trie.search(s));
+                assert(datAM.search(s) == trie.search(s));
+                auto* node = trie.find(s);
+                int p = dat.find(s);
+                assert((node == nullptr) == (p < 0) && (p < 0 || dat.units[p].leafCount == node->leafCount));
+
+                vector<int> gt;
+                for (int len = 1; len <= int(s.length()); len++) {
+                    if (binary_search(keys.begin(), keys.end(), s.substr(0, len)))
+                        gt.push_back(len);
+                }
+                assert(dat.commonPrefixSearch(s) == gt);
+                assert(dat.longestMatch(s) == (gt.empty() ? 0 : gt.back()));
+
+                string prefix = s.substr(0, RandInt32::get() % 3 + 1);
+                vector<string> gtWords;
+                for (auto it = lower_bound(keys.begin(), keys.end(), prefix);
+                     it != keys.end() && it->compare(0, prefix.length(), prefix) == 0; ++it) {
+                    if (gtWords.empty() || gtWords.back() != *it)
+                        gtWords.push_back(*it);
+                }
+                assert(dat.predictiveSearch(prefix) == gtWords);
+            }
+        }
+    }
+    cout << "*** Speed & memory test ***" << endl;
+    {
+        int N = 1000000;
+        int Q = 10000000;
+#ifdef _DEBUG
+        N = 10000;
+        Q = 100000;
+#endif
+        vector<string> keys(N);
+        for (auto& s : keys)
+            s = makeRandomString(3, 12);
+
+        vector<string> queries(100000);
+        for (int i = 0; i < int(queries.size()); i++)
+            queries[i] = (i & 1) ? keys[RandInt32::get() % N] : makeRandomString(3, 12);
+
+        Trie* trie = new Trie();
+        for (auto& s : keys)
+            trie->insert(s);
+
+        PROFILE_START(0);
+        DoubleArrayTrie dat(*trie);
+        PROFILE_STOP(0);
+
+        int nodeN = dat.size();
+        for (auto& u : dat.units)
+            nodeN -= (u.check < 0);
+        cout << "N = " << N << ", nodes = " << nodeN << ", units = " << dat.size() << endl;
+        cout << "  Trie : about " << double(sizeof(Trie::Node)) * nodeN / N << " bytes per key" << endl;
+        cout << "  DoubleArrayTrie : " << double(dat.memoryBytes()) / N << " bytes per key" << endl;
+
+        int res1 = 0, res2 = 0;
+        cout << "  Trie::search() : ";
+        PROFILE_START(1);
+        for (int i = 0; i < Q; i++)
+            res1 += trie->search(queries[i % queries.size()]).first;
+        PROFILE_STOP(1);
+
+        cout << "  DoubleArrayTrie::search() : ";
+        PROFILE_START(2);
+        for (int i = 0; i < Q; i++)
+            res2 += dat.search(queries[i % queries.size()]).first;
+        PROFILE_STOP(2);
+        assert(res1 == res2);
+
+        delete trie;
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "trieAM.h"
+
+//--- Double-Array Trie -------------------------------------------------------
+// Static trie in one array, built from Trie or TrieAM
+//  - the child of node s by character index c is t = unit[s].base + c if unit[t].check == s,
+//    so a transition reads one 12-byte unit instead of chasing a pointer to a separately allocated node
+//  - bases are found by first-fit over a list of free units in DFS order,
+//    so the array is dense and the units of a word are close to each other
+//  - the same characters as Trie ('a' ~ 'z'), and the same word counts (leafCount)
+
+struct DoubleArrayTrie {
+    static const int MaxCharN = int(Trie::MaxCharN);
+    static int ch2i(char ch) {
+        return Trie::ch2i(ch);
+    }
+
+    struct Unit {
+        int     base;       // the children are at base + c
+        int     check;      // the parent, -1 if the unit is free
+        int     leafCount;  // the number of the word ending at this node, 0 if not a word
+    };
+
+    vector<Unit> units;     // units[0] is the root
+
+    DoubleArrayTrie() {
+        clear();
+    }
+
+    explicit DoubleArrayTrie(const Trie& trie) {
+        build(trie);
+    }
+
+    explicit DoubleArrayTrie(const TrieAM& trie) {
+        build(trie);
+    }
+
+    void clear() {
+        units.assign(1, Unit{ 1, 0, 0 });
+    }
+
+    void build(const Trie& trie) {
+        build(&trie.mRoot, [](const Trie::Node* p, int c) -> const Trie::Node* {
+            return p->children[c];
+        });
+    }
+
+    void build(const TrieAM& trie) {
+        build(&trie.mRoot, [](const TrieAM::Node* p, int c) -> const TrieAM::Node* {
+            return p->getChild(c);
+        });
+    }
+
+    // keys of 'a' ~ 'z'
+    void build(const vector<string>& keys) {
+        Trie trie;
+        for (auto& s : keys)
+            trie.insert(s);
+        build(trie);
+    }
+
+
+    int size() const {
+        return int(units.size());
+    }
+
+    size_t memoryBytes() const {
+        return units.capacity() * sizeof(Unit);
+    }
+
+    // the child of node s, -1 if not exists
+    int getChild(int s, int chIdx) const {
+        if (unsigned(chIdx) >= unsigned(MaxCharN))
+            return -1;
+        int t = units[s].base + chIdx;
+        return (t < int(units.size()) && units[t].check == s) ? t : -1;
+    }
+
+    // return the node of an exactly matched word, -1 if not exists
+    int find(const string& s) const {
+        return find(s.data(), int(s.length()));
+    }
+
+    // return the node of an exactly matched word, -1 if not exists
+    int find(const char* s, int len) const {
+        if (len <= 0)
+            return -1;
+
+        int p = 0;
+        for (int i = 0; i < len && p >= 0; i++)
+            p = getChild(p, ch2i(s[i]));
+        return (p >= 0 && units[p].leafCount > 0) ? p : -1;
+    }
+
+    // prefix matching, the same as Trie::search()
+    // return (prefix_matching_length, word_matched?)
+    pair<int, bool> search(const string& s) const {
+        return search(s.data(), int(s.length()));
+    }
+
+    // prefix matching
+    // return (prefix_matching_length, word_matched?)
+    pair<int, bool> search(const char* s, int len) const {
+        if (len <= 0)
+            return make_pair(0, false);
+
+        int p = 0;
+        for (int i = 0; i < len; i++) {
+            p = getChild(p, ch2i(s[i]));
+            if (p < 0)
+                return make_pair(i, false);
+        }
+        return make_pair(len, units[p].leafCount > 0);
+    }
+
+    // the lengths of all words that are prefixes of s, in increasing order
+    vector<int> commonPrefixSearch(const string& s) const {
+        return commonPrefixSearch(s.data(), int(s.length()));
+    }
+
+    vector<int> commonPrefixSearch(const char* s, int len) const {
+        vector<int> res;
+        int p = 0;
+        for (int i = 0; i < len; i++) {
+            p = getChild(p, ch2i(s[i]));
+            if (p < 0)
+                break;
+            if (units[p].leafCount > 0)
+                res.push_back(i + 1);
+        }
+        return res;
+    }
+
+    // the length of the longest word that is a prefix of s, 0 if not exists
+    int longestMatch(const string& s) const {
+        return longestMatch(s.data(), int(s.length()));
+    }
+
+    int longestMatch(const char* s, int len) const {
+        int res = 0;
+        int p = 0;
+        for (int i = 0; i < len; i++) {
+            p = getChild(p, ch2i(s[i]));
+            if (p < 0)
+                break;
+            if (units[p].leafCount > 0)
+                res = i + 1;
+        }
+        return res;
+    }
+
+    // all words starting with 'prefix', in lexicographical order
+    vector<string> predictiveSearch(const string& prefix, int maxCount = INT_MAX) const {
+        vector<string> res;
+        int p = 0;
+        for (int i = 0; i < int(prefix.length()) && p >= 0; i++)
+            p = getChild(p, ch2i(prefix[i]));
+        if (p >= 0) {
+            string s = prefix;
+            predictiveSearch(p, s, res, maxCount);
+        }
+        return res;
+    }
+
+private:
+    template <typename NodeT, typename ChildF>
+    void build(const NodeT* root, ChildF childOf) {
+        units.assign(1, Unit{ 1, 0, 0 });
+
+        // free units are linked in a circular list through nextFree/prevFree, 0 is the head
+        vector<int> nextFree(1, 0), prevFree(1, 0);
+        auto grow = [this, &nextFree, &prevFree](int n) {
+            int first = int(units.size());
+            n = max(n, first * 2);
+            units.resize(n, Unit{ 1, -1, 0 });
+            nextFree.resize(n);
+            prevFree.resize(n);
+            for (int i = first; i < n; i++) {
+                nextFree[i] = (i + 1 < n) ? i + 1 : 0;
+                prevFree[i] = i - 1;
+            }
+            prevFree[first] = prevFree[0];
+            nextFree[prevFree[0]] = first;
+            prevFree[0] = n - 1;
+        };
+        grow(MaxCharN + 1);
+
+        int children[MaxCharN];
+
+        vector<pair<const NodeT*, int>> st;
+        st.emplace_back(root, 0);
+        while (!st.empty()) {
+            const NodeT* p = st.back().first;
+            int s = st.back().second;
+            st.pop_back();
+
+            int n = 0;
+            for (int c = 0; c < MaxCharN; c++) {
+                if (childOf(p, c))
+                    children[n++] = c;
+            }
+            if (n == 0)
+                continue;
+
+            // first-fit over free units, children[0] goes to a free unit e and the others are checked
+            int base;
+            int e = nextFree[0];
+            while (true) {
+                if (e == 0) {
+                    e = int(units.size());
+                    grow(e + MaxCharN + 1);
+                }
+                base = e - children[0];
+                if (base >= 1) {
+                    if (base + MaxCharN >= int(units.size()))
+                        grow(base + MaxCharN + 1);
+
+                    int i = 1;
+                    while (i < n && units[base + children[i]].check < 0)
+                        i++;
+                    if (i == n)
+                        break;
+                }
+                e = nextFree[e];
+            }
+
+            units[s].base = base;
+            for (int i = n - 1; i >= 0; i--) {
+                const NodeT* child = childOf(p, children[i]);
+                int t = base + children[i];
+                units[t].check = s;
+                units[t].leafCount = child->leafCount;
+                nextFree[prevFree[t]] = nextFree[t];
+                prevFree[nextFree[t]] = prevFree[t];
+                st.emplace_back(child, t);
+            }
+        }
+
+        // remove free units at the end
+        int last = int(units.size()) - 1;
+        while (last > 0 && units[last].check < 0)
+            last--;
+        units.resize(last + 1);
+        units.shrink_to_fit();
+    }
+
+    void predictiveSearch(int p, string& s, vector<string>& res, int maxCount) const {
+        if (int(res.size()) >= maxCount)
+            return;
+        if (units[p].leafCount > 0)
+            res.push_back(s);
+        for (int c = 0; c < MaxCharN; c++) {
+            int t = getChild(p, c);
+            if (t >= 0) {
+                s.push_back(char('a' + c));
+                predictiveSearch(t, s, res, maxCount);
+                s.pop_back();
+            }
+        }
+    }
+};
@@ -7,18 +7,23 @@ using namespace std;
 
 int main(void) {
     TEST(SuffixArray);
+    TEST(SuffixArraySAIS);
     TEST(SimpleSuffixArray);
     TEST(LcpArraySparseTable);
     TEST(SuffixSparseTable);
     TEST(SuffixAutomation);
     TEST(SuffixAutomationAM);
+    TEST(SuffixAutomatonCompact);
     TEST(SuffixTrie);
     TEST(SuffixTrieAM);
     TEST(SuffixTree);
+    TEST(SuffixTreeCompact);
     TEST(SuffixTreeAlgo);
     TEST(Trie);
     TEST(TrieAM);
+    TEST(DoubleArrayTrie);
     TEST(AhoCorasickAM);
+    TEST(AhoCorasickDFA);
     TEST(CompressedTrie);
     TEST(CompressedTrieAM);
     TEST(DistinctSubstringCounter);
@@ -32,6 +37,7 @@ int main(void) {
     TEST(SearchPrefixFunction);
     TEST(SearchRabinKarp);
     TEST(SearchZAlgorithm);
+    TEST(SearchParallel);
     TEST(PrefixFunction);
     TEST(Subsequence);
     TEST(SubsequenceLCS);
@@ -0,0 +1,113 @@
+#include <cstring>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+#include "searchParallel.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <ctime>
+#include <chrono>
+#include <cstdio>
+#include <cassert>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/rand.h"
+
+static string makeRandomString(int n, int charCnt, int charMin = 'a') {
+    string s;
+    s.reserve(n);
+    for (int i = 0; i < n; i++)
+        s.push_back(char(RandInt32::get() % charCnt + charMin));
+    return s;
+}
+
+static vector<long long> searchNaive(const string& text, const string& pattern) {
+    vector<long long> res;
+    if (pattern.empty())
+        return res;
+    for (size_t i = text.find(pattern); i != string::npos; i = text.find(pattern, i + 1))
+        res.push_back((long long)i);
+    return res;
+}
+
+void testSearchParallel() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    static const SearchAlgorithm algorithms[] = { SEARCH_KMP, SEARCH_Z, SEARCH_RABIN_KARP, SEARCH_RABIN_KARP2 };
+    static const char* names[] = { "KMP", "Z", "Rabin-Karp", "Rabin-Karp2" };
+
+    cout << "-- Parallel Chunked Search ---------" << endl;
+    {
+        // the single-threaded searchers
+        string S = "aabaacaadaabaaba", key = "aaba";
+        vector<int> gt{ 0, 9, 12 };
+        assert(kmp(S, key) == gt && searchZ(S, key) == gt);
+        assert(searchRabinKarp(S, key) == gt && searchRabinKarp2(S, key) == gt);
+        assert(searchZ("a$b", "$") == vector<int>{ 1 });
+        assert(searchRabinKarp("ab", "abc").empty() && searchRabinKarp2("ab", "abc").empty());
+    }
+    {
+        int T = 100;
+        while (T-- > 0) {
+            int charCnt = RandInt32::get() % 3 + 1;
+            string text = makeRandomString(RandInt32::get() % 5000, charCnt);
+            string pattern = makeRandomString(RandInt32::get() % 8 + 1, charCnt);
+            auto gt = searchNaive(text, pattern);
+
+            int threadCount = RandInt32::get() % 4 + 1;
+            int chunkSize = (T & 1) ? int(RandInt32::get() % 20 + 1) : int(RandInt32::get() % 2000 + 1);
+            for (auto algo : algorithms)
+                assert(searchParallel(text, pattern, algo, threadCount, chunkSize) == gt);
+        }
+    }
+    cout << "*** memory-mapped file ***" << endl;
+    {
+        string text = makeRandomString(100000, 2);
+        string pattern = "abbab";
+        auto gt = searchNaive(text, pattern);
+
+        const char* path = "searchParallel_text.txt";
+        FILE* fp = fopen(path, "wb");
+        assert(fp != nullptr);
+        fwrite(text.data(), 1, text.length(), fp);
+        fclose(fp);
+
+        vector<long long> ans;
+        for (auto algo : algorithms) {
+            assert(searchFileParallel(ans, path, pattern, algo, 3, 1000));
+            assert(ans == gt);
+        }
+        remove(path);
+        assert(!searchFileParallel(ans, "searchParallel_not_exist.txt", pattern) && ans.empty());
+    }
+    cout << "*** Speed test ***" << endl;
+    {
+        int N = 200000000;
+#ifdef _DEBUG
+        N = 1000000;
+#endif
+        string text = makeRandomString(N, 4);
+        string pattern = makeRandomString(12, 4);
+        int threadN = max(1, int(thread::hardware_concurrency()));
+
+        clock_t start = clock();
+        auto gt = kmp(text, pattern);
+        cout << "kmp() : " << double(clock() - start) / CLOCKS_PER_SEC << " sec, " << gt.size() << " matches" << endl;
+
+        for (int i = 0; i < 4; i++) {
+            for (int threadCount = 1; threadCount <= threadN; threadCount *= 2) {
+                auto t0 = chrono::steady_clock::now();
+                auto ans = searchParallel(text, pattern, algorithms[i], threadCount);
+                double sec = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+                cout << "  " << names[i] << ", " << threadCount << " threads : " << sec << " sec" << endl;
+                assert(ans.size() == gt.size() && equal(gt.begin(), gt.end(), ans.begin()));
+            }
+        }
+    }
+
+    cout << "OK!" << endl;
+}
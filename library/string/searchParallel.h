@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+
+#include "../common/parallelFor.h"
+#include "../common/mappedFile.h"
+#include "searchPrefixFunction.h"
+#include "searchZAlgorithm.h"
+#include "searchRabinKarp.h"
+
+// Multi-threaded single pattern search over a large text
+//  - the text is split into chunks of 'chunkSize' bytes, and a chunk is searched with the next (M - 1) bytes,
+//    so a match is found in the chunk where it starts, exactly once
+//  - 'threadCount' workers take the next chunk from a shared counter until all chunks are done,
+//    and the results of chunks are merged in the order of positions
+//  - the text can be a memory-mapped file (MappedFile), it's not copied into a string
+//  - positions are 64-bit, a text can be larger than 2 GB
+
+enum SearchAlgorithm {
+    SEARCH_KMP,
+    SEARCH_Z,
+    SEARCH_RABIN_KARP,                  // lowercase alphabet only
+    SEARCH_RABIN_KARP2,
+};
+
+const int SEARCH_PARALLEL_CHUNK_SIZE = 1 << 22;
+
+// f(chunk, chunk_length) returns the start positions of matches in the chunk (vector<int>)
+template <typename F>
+inline vector<long long> searchChunksParallel(const char* text, long long N, int M, F f,
+                                              int threadCount = 0, int chunkSize = SEARCH_PARALLEL_CHUNK_SIZE) {
+    vector<long long> res;
+    if (M <= 0 || N < M)
+        return res;
+
+    if (threadCount <= 0)
+        threadCount = max(1, int(thread::hardware_concurrency()));
+    chunkSize = max(chunkSize, 1);
+
+    // chunk k is [k * chunkSize, (k + 1) * chunkSize + M - 1), a match starts in [0, N - M]
+    long long startN = N - M + 1;
+    int chunkN = int((startN + chunkSize - 1) / chunkSize);
+    vector<vector<int>> chunkRes(chunkN);
+
+    atomic<int> next(0);
+    parallelFor(threadCount, threadCount, [&](int tFirst, int tLast) {
+        for (int t = tFirst; t < tLast; t++) {
+            int k;
+            while ((k = next.fetch_add(1)) < chunkN) {
+                long long first = (long long)k * chunkSize;
+                long long last = min(N, first + chunkSize + M - 1);
+                chunkRes[k] = f(text + first, int(last - first));
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (auto& v : chunkRes)
+        total += v.size();
+    res.reserve(total);
+    for (int k = 0; k < chunkN; k++) {
+        long long first = (long long)k * chunkSize;
+        for (int pos : chunkRes[k])
+            res.push_back(first + pos);
+        vector<int>().swap(chunkRes[k]);
+    }
+    return res;
+}
+
+// return the start positions of 'pattern' in text[0..N)
+inline vector<long long> searchParallel(const char* text, long long N, const string& pattern,
+                                        SearchAlgorithm algorithm = SEARCH_KMP,
+                                        int threadCount = 0, int chunkSize = SEARCH_PARALLEL_CHUNK_SIZE) {
+    const char* p = pattern.data();
+    int M = int(pattern.length());
+    if (M <= 0)
+        return vector<long long>();
+
+    switch (algorithm) {
+    case SEARCH_Z: {
+        vector<int> Z = makeZArray(pattern);
+        return searchChunksParallel(text, N, M, [p, M, &Z](const char* s, int len) {
+            return searchZ(s, len, p, M, Z);
+        }, threadCount, chunkSize);
+    }
+    case SEARCH_RABIN_KARP:
+        return searchChunksParallel(text, N, M, [p, M](const char* s, int len) {
+            return searchRabinKarp(s, len, p, M);
+        }, threadCount, chunkSize);
+    case SEARCH_RABIN_KARP2:
+        return searchChunksParallel(text, N, M, [p, M](const char* s, int len) {
+            return searchRabinKarp2(s, len, p, M);
+        }, threadCount, chunkSize);
+    default: {
+        vector<int> prefix = prefixFunction(pattern);
+        return searchChunksParallel(text, N, M, [p, M, &prefix](const char* s, int len) {
+            return kmp(s, len, p, M, prefix);
+        }, threadCount, chunkSize);
+    }
+    }
+}
+
+inline vector<long long> searchParallel(const string& text, const string& pattern,
+                                        SearchAlgorithm algorithm = SEARCH_KMP,
+                                        int threadCount = 0, int chunkSize = SEARCH_PARALLEL_CHUNK_SIZE) {
+    return searchParallel(text.data(), (long long)text.length(), pattern, algorithm, threadCount, chunkSize);
+}
+
+// searches a file mapped into memory (read into memory if it can't be mapped)
+// return false if the file can't be opened or is empty
+inline bool searchFileParallel(vector<long long>& res, const char* path, const string& pattern,
+                               SearchAlgorithm algorithm = SEARCH_KMP,
+                               int threadCount = 0, int chunkSize = SEARCH_PARALLEL_CHUNK_SIZE) {
+    res.clear();
+
+    MappedFile file;
+    if (!file.open(path))
+        return false;
+    res = searchParallel(file.data, (long long)file.size, pattern, algorithm, threadCount, chunkSize);
+    return true;
+}
@@ -43,7 +43,7 @@ inline pair<int, int> checkRepeatedString(const vector<int>& prefix, int len) {
     return make_pair(-1, -1);
 }
 
-pair<int, int> checkRepeatedString(string s) {
+inline pair<int, int> checkRepeatedString(string s) {
     return checkRepeatedString(prefixFunction(s), int(s.length()));
 }
 
@@ -138,10 +138,13 @@ inline vector<int> kmp(const string& s, const string& p) {
     return res;
 }
 
-inline vector<int> kmp(const string& s, const string& p, const vector<int>& prefix) {
+// s[0..n) and p[0..m), prefix = prefixFunction(p)
+inline vector<int> kmp(const char* s, int n, const char* p, int m, const vector<int>& prefix) {
     vector<int> res;
+    if (m <= 0)
+        return res;
 
-    int n = int(s.size()), m = int(p.size()), j = 0;
+    int j = 0;
     for (int i = 0; i < n; i++) {
         while (j > 0 && s[i] != p[j])
             j = prefix[j - 1];
@@ -159,6 +162,10 @@ inline vector<int> kmp(const string& s, const string& p, const vector<int>& pref
     return res;
 }
 
+inline vector<int> kmp(const string& s, const string& p, const vector<int>& prefix) {
+    return kmp(s.data(), int(s.size()), p.data(), int(p.size()), prefix);
+}
+
 //----------------------
 
 inline vector<int> getAllPartialMatch(const string& s) {
@@ -183,7 +190,7 @@ inline vector<int> getAllPartialMatch(const string& s) {
     return res;
 }
 
-vector<int> getPrefixSuffix(const string& s) {
+inline vector<int> getPrefixSuffix(const string& s) {
     vector<int> res, pi = getAllPartialMatch(s);
 
     int n = int(s.length());
@@ -194,7 +201,7 @@ vector<int> getPrefixSuffix(const string& s) {
     return res;
 }
 
-int maxOverlap(const string& a, const string& b) {
+inline int maxOverlap(const string& a, const string& b) {
     int n = int(a.length()), m = int(b.length());
     vector<int> pi = getAllPartialMatch(b);
 
@@ -3,11 +3,11 @@
 //https://www.hackerrank.com/contests/university-codesprint-4/challenges/maximum-permutation
 
 // lowercase alphabet only
-inline vector<int> searchRabinKarp(const string& text, const string& pattern) {
+inline vector<int> searchRabinKarp(const char* text, int N, const char* pattern, int M) {
     const unsigned long long p = 31ll;
 
-    int N = int(text.length());
-    int M = int(pattern.length());
+    if (M <= 0 || N < M)
+        return vector<int>();
 
     unsigned long long dM = 1;
     for (int i = 1; i <= M; i++) // pre-caculate p^M % q for subtraction
@@ -45,12 +45,18 @@ inline vector<int> searchRabinKarp(const string& text, const string& pattern) {
 }
 
 
-inline vector<int> searchRabinKarp2(const string& text, const string& pattern) {
+// lowercase alphabet only
+inline vector<int> searchRabinKarp(const string& text, const string& pattern) {
+    return searchRabinKarp(text.data(), int(text.length()), pattern.data(), int(pattern.length()));
+}
+
+
+inline vector<int> searchRabinKarp2(const char* text, int N, const char* pattern, int M) {
     const long long q = 100000015277ll; //TODO: it can be changed with another value
     const long long d = 3355439ll;      //TODO: it can be changed with another value
 
-    int N = int(text.length());
-    int M = int(pattern.length());
+    if (M <= 0 || N < M)
+        return vector<int>();
 
     long long dM = 1;
     for (int i = 1; i <= M; i++) // pre-caculate d^M % q for subtraction
@@ -88,3 +94,7 @@ inline vector<int> searchRabinKarp2(const string& text, const string& pattern) {
 
     return res;
 }
+
+inline vector<int> searchRabinKarp2(const string& text, const string& pattern) {
+    return searchRabinKarp2(text.data(), int(text.length()), pattern.data(), int(pattern.length()));
+}
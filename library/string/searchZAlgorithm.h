@@ -36,17 +36,31 @@ inline vector<int> makeZArray(const string& s) {
     return makeZArray(&s[0], int(s.length()));
 }
 
-inline vector<int> searchZ(const string& text, const string& pattern) {
+// text[0..N) and pattern[0..M), Z = makeZArray(pattern)
+//  - the Z-box runs over the text with the Z-array of the pattern, without concatenating them
+inline vector<int> searchZ(const char* text, int N, const char* pattern, int M, const vector<int>& Z) {
     vector<int> res;
+    if (M <= 0 || N < M)
+        return res;
 
-    string concat = pattern + "$" + text;
-    int len = int(concat.length());
-
-    vector<int> Z = makeZArray(concat);
-    for (int i = 0; i < len; i++) {
-        if (Z[i] == pattern.length())
-            res.push_back(i - int(pattern.length()) - 1);
+    int L = 0, R = 0;                   // text[L..R) == pattern[0..R-L)
+    for (int i = 0; i <= N - M; i++) {
+        int z = (i < R) ? min(R - i, Z[i - L]) : 0;
+        if (i + z >= R) {
+            while (z < M && text[i + z] == pattern[z])
+                z++;
+            L = i;
+            R = i + z;
+        }
+        if (z == M)
+            res.push_back(i);
     }
 
     return res;
 }
+
+inline vector<int> searchZ(const string& text, const string& pattern) {
+    if (pattern.empty())
+        return vector<int>();
+    return searchZ(text.data(), int(text.length()), pattern.data(), int(pattern.length()), makeZArray(pattern));
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+// Sorted (key, value) arrays in a shared pool, for transitions of a node without a fixed next[] array
+//  - a node keeps the first index of its array (slot) and the number of entries (n),
+//    the array is in a slot of a power-of-2 size and moved to a slot of twice the size when it's full
+//  - freed slots are kept in free lists by their size and reused
+//  - get() returns 0 if there is no key, so 0 must not be a value (the root or state 0)
+//  - used by SuffixAutomatonCompact and SuffixTreeCompact
+template <typename KeyT>
+struct SortedSlotPool {
+    static const int LINEAR_SEARCH_MAX = 16;
+    static const int MAX_SLOT_CLASS = 32;
+
+    vector<KeyT>    keys;           // sorted keys, in slots of power-of-2 sizes
+    vector<int>     values;         //
+    vector<int>     freeSlot;       // free lists of slots by log2(size), linked through values[]
+
+    SortedSlotPool() {
+        init();
+    }
+
+    void init() {
+        keys.clear();
+        values.clear();
+        freeSlot.assign(MAX_SLOT_CLASS, -1);
+    }
+
+    void reserve(size_t n) {
+        keys.reserve(n);
+        values.reserve(n);
+    }
+
+    // the first index i with keys[slot + i] >= key
+    int lowerBound(int slot, int n, KeyT key) const {
+        const KeyT* first = keys.data() + slot;
+        if (n <= LINEAR_SEARCH_MAX) {
+            int i = 0;
+            while (i < n && first[i] < key)
+                i++;
+            return i;
+        }
+        return int(lower_bound(first, first + n, key) - first);
+    }
+
+    int get(int slot, int n, KeyT key) const {
+        int i = lowerBound(slot, n, key);
+        return (i < n && keys[size_t(slot) + i] == key) ? values[size_t(slot) + i] : 0;
+    }
+
+    // adds or replaces the value of 'key', 'slot' and 'n' are updated
+    void set(int& slot, int& n, KeyT key, int value) {
+        int i = lowerBound(slot, n, key);
+        if (i < n && keys[size_t(slot) + i] == key)
+            values[size_t(slot) + i] = value;
+        else
+            insert(slot, n, i, key, value);
+    }
+
+    // inserts (key, value) at i = lowerBound(slot, n, key), 'slot' and 'n' are updated
+    void insert(int& slot, int& n, int i, KeyT key, int value) {
+        if (n == slotSize(n)) {
+            // move to a slot of twice the size
+            int newSlot = alloc(slotClass(n + 1));
+            copy(keys.begin() + slot, keys.begin() + slot + n, keys.begin() + newSlot);
+            copy(values.begin() + slot, values.begin() + slot + n, values.begin() + newSlot);
+            if (n > 0)
+                release(slot, n);
+            slot = newSlot;
+        }
+        size_t first = size_t(slot);
+        copy_backward(keys.begin() + first + i, keys.begin() + first + n, keys.begin() + first + n + 1);
+        copy_backward(values.begin() + first + i, values.begin() + first + n, values.begin() + first + n + 1);
+        keys[first + i] = key;
+        values[first + i] = value;
+        n++;
+    }
+
+    // a new slot with a copy of the array (n > 0)
+    int clone(int slot, int n) {
+        int res = alloc(slotClass(n));
+        copy(keys.begin() + slot, keys.begin() + slot + n, keys.begin() + res);
+        copy(values.begin() + slot, values.begin() + slot + n, values.begin() + res);
+        return res;
+    }
+
+    // frees the slot of n entries (n > 0)
+    void release(int slot, int n) {
+        int k = slotClass(n);
+        values[slot] = freeSlot[k];
+        freeSlot[k] = slot;
+    }
+
+    size_t memoryBytes() const {
+        return keys.capacity() * sizeof(KeyT) + values.capacity() * sizeof(int);
+    }
+
+    void shrinkToFit() {
+        keys.shrink_to_fit();
+        values.shrink_to_fit();
+    }
+
+private:
+    // log2 of the slot size for n entries (n > 0)
+    static int slotClass(int n) {
+        int k = 0;
+        while ((1 << k) < n)
+            k++;
+        return k;
+    }
+
+    // the slot size of n entries, 0 for no entries
+    static int slotSize(int n) {
+        return (n == 0) ? 0 : (1 << slotClass(n));
+    }
+
+    int alloc(int k) {
+        int slot = freeSlot[k];
+        if (slot >= 0) {
+            freeSlot[k] = values[slot];
+            return slot;
+        }
+        slot = int(values.size());
+        keys.resize(keys.size() + (size_t(1) << k));
+        values.resize(values.size() + (size_t(1) << k));
+        return slot;
+    }
+};
@@ -0,0 +1,133 @@
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+#include "suffixArray.h"
+#include "suffixArraySAIS.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <cassert>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+static string makeRandomString(int n, int charCnt) {
+    string s;
+    s.reserve(n);
+    for (int i = 0; i < n; i++)
+        s.push_back(RandInt32::get() % charCnt + 'a');
+    return s;
+}
+
+template <typename CharT>
+static vector<int> makeSuffixArrayNaive(const vector<CharT>& s) {
+    int n = int(s.size());
+    vector<int> res(n);
+    for (int i = 0; i < n; i++)
+        res[i] = i;
+    sort(res.begin(), res.end(), [&s](int a, int b) {
+        return lexicographical_compare(s.begin() + a, s.end(), s.begin() + b, s.end());
+    });
+    return res;
+}
+
+void testSuffixArraySAIS() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Suffix Array with SA-IS ------------------" << endl;
+    {
+        for (string s : { "", "a", "aa", "ab", "ba", "aaaaaaaa", "abababab", "mississippi", "abracadabra", "zyxwvut" }) {
+            auto SA = SuffixArraySAIS<>::buildSuffixArray(s);
+            assert(SA == SuffixArray::buildSuffixArray(s, 'a', 'z'));
+            assert(SuffixArraySAIS<>::buildLcpArray(SA, s) == SuffixArray::buildLcpArray(SA, s));
+        }
+    }
+    {
+        int T = 100;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 2000 + 1;
+            int charCnt = RandInt32::get() % 26 + 1;
+            string s = makeRandomString(N, charCnt);
+
+            auto SA = SuffixArraySAIS<>::buildSuffixArray(s);
+            auto gt = SuffixArray::buildSuffixArray(s, 'a', 'z');
+            assert(SA == gt);
+
+            auto lcpGT = SuffixArray::buildLcpArray(gt, s);
+            for (int sampleRate : { 1, 3, 32, 100 })
+                assert(SuffixArraySAIS<>::buildLcpArray(SA, s, sampleRate) == lcpGT);
+
+            auto SA64 = SuffixArraySAIS<long long>::buildSuffixArray(s);
+            assert(equal(SA64.begin(), SA64.end(), SA.begin()));
+            auto lcp64 = SuffixArraySAIS<long long>::buildLcpArray(SA64, s);
+            assert(equal(lcp64.begin(), lcp64.end(), lcpGT.begin()));
+        }
+    }
+    cout << "*** integer alphabet ***" << endl;
+    {
+        int T = 100;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 1000 + 1;
+            int K = (T & 1) ? int(RandInt32::get() % 4 + 1) : int(RandInt32::get() % 1000000 + 1);
+            vector<int> s(N);
+            for (int i = 0; i < N; i++)
+                s[i] = RandInt32::get() % K;
+
+            auto SA = SuffixArraySAIS<>::buildSuffixArray(s, K);
+            assert(SA == makeSuffixArrayNaive(s));
+
+            vector<int> lcp;
+            SuffixArraySAIS<>::scanLcpArray(SA, s.data(), N, [&lcp](int i, int h) {
+                assert(i == int(lcp.size()));
+                lcp.push_back(h);
+            });
+            for (int i = 1; i < N; i++) {
+                int h = 0;
+                while (SA[i] + h < N && SA[i - 1] + h < N && s[SA[i] + h] == s[SA[i - 1] + h])
+                    h++;
+                assert(lcp[i] == h);
+            }
+        }
+    }
+    cout << "*** Speed test ***" << endl;
+    {
+        int N = 10000000;
+#ifdef _DEBUG
+        N = 100000;
+#endif
+        for (int charCnt : { 2, 4, 26 }) {
+            string s = makeRandomString(N, charCnt);
+            cout << "N = " << N << ", characters = " << charCnt << endl;
+
+            vector<int> SA1, SA2;
+            cout << "  prefix doubling : ";
+            PROFILE_START(0);
+            SA1 = SuffixArray::buildSuffixArray(s, 'a', 'z');
+            PROFILE_STOP(0);
+
+            cout << "  SA-IS : ";
+            PROFILE_START(1);
+            SA2 = SuffixArraySAIS<>::buildSuffixArray(s);
+            PROFILE_STOP(1);
+            assert(SA1 == SA2);
+
+            vector<int> lcp1, lcp2;
+            cout << "  Kasai : ";
+            PROFILE_START(2);
+            lcp1 = SuffixArray::buildLcpArray(SA1, s);
+            PROFILE_STOP(2);
+
+            cout << "  sparse PHI : ";
+            PROFILE_START(3);
+            lcp2 = SuffixArraySAIS<>::buildLcpArray(SA2, s);
+            PROFILE_STOP(3);
+            assert(lcp1 == lcp2);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,216 @@
+#pragma once
+
+//--------- Building Suffix Array with SA-IS -----------------------------------
+// SA-IS (Nong, Zhang and Chan), O(N)
+//  - characters are integers in [0, alphabetSize), so bytes, tokens and large alphabets are all supported
+//  - IndexT is int or long long, long long for N >= 2^31
+//  - the string has no sentinel, a virtual sentinel smaller than all characters is assumed after it
+//  - the reduced problem is solved in the space of the result, so the extra memory is
+//    at most 2N bits of types and the buckets of one level, max(alphabetSize, N / 2) indexes
+//  - the result is the same as SuffixArray::buildSuffixArray()
+template <typename IndexT = int>
+struct SuffixArraySAIS {
+    // O(N), 0 <= s[i] < alphabetSize
+    template <typename CharT>
+    static vector<IndexT> buildSuffixArray(const CharT* s, IndexT n, IndexT alphabetSize) {
+        vector<IndexT> SA(n);
+        sais(s, SA.data(), n, alphabetSize);
+        return SA;
+    }
+
+    template <typename CharT>
+    static vector<IndexT> buildSuffixArray(const vector<CharT>& s, IndexT alphabetSize) {
+        return buildSuffixArray(s.data(), IndexT(s.size()), alphabetSize);
+    }
+
+    // all 256 byte values
+    static vector<IndexT> buildSuffixArray(const char* s, IndexT n) {
+        return buildSuffixArray(reinterpret_cast<const unsigned char*>(s), n, IndexT(256));
+    }
+
+    static vector<IndexT> buildSuffixArray(const string& s) {
+        return buildSuffixArray(s.data(), IndexT(s.length()));
+    }
+
+    //------------------------------------------------------------------------
+
+    // Φ algorithm with sparse PLCP (Karkkainen, Manzini and Puglisi), O(N * sampleRate)
+    //  - PLCP[j] = LCP(j, the previous suffix of j in SA) is kept at every sampleRate-th j only,
+    //    and the others are extended from the lower bound PLCP[j] >= PLCP[j - d] - d
+    //  - f(i, lcp) is called in the order of i = 0, 1, ..., N - 1 with lcp = LCP(SA[i - 1], SA[i]), 0 at i = 0,
+    //    so the LCP array can be streamed out without storing it
+    //  - the extra memory is N / sampleRate indexes (no rank array)
+    template <typename CharT, typename F>
+    static void scanLcpArray(const vector<IndexT>& SA, const CharT* s, IndexT n, F f, int sampleRate = 32) {
+        IndexT q = IndexT(sampleRate);
+        vector<IndexT> plcp((n + q - 1) / q);
+        for (IndexT i = 0; i < n; i++) {
+            if (SA[i] % q == 0)
+                plcp[SA[i] / q] = (i > 0) ? SA[i - 1] : IndexT(-1);
+        }
+
+        // PLCP[j + q] >= PLCP[j] - q
+        IndexT h = 0;
+        for (IndexT k = 0, j = 0; j < n; k++, j += q) {
+            IndexT p = plcp[k];
+            if (p < 0)
+                h = 0;
+            else {
+                while (j + h < n && p + h < n && s[j + h] == s[p + h])
+                    h++;
+            }
+            plcp[k] = h;
+            h = (h > q) ? h - q : 0;
+        }
+
+        if (n > 0)
+            f(IndexT(0), IndexT(0));
+        for (IndexT i = 1; i < n; i++) {
+            IndexT j = SA[i], p = SA[i - 1];
+            IndexT d = j % q;
+            IndexT h = (plcp[j / q] > d) ? plcp[j / q] - d : 0;
+            while (j + h < n && p + h < n && s[j + h] == s[p + h])
+                h++;
+            f(i, h);
+        }
+    }
+
+    // the same as SuffixArray::buildLcpArray(), lcp[i] = LCP(SA[i - 1], SA[i])
+    template <typename CharT>
+    static vector<IndexT> buildLcpArray(const vector<IndexT>& SA, const CharT* s, IndexT n, int sampleRate = 32) {
+        vector<IndexT> lcp(n);
+        scanLcpArray(SA, s, n, [&lcp](IndexT i, IndexT h) {
+            lcp[i] = h;
+        }, sampleRate);
+        return lcp;
+    }
+
+    template <typename CharT>
+    static vector<IndexT> buildLcpArray(const vector<IndexT>& SA, const vector<CharT>& s, int sampleRate = 32) {
+        return buildLcpArray(SA, s.data(), IndexT(s.size()), sampleRate);
+    }
+
+    static vector<IndexT> buildLcpArray(const vector<IndexT>& SA, const string& s, int sampleRate = 32) {
+        return buildLcpArray(SA, reinterpret_cast<const unsigned char*>(s.data()), IndexT(s.length()), sampleRate);
+    }
+
+private:
+    template <typename CharT>
+    static void sais(const CharT* s, IndexT* SA, IndexT n, IndexT K) {
+        if (n <= 1) {
+            if (n == 1)
+                SA[0] = 0;
+            return;
+        }
+
+        // isS[i] = suffix i is S-type (smaller than suffix i + 1), the last suffix is L-type by the sentinel
+        vector<bool> isS(n);
+        for (IndexT i = n - 2; i >= 0; i--)
+            isS[i] = (s[i] < s[i + 1]) || (s[i] == s[i + 1] && isS[i + 1]);
+        auto isLMS = [&isS](IndexT i) {
+            return i > 0 && isS[i] && !isS[i - 1];
+        };
+
+        vector<IndexT> bucket(K);
+
+        //--- step 1: sort LMS-substrings by induced sorting
+        fill(SA, SA + n, IndexT(-1));
+        getBuckets(s, n, bucket, true);
+        for (IndexT i = 1; i < n; i++) {
+            if (isLMS(i))
+                SA[--bucket[s[i]]] = i;
+        }
+        induce(s, SA, n, isS, bucket);
+
+        // move sorted LMS-substrings to the front
+        IndexT n1 = 0;
+        for (IndexT i = 0; i < n; i++) {
+            if (isLMS(SA[i]))
+                SA[n1++] = SA[i];
+        }
+
+        // name LMS-substrings, LMS positions are not adjacent, so SA[n1 + pos / 2] doesn't collide
+        fill(SA + n1, SA + n, IndexT(-1));
+        IndexT name = 0, prev = -1;
+        for (IndexT i = 0; i < n1; i++) {
+            IndexT pos = SA[i];
+            bool diff = (prev < 0);
+            for (IndexT d = 0; !diff; d++) {
+                if (pos + d == n || prev + d == n || s[pos + d] != s[prev + d] || isS[pos + d] != isS[prev + d])
+                    diff = true;
+                else if (d > 0 && (isLMS(pos + d) || isLMS(prev + d)))
+                    break;
+            }
+            if (diff) {
+                name++;
+                prev = pos;
+            }
+            SA[n1 + pos / 2] = name - 1;
+        }
+        for (IndexT i = n - 1, j = n - 1; i >= n1; i--) {
+            if (SA[i] >= 0)
+                SA[j--] = SA[i];
+        }
+
+        //--- step 2: sort LMS-suffixes by the reduced string at the end of SA
+        IndexT* s1 = SA + n - n1;
+        if (name < n1) {
+            vector<IndexT>().swap(bucket);
+            sais(static_cast<const IndexT*>(s1), SA, n1, name);
+            bucket.resize(K);
+        } else {
+            for (IndexT i = 0; i < n1; i++)
+                SA[s1[i]] = i;
+        }
+
+        //--- step 3: sort all suffixes by sorted LMS-suffixes
+        for (IndexT i = 1, j = 0; i < n; i++) {
+            if (isLMS(i))
+                s1[j++] = i;
+        }
+        for (IndexT i = 0; i < n1; i++)
+            SA[i] = s1[SA[i]];
+        fill(SA + n1, SA + n, IndexT(-1));
+
+        getBuckets(s, n, bucket, true);
+        for (IndexT i = n1 - 1; i >= 0; i--) {
+            IndexT j = SA[i];
+            SA[i] = -1;
+            SA[--bucket[s[j]]] = j;
+        }
+        induce(s, SA, n, isS, bucket);
+    }
+
+    // the start or the end (exclusive) of each bucket
+    template <typename CharT>
+    static void getBuckets(const CharT* s, IndexT n, vector<IndexT>& bucket, bool end) {
+        fill(bucket.begin(), bucket.end(), IndexT(0));
+        for (IndexT i = 0; i < n; i++)
+            bucket[s[i]]++;
+
+        IndexT sum = 0;
+        for (auto& it : bucket) {
+            sum += it;
+            it = end ? sum : sum - it;
+        }
+    }
+
+    // L-type suffixes from the left, and then S-type suffixes from the right
+    template <typename CharT>
+    static void induce(const CharT* s, IndexT* SA, IndexT n, const vector<bool>& isS, vector<IndexT>& bucket) {
+        getBuckets(s, n, bucket, false);
+        SA[bucket[s[n - 1]]++] = n - 1;     // the suffix before the sentinel
+        for (IndexT i = 0; i < n; i++) {
+            IndexT j = SA[i] - 1;
+            if (j >= 0 && !isS[j])
+                SA[bucket[s[j]]++] = j;
+        }
+
+        getBuckets(s, n, bucket, true);
+        for (IndexT i = n - 1; i >= 0; i--) {
+            IndexT j = SA[i] - 1;
+            if (j >= 0 && isS[j])
+                SA[--bucket[s[j]]] = j;
+        }
+    }
+};
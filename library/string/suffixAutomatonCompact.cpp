@@ -0,0 +1,187 @@
+#include <memory.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+using namespace std;
+
+#include "suffixAutomaton.h"
+#include "suffixAutomatonCompact.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <ctime>
+#include <cstdio>
+#include <cassert>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/rand.h"
+
+static string makeRandomString(int n, int charCnt, int charMin = 'a') {
+    string s;
+    s.reserve(n);
+    for (int i = 0; i < n; i++)
+        s.push_back(char(RandInt32::get() % charCnt + charMin));
+    return s;
+}
+
+// lines like "2019-05-21 12:34:56 INFO [worker-3] user=1234 op=read bytes=5678\n"
+static string makeLogLines(int n) {
+    static const char* levels[] = { "INFO", "WARN", "DEBUG", "ERROR" };
+    static const char* ops[] = { "read", "write", "open", "close", "stat" };
+
+    string s;
+    s.reserve(n + 128);
+    char line[128];
+    while (int(s.length()) < n) {
+        snprintf(line, sizeof(line), "2019-05-%02d %02d:%02d:%02d %s [worker-%d] user=%d op=%s bytes=%d\n",
+            RandInt32::get() % 31 + 1, RandInt32::get() % 24, RandInt32::get() % 60, RandInt32::get() % 60,
+            levels[RandInt32::get() % 4], RandInt32::get() % 16, RandInt32::get() % 10000,
+            ops[RandInt32::get() % 5], RandInt32::get() % 100000);
+        s += line;
+    }
+    s.resize(n);
+    return s;
+}
+
+template <typename CharT>
+static bool containsNaive(const vector<CharT>& s, const vector<CharT>& pattern) {
+    return search(s.begin(), s.end(), pattern.begin(), pattern.end()) != s.end();
+}
+
+void testSuffixAutomatonCompact() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Suffix Automaton with Compact Transitions ------------------" << endl;
+    {
+        int T = 20;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 1000 + 1;
+            string s = makeRandomString(N, RandInt32::get() % 26 + 1);
+
+            SuffixAutomaton sa(N);
+            sa.extend(s);
+            SuffixAutomatonCompact<> sac;
+            sac.extend(s);
+
+            // the same states in the same order
+            assert(sac.size() == sa.N && sac.last == sa.last);
+            for (int u = 0; u < sa.N; u++) {
+                assert(sac.state[u].len == sa.state[u].len);
+                assert(sac.state[u].suffixLink == sa.state[u].suffixLink);
+                for (int c = 0; c < int(SuffixAutomaton::MaxCharN); c++)
+                    assert(sac.getNext(u, (unsigned char)('a' + c)) == sa.state[u].next[c]);
+            }
+            assert(sac.getTerminals() == sa.getTerminals());
+        }
+    }
+    {
+        // all 256 bytes, dense tables
+        int T = 20;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 2000 + 1;
+            int charCnt = (T & 1) ? 256 : int(RandInt32::get() % 64 + 1);
+            string s = makeRandomString(N, charCnt, 0);
+
+            SuffixAutomatonCompact<> sac;
+            sac.extend(s);
+
+            set<string> substrs;
+            if (N <= 200) {
+                for (int i = 0; i < N; i++) {
+                    for (int j = i; j < N; j++)
+                        substrs.insert(s.substr(i, j - i + 1));
+                }
+                assert(sac.countDistinctSubstrings() == (long long)substrs.size());
+            }
+
+            for (int i = 0; i < 100; i++) {
+                int L = RandInt32::get() % N;
+                int len = RandInt32::get() % min(10, N - L) + 1;
+                assert(sac.contains(s.substr(L, len)));
+
+                string t = makeRandomString(RandInt32::get() % 4 + 1, charCnt, 0);
+                assert(sac.contains(t) == (s.find(t) != string::npos));
+            }
+
+            // transitions are in the order of symbols
+            for (int u = 0; u < sac.size(); u++) {
+                int prev = -1;
+                sac.forEachNext(u, [&prev, &sac, u](unsigned char c, int v) {
+                    assert(int(c) > prev && sac.getNext(u, c) == v);
+                    prev = c;
+                });
+            }
+        }
+    }
+    cout << "*** 32-bit symbols ***" << endl;
+    {
+        int T = 20;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 2000 + 1;
+            unsigned int K = (T & 1) ? 4u : 1000000u;
+            vector<unsigned int> s(N);
+            for (int i = 0; i < N; i++)
+                s[i] = (RandInt32::get() % K) * 4099u;
+
+            SuffixAutomatonCompact<unsigned int> sac;
+            sac.extend(s);
+
+            for (int i = 0; i < 100; i++) {
+                int L = RandInt32::get() % N;
+                int len = RandInt32::get() % min(10, N - L) + 1;
+                vector<unsigned int> t(s.begin() + L, s.begin() + L + len);
+                assert(sac.contains(t));
+
+                t.resize(RandInt32::get() % 3 + 1);
+                for (auto& x : t)
+                    x = (RandInt32::get() % K) * 4099u;
+                assert(sac.contains(t) == containsNaive(s, t));
+            }
+        }
+    }
+    cout << "*** Memory test ***" << endl;
+    {
+        int N = 10000000;
+#ifdef _DEBUG
+        N = 100000;
+#endif
+        cout << "SuffixAutomaton : " << sizeof(SuffixAutomaton::StateT) << " bytes per state, 26 letters only" << endl;
+
+        auto report = [N](const char* name, size_t bytes, int states, double seconds) {
+            cout << "  " << name << " : N = " << N << ", " << states << " states, "
+                 << double(bytes) / states << " bytes per state, "
+                 << double(bytes) / N << " bytes per symbol, " << seconds << " sec" << endl;
+        };
+
+        for (int type = 0; type < 3; type++) {
+            string s = (type == 0) ? makeLogLines(N)
+                     : (type == 1) ? makeRandomString(N, 26)
+                     : makeRandomString(N, 256, 0);
+
+            clock_t start = clock();
+            SuffixAutomatonCompact<> sac;
+            sac.extend(s);
+            sac.shrinkToFit();
+            double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+            report(type == 0 ? "log lines" : type == 1 ? "26 letters" : "random bytes", sac.memoryBytes(), sac.size(), seconds);
+        }
+        {
+            // zipf-like tokens
+            vector<unsigned int> s(N);
+            for (int i = 0; i < N; i++)
+                s[i] = RandInt32::get() % (1u << (RandInt32::get() % 17 + 1));
+
+            clock_t start = clock();
+            SuffixAutomatonCompact<unsigned int> sac;
+            sac.extend(s);
+            sac.shrinkToFit();
+            double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+            report("32-bit tokens", sac.memoryBytes(), sac.size(), seconds);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
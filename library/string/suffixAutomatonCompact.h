@@ -0,0 +1,246 @@
+#pragma once
+
+#include "sortedSlotPool.h"
+
+// Suffix automaton over bytes or 32-bit symbols with compact transitions
+//  - a state has no fixed next[] array, its transitions are a sorted array of (symbol, state)
+//    in a shared SortedSlotPool, and the array is moved to a slot of twice the size when it's full
+//  - with byte symbols (sizeof(CharT) == 1), a state with more than SUFFIX_AUTOMATON_DENSE_THRESHOLD
+//    transitions is promoted to a dense table of 256 states
+//  - freed slots are kept in free lists by their size and reused
+//  - a state is 16 bytes and a transition is sizeof(CharT) + 4 bytes,
+//    so the memory is about 35 ~ 40 bytes per input symbol (SuffixAutomaton is 120 bytes per state)
+//  - getNext() returns 0 if there is no transition (state 0 is never a target), same as SuffixAutomaton
+
+#ifndef SUFFIX_AUTOMATON_DENSE_THRESHOLD
+#define SUFFIX_AUTOMATON_DENSE_THRESHOLD    32
+#endif
+
+// CharT : unsigned char, or an unsigned integer type for large alphabets
+template <typename CharT = unsigned char>
+struct SuffixAutomatonCompact {
+    static const int DENSE_THRESHOLD = SUFFIX_AUTOMATON_DENSE_THRESHOLD;
+    static const int DENSE_SIZE = 256;
+
+    struct StateT {
+        int len;                    // the length of the longest string in a class
+        int suffixLink;             //
+        int edges;                  // the slot of transitions in edgePool, or the dense table in denseNext
+        int edgeCount;              // the number of transitions
+    };
+    vector<StateT> state;           // t0 is zeroth state, other states get numbers 1,2,3,...
+    int last;
+
+    SortedSlotPool<CharT> edgePool; // (symbol, target state) of transitions
+    vector<int> denseNext;          // dense tables, DENSE_SIZE states each
+
+    SuffixAutomatonCompact() {
+        init();
+    }
+
+    // reserves memory for a string of maxN symbols
+    explicit SuffixAutomatonCompact(int maxN) {
+        init();
+        state.reserve(size_t(maxN) * 2);
+        edgePool.reserve(size_t(maxN) * 3);
+    }
+
+    void init() {
+        state.assign(1, StateT{ 0, -1, 0, 0 });
+        last = 0;
+        edgePool.init();
+        denseNext.clear();
+    }
+
+    int size() const {
+        return int(state.size());
+    }
+
+    void extend(CharT c) {
+        int cur = newState(state[last].len + 1);
+
+        // add edge from last nodes into new node
+        int p;
+        for (p = last; p >= 0 && !getNext(p, c); p = state[p].suffixLink)
+            setNext(p, c, cur);
+
+        if (p == -1)
+            state[cur].suffixLink = 0;                              // set new node's suffix link to t0
+        else {
+            int q = getNext(p, c);
+            if (state[p].len + 1 == state[q].len)
+                state[cur].suffixLink = q;                          // we do not have to split q, just set the correct suffix link
+            else {
+                // we have to split, add q'
+                int clone = newState(state[p].len + 1);
+                copyEdges(clone, q);                                // copy next of q
+                state[clone].suffixLink = state[q].suffixLink;      // copy suffix link of q
+
+                for (; p >= 0 && getNext(p, c) == q; p = state[p].suffixLink)
+                    setNext(p, c, clone);                           // fix last next of all nodes to have the same class to p
+
+                state[q].suffixLink = state[cur].suffixLink = clone;// set q and cur's suffix link to clone
+            }
+        }
+
+        last = cur;
+    }
+
+    void extend(const CharT s[], int len) {
+        for (int i = 0; i < len; i++)
+            extend(s[i]);
+    }
+
+    void extend(const vector<CharT>& s) {
+        extend(s.data(), int(s.size()));
+    }
+
+    // bytes of a string, only for byte symbols
+    void extend(const string& s) {
+        static_assert(sizeof(CharT) == 1, "only for byte symbols");
+        extend(reinterpret_cast<const CharT*>(s.data()), int(s.length()));
+    }
+
+    vector<int> getTerminals() const {
+        vector<int> res;
+        for (int u = last; u > 0; u = state[u].suffixLink)
+            res.push_back(u);
+        return res;
+    }
+
+    //--- transitions
+
+    bool isDense(int u) const {
+        return sizeof(CharT) == 1 && state[u].edgeCount > DENSE_THRESHOLD;
+    }
+
+    int getNext(int u, CharT c) const {
+        const StateT& s = state[u];
+        if (isDense(u))
+            return denseNext[size_t(s.edges) + size_t(c)];
+        return edgePool.get(s.edges, s.edgeCount, c);
+    }
+
+    // f(symbol, next state) in the order of symbols
+    template <typename F>
+    void forEachNext(int u, F f) const {
+        const StateT& s = state[u];
+        if (isDense(u)) {
+            for (int c = 0; c < DENSE_SIZE; c++) {
+                if (denseNext[size_t(s.edges) + c])
+                    f(CharT(c), denseNext[size_t(s.edges) + c]);
+            }
+        } else {
+            for (int i = 0; i < s.edgeCount; i++)
+                f(edgePool.keys[size_t(s.edges) + i], edgePool.values[size_t(s.edges) + i]);
+        }
+    }
+
+    //--- queries
+
+    // O(|pattern| * log(transitions))
+    bool contains(const CharT pattern[], int len) const {
+        int u = 0;
+        for (int i = 0; i < len; i++) {
+            u = getNext(u, pattern[i]);
+            if (!u)
+                return false;
+        }
+        return true;
+    }
+
+    bool contains(const vector<CharT>& pattern) const {
+        return contains(pattern.data(), int(pattern.size()));
+    }
+
+    bool contains(const string& pattern) const {
+        static_assert(sizeof(CharT) == 1, "only for byte symbols");
+        return contains(reinterpret_cast<const CharT*>(pattern.data()), int(pattern.length()));
+    }
+
+    // the number of distinct non-empty substrings, O(N)
+    long long countDistinctSubstrings() const {
+        long long res = 0;
+        for (int u = 1; u < size(); u++)
+            res += state[u].len - state[state[u].suffixLink].len;
+        return res;
+    }
+
+    //--- memory
+
+    // the memory held by the automaton
+    size_t memoryBytes() const {
+        return state.capacity() * sizeof(StateT)
+             + edgePool.memoryBytes()
+             + denseNext.capacity() * sizeof(int);
+    }
+
+    double memoryBytesPerState() const {
+        return double(memoryBytes()) / size();
+    }
+
+    void shrinkToFit() {
+        state.shrink_to_fit();
+        edgePool.shrinkToFit();
+        denseNext.shrink_to_fit();
+    }
+
+private:
+    int newState(int len) {
+        state.push_back(StateT{ len, -1, 0, 0 });
+        return int(state.size()) - 1;
+    }
+
+    void setNext(int u, CharT c, int v) {
+        StateT& s = state[u];
+        if (isDense(u)) {
+            denseNext[size_t(s.edges) + size_t(c)] = v;
+            return;
+        }
+
+        int i = edgePool.lowerBound(s.edges, s.edgeCount, c);
+        size_t edges = size_t(s.edges);
+        if (i < s.edgeCount && edgePool.keys[edges + i] == c) {
+            edgePool.values[edges + i] = v;
+            return;
+        }
+
+        int n = s.edgeCount;
+        if (sizeof(CharT) == 1 && n == DENSE_THRESHOLD) {
+            // promote to a dense table
+            int dense = allocDense();
+            for (int j = 0; j < n; j++)
+                denseNext[size_t(dense) + size_t(edgePool.keys[edges + j])] = edgePool.values[edges + j];
+            denseNext[size_t(dense) + size_t(c)] = v;
+            edgePool.release(s.edges, n);
+            s.edges = dense;
+            s.edgeCount = n + 1;
+            return;
+        }
+
+        edgePool.insert(s.edges, s.edgeCount, i, c, v);
+    }
+
+    // u has no transitions
+    void copyEdges(int u, int from) {
+        int n = state[from].edgeCount;
+        if (n == 0)
+            return;
+
+        if (isDense(from)) {
+            int dense = allocDense();
+            copy(denseNext.begin() + state[from].edges, denseNext.begin() + state[from].edges + DENSE_SIZE,
+                 denseNext.begin() + dense);
+            state[u].edges = dense;
+        } else {
+            state[u].edges = edgePool.clone(state[from].edges, n);
+        }
+        state[u].edgeCount = n;
+    }
+
+    int allocDense() {
+        int dense = int(denseNext.size());
+        denseNext.resize(denseNext.size() + DENSE_SIZE, 0);
+        return dense;
+    }
+};
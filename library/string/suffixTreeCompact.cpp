@@ -0,0 +1,172 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+#include "suffixTree.h"
+#include "suffixTreeCompact.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <ctime>
+#include <cassert>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/rand.h"
+
+static string makeRandomString(int n, int charCnt, int charMin = 'a') {
+    string s;
+    s.reserve(n);
+    for (int i = 0; i < n; i++)
+        s.push_back(char(RandInt32::get() % charCnt + charMin));
+    return s;
+}
+
+static bool isSame(const SuffixTreeCompact& a, const SuffixTreeCompact& b) {
+    return a.text == b.text && a.childPool.keys == b.childPool.keys && a.childPool.values == b.childPool.values
+        && a.childPool.freeSlot == b.childPool.freeSlot
+        && a.activeNode == b.activeNode && a.activeLen == b.activeLen
+        && a.nodes.size() == b.nodes.size()
+        && memcmp(a.nodes.data(), b.nodes.data(), a.nodes.size() * sizeof(SuffixTreeCompact::Node)) == 0;
+}
+
+void testSuffixTreeCompact() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Suffix Tree with Index-based Nodes ------------------" << endl;
+    {
+        int T = 20;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 1000 + 1;
+            string s = makeRandomString(N, RandInt32::get() % 26 + 1);
+
+            SuffixTree tree(N + 1);
+            tree.build(s);
+            SuffixTreeCompact treeC;
+            treeC.extend(s);
+
+            // the same nodes in the same order
+            assert(treeC.nodeCount() == tree.mNodeN + 1);
+            for (int u = 0; u < treeC.nodeCount(); u++) {
+                const SuffixTree::Node* node = tree.getNode(u);
+                assert(treeC.getLength(u) == node->getLength());
+                for (int c = 0; c < tree.charSize(); c++) {
+                    const SuffixTree::Node* child = node->getChild(c);
+                    assert(treeC.getChild(u, (unsigned char)('a' + c)) == (child ? child->id : 0));
+                }
+            }
+
+            for (int i = 0; i < 100; i++) {
+                int L = RandInt32::get() % N;
+                int len = RandInt32::get() % (N - L) + 1;
+                string t = s.substr(L, len);
+                if (i & 1)
+                    t.back() = char(RandInt32::get() % 26 + 'a');
+                assert(treeC.search(t) == tree.search(t));
+            }
+        }
+    }
+    {
+        // bytes
+        int T = 20;
+        while (T-- > 0) {
+            int N = RandInt32::get() % 2000 + 1;
+            int charCnt = (T & 1) ? 256 : int(RandInt32::get() % 8 + 1);
+            string s = makeRandomString(N, charCnt, 0);
+
+            SuffixTreeCompact tree;
+            tree.extend(s);
+            for (int i = 0; i < 100; i++) {
+                string t = makeRandomString(RandInt32::get() % 4 + 1, charCnt, 0);
+                assert(tree.contains(t) == (s.find(t) != string::npos));
+            }
+
+            // children are sorted
+            for (int u = 0; u < tree.nodeCount(); u++) {
+                int prev = -1;
+                tree.forEachChild(u, [&tree, &prev, u](unsigned char ch, int v) {
+                    assert(int(ch) > prev && tree.getChild(u, ch) == v);
+                    prev = ch;
+                });
+            }
+        }
+    }
+    cout << "*** chunks and serialization ***" << endl;
+    {
+        int N = 10000;
+        string s = makeRandomString(N, 4);
+
+        SuffixTreeCompact tree;
+        tree.extend(s);
+
+        // chunks
+        SuffixTreeCompact treeChunk;
+        for (int i = 0; i < N; ) {
+            int len = min(N - i, int(RandInt32::get() % 100 + 1));
+            treeChunk.extend(s.data() + i, len);
+            i += len;
+        }
+        assert(isSame(tree, treeChunk));
+
+        // FILE*
+        const char* textPath = "suffixTreeCompact_text.bin";
+        FILE* fp = fopen(textPath, "wb");
+        assert(fp != nullptr);
+        fwrite(s.data(), 1, s.length(), fp);
+        fclose(fp);
+
+        SuffixTreeCompact treeFile;
+        fp = fopen(textPath, "rb");
+        assert(fp != nullptr);
+        assert(treeFile.extend(fp, 777) == N);
+        fclose(fp);
+        remove(textPath);
+        assert(isSame(tree, treeFile));
+
+        // save & load, and continue
+        const char* path = "suffixTreeCompact.bin";
+        SuffixTreeCompact half;
+        half.extend(s.data(), N / 2);
+        assert(half.save(path));
+
+        SuffixTreeCompact loaded;
+        assert(loaded.load(path));
+        remove(path);
+        loaded.extend(s.data() + N / 2, N - N / 2);
+        assert(isSame(tree, loaded));
+        assert(!loaded.load("suffixTreeCompact_not_exist.bin") && loaded.size() == 0);
+    }
+    cout << "*** Speed & memory test ***" << endl;
+    {
+        int N = 10000000;
+#ifdef _DEBUG
+        N = 100000;
+#endif
+        string s = makeRandomString(N, 26);
+
+        {
+            clock_t start = clock();
+            SuffixTree tree(N);
+            tree.build(s, false);
+            double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+
+            size_t bytes = tree.mNodes.capacity() * sizeof(SuffixTree::Node) + size_t(N) * 2 * sizeof(int) + s.capacity();
+            for (int i = 0; i < tree.mNodeN; i++)
+                bytes += tree.mNodes[i].children.capacity() * sizeof(SuffixTree::Node*);
+            cout << "SuffixTree : " << sizeof(SuffixTree::Node) << " bytes per node, "
+                 << double(bytes) / N << " bytes per character, " << seconds << " sec" << endl;
+        }
+        {
+            clock_t start = clock();
+            SuffixTreeCompact tree;
+            tree.extend(s);
+            double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+            cout << "SuffixTreeCompact : " << sizeof(SuffixTreeCompact::Node) << " bytes per node, "
+                 << double(tree.memoryBytes()) / N << " bytes per character, " << seconds << " sec" << endl;
+        }
+    }
+
+    cout << "OK!" << endl;
+}
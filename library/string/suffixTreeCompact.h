@@ -0,0 +1,259 @@
+#pragma once
+
+#include "../common/binaryFile.h"
+#include "sortedSlotPool.h"
+
+// Ukkonen's suffix tree over bytes with index-based nodes
+//  - nodes are 20-byte records in one vector and refer to each other by indexes (0 is the root and 'none'),
+//    SuffixTree's nodes are 72 bytes, pointer-linked with a vector of children each
+//  - the children of a node are an array sorted by the first character in a shared SortedSlotPool
+//    (as SuffixAutomatonCompact)
+//  - online : the text can be appended in chunks by extend(), from memory or a FILE*,
+//    and the tree is always the implicit suffix tree of the text so far
+//  - the text is kept in memory (edges refer to it), up to 2^31 - 1 bytes
+//  - save()/load() write and read the text and nodes as a BinaryFile,
+//    a loaded tree can be queried or extended without rebuilding
+struct SuffixTreeCompact {
+    static const unsigned int FILE_MAGIC = 0x45525453u;    // "STRE"
+    static const unsigned int FILE_VERSION = 1;
+
+    struct Node {
+        int     begin;
+        int     end;                    // -1 for leaves, the end of a leaf is the end of the text
+        int     suffixLink;
+        int     children;               // the slot of children in childPool
+        int     childCount;
+    };
+
+    vector<unsigned char>   text;
+    vector<Node>            nodes;      // nodes[0] is the root
+    SortedSlotPool<unsigned char> childPool;    // (first character, child) of children
+
+    int                     activeNode;
+    int                     activeLen;
+
+    SuffixTreeCompact() {
+        init();
+    }
+
+    // reserves memory for a text of maxN bytes
+    explicit SuffixTreeCompact(int maxN) {
+        init();
+        text.reserve(maxN);
+        nodes.reserve(size_t(maxN) * 2);
+        childPool.reserve(size_t(maxN) * 2);
+    }
+
+    void init() {
+        text.clear();
+        nodes.assign(1, Node{ 0, 0, 0, 0, 0 });
+        childPool.init();
+
+        activeNode = 0;
+        activeLen = 0;
+    }
+
+    int size() const {
+        return int(text.size());
+    }
+
+    int nodeCount() const {
+        return int(nodes.size());
+    }
+
+    void extend(unsigned char ch) {
+        int currPos = int(text.size());
+        text.push_back(ch);
+
+        int last = 0;                   // an internal node waiting for its suffix link
+        while (activeLen >= 0) {
+            int node = getChild(activeNode, text[currPos - activeLen]);
+
+            // walk down
+            while (node && activeLen >= getLength(node)) {
+                activeLen -= getLength(node);
+                activeNode = node;
+                node = getChild(activeNode, text[currPos - activeLen]);
+            }
+
+            if (!node) {
+                setChild(activeNode, ch, newNode(currPos, -1));
+                if (last)
+                    nodes[last].suffixLink = activeNode;
+                last = 0;
+            } else {
+                unsigned char afterTail = text[nodes[node].begin + activeLen];
+                if (afterTail == ch) {
+                    if (last)
+                        nodes[last].suffixLink = activeNode;
+                    break;
+                }
+
+                int splitNode = newNode(nodes[node].begin, nodes[node].begin + activeLen);
+                int leaf = newNode(currPos, -1);
+                setChild(activeNode, text[currPos - activeLen], splitNode);
+                setChild(splitNode, ch, leaf);
+                nodes[node].begin += activeLen;
+                setChild(splitNode, afterTail, node);
+
+                if (last)
+                    nodes[last].suffixLink = splitNode;
+                last = splitNode;
+            }
+
+            if (activeNode == 0)
+                activeLen--;
+            else
+                activeNode = nodes[activeNode].suffixLink;
+        }
+
+        activeLen++;
+    }
+
+    // a chunk of the text
+    void extend(const char* s, int len) {
+        for (int i = 0; i < len; i++)
+            extend((unsigned char)s[i]);
+    }
+
+    void extend(const string& s) {
+        extend(s.data(), int(s.length()));
+    }
+
+    // reads the rest of a file in chunks, returns the number of bytes read
+    long long extend(FILE* fp, int chunkSize = 1 << 16) {
+        vector<char> buffer(chunkSize);
+        long long res = 0;
+        size_t n;
+        while ((n = fread(buffer.data(), 1, buffer.size(), fp)) > 0) {
+            extend(buffer.data(), int(n));
+            res += (long long)n;
+        }
+        return res;
+    }
+
+    //--- nodes
+
+    bool isLeaf(int u) const {
+        return nodes[u].end < 0;
+    }
+
+    int getLength(int u) const {
+        return (nodes[u].end < 0 ? int(text.size()) : nodes[u].end) - nodes[u].begin;
+    }
+
+    int getChild(int u, unsigned char ch) const {
+        return childPool.get(nodes[u].children, nodes[u].childCount, ch);
+    }
+
+    // f(first character, child) in the order of the first characters
+    template <typename F>
+    void forEachChild(int u, F f) const {
+        for (int i = 0; i < nodes[u].childCount; i++)
+            f(childPool.keys[size_t(nodes[u].children) + i], childPool.values[size_t(nodes[u].children) + i]);
+    }
+
+    //--- search
+
+    // return (prefix_matching_length, suffix_index), the same as SuffixTree::search()
+    pair<int, int> search(const string& s) const {
+        return search(s.data(), int(s.length()));
+    }
+
+    // return (prefix_matching_length, suffix_index)
+    //  - suffix_index >= 0 if 's' ends at the end of a leaf
+    pair<int, int> search(const char* s, int len) const {
+        if (len <= 0)
+            return make_pair(0, -1);
+
+        int p = getChild(0, (unsigned char)s[0]);
+        int i = 0, depth = 0;           // depth = the length from the root to the parent of p
+        while (p) {
+            int begin = nodes[p].begin;
+            int length = getLength(p);
+            for (int j = 0; j < length; i++, j++) {
+                if (i >= len || (unsigned char)s[i] != text[begin + j])
+                    return make_pair(i, -1);
+            }
+            if (i >= len)
+                break;
+
+            depth += length;
+            p = getChild(p, (unsigned char)s[i]);
+        }
+
+        return make_pair(i, (p && isLeaf(p)) ? nodes[p].begin - depth : -1);
+    }
+
+    bool contains(const char* s, int len) const {
+        return search(s, len).first == len;
+    }
+
+    bool contains(const string& s) const {
+        return contains(s.data(), int(s.length()));
+    }
+
+    //--- memory
+
+    size_t memoryBytes() const {
+        return text.capacity() + nodes.capacity() * sizeof(Node) + childPool.memoryBytes();
+    }
+
+    //--- serialization
+
+    // writes without the header, to be a part of another structure
+    bool save(BinaryWriter& writer) const {
+        writer.write(activeNode);
+        writer.write(activeLen);
+        writer.writeArray(text.data(), text.size());
+        writer.writeArray(nodes.data(), nodes.size());
+        writer.writeArray(childPool.keys.data(), childPool.keys.size());
+        writer.writeArray(childPool.values.data(), childPool.values.size());
+        writer.writeArray(childPool.freeSlot.data(), childPool.freeSlot.size());
+        return writer.ok;
+    }
+
+    bool save(FILE* fp) const {
+        BinaryWriter writer(fp);
+        writer.writeHeader(FILE_MAGIC, FILE_VERSION, 0, sizeof(Node));
+        return save(writer);
+    }
+
+    bool save(const char* path) const {
+        return saveBinaryFile(*this, path);
+    }
+
+    bool load(BinaryReader& reader) {
+        bool res = reader.read(activeNode) && reader.read(activeLen)
+                && reader.readArray(text) && reader.readArray(nodes)
+                && reader.readArray(childPool.keys) && reader.readArray(childPool.values)
+                && reader.readArray(childPool.freeSlot)
+                && !nodes.empty() && childPool.keys.size() == childPool.values.size()
+                && int(childPool.freeSlot.size()) == childPool.MAX_SLOT_CLASS
+                && 0 <= activeNode && activeNode < int(nodes.size()) && 0 <= activeLen && activeLen <= int(text.size());
+        if (!res)
+            init();
+        return res;
+    }
+
+    // copies a file made by save()
+    bool load(const char* path) {
+        MappedFile file(path);
+        BinaryReader reader(file.data, file.size);
+        if (reader.readHeader(FILE_MAGIC, FILE_VERSION, 0, sizeof(Node)) && load(reader))
+            return true;
+        init();
+        return false;
+    }
+
+private:
+    int newNode(int begin, int end) {
+        nodes.push_back(Node{ begin, end, 0, 0, 0 });
+        return int(nodes.size()) - 1;
+    }
+
+    // adds or replaces the child of u with the first character 'ch'
+    void setChild(int u, unsigned char ch, int v) {
+        childPool.set(nodes[u].children, nodes[u].childCount, ch, v);
+    }
+};
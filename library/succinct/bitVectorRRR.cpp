@@ -0,0 +1,200 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <tuple>
+#include <string>
+#include <algorithm>
+
+using namespace std;
+
+#include "bitVectorRRR.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+#include "bitVectorRank.h"
+#include "bitVectorRankSelect.h"
+#include "waveletMatrix.h"
+
+static size_t memoryBytes(const BitVectorRank& bv) {
+    return (bv.values.size() + bv.rank.size()) * sizeof(int);
+}
+
+static size_t memoryBytes(const BitVectorRankSelect& bv) {
+    return bv.blocks.size() * sizeof(unsigned long long)
+         + (bv.select1Samples.size() + bv.select0Samples.size()) * sizeof(int);
+}
+
+static size_t memoryBytes(const BitVectorRRR& bv) {
+    return bv.memoryBytes();
+}
+
+// P(v) = 2^-(v+1)
+static int geometric() {
+    int v = 0;
+    while (v < 30 && (RandInt32::get() & 1))
+        v++;
+    return v;
+}
+
+template <typename BitVectorT>
+static void benchmarkWaveletMatrix(const char* name, const vector<int>& in,
+                                   const vector<int>& qL, const vector<int>& qR, const vector<int>& qK) {
+    WaveletMatrix<int, BitVectorT> wm(in);
+
+    size_t bytes = wm.mids.size() * sizeof(int);
+    for (auto& bv : wm.values)
+        bytes += memoryBytes(bv);
+
+    int Q = int(qL.size());
+    long long sum = 0;
+
+    AccumulateTimer kthTimer, countTimer;
+    kthTimer.start();
+    for (int i = 0; i < Q; i++)
+        sum += wm.kth(qL[i], qR[i], qK[i]);
+    kthTimer.stop();
+
+    countTimer.start();
+    for (int i = 0; i < Q; i++)
+        sum += wm.countLessThanOrEqual(qL[i], qR[i], in[qL[i] + qK[i]]);
+    countTimer.stop();
+
+    cout << "    " << name << " : " << double(bytes) * 8 / in.size() << " bits/value, "
+         << "kth() = " << double(kthTimer.getNanosec()) / Q << " ns, "
+         << "countLessThanOrEqual() = " << double(countTimer.getNanosec()) / Q << " ns"
+         << (sum == 0 ? " (?)" : "") << endl;
+}
+
+void testBitVectorRRR() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Compressed BitVector (RRR) -------------------" << endl;
+    {
+        for (int N : { 1, 14, 15, 16, 479, 480, 481, 1000, 5000, 100000 }) {
+            for (int density : { 50, 2, 0, 100, 98 }) {
+                vector<bool> in(N);
+                for (int i = 0; i < N; i++)
+                    in[i] = int(RandInt32::get() % 100) < density;
+
+                BitVectorRRR bv(N);
+                BitVectorRank bv0(N);
+                for (int i = 0; i < N; i++) {
+                    bv.set(i, in[i]);
+                    bv0.set(i, in[i]);
+                }
+                bv.buildRank();
+                bv0.buildRank();
+
+                assert(bv.count() == bv0.count());
+                for (int i = 0; i < N; i++) {
+                    assert(bv.test(i) == in[i]);
+                    assert(bv.rank1(i) == bv0.rank1(i));
+                    assert(bv.rank0(i) == bv0.rank0(i));
+                }
+            }
+        }
+    }
+    {
+        for (int t = 0; t < 100; t++) {
+            int N = RandInt32::get() % 1000 + 1;
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = (t & 1) ? RandInt32::get() % 65536 : geometric();
+
+            WaveletMatrix<int> wm1(in);
+            WaveletMatrix<int, BitVectorRRR> wm2(in);
+            for (int i = 0; i < 100; i++) {
+                int L = RandInt32::get() % N;
+                int R = RandInt32::get() % N;
+                if (L > R)
+                    swap(L, R);
+                int K = RandInt32::get() % (R - L + 1);
+                assert(wm1.get(L) == wm2.get(L));
+                assert(wm1.kth(L, R, K) == wm2.kth(L, R, K));
+                assert(wm1.countEx(L, R, in[R]) == wm2.countEx(L, R, in[R]));
+            }
+
+            const char* path = "succinct_test.bin";
+            assert(wm2.save(path));
+            WaveletMatrix<int, BitVectorRRR> wm3;
+            assert(wm3.load(path));
+            for (int i = 0; i < N; i++)
+                assert(wm3.get(i) == in[i]);
+            remove(path);
+        }
+    }
+    {
+        cout << "*** Memory vs. speed : WaveletMatrix with BitVectorRank, BitVectorRankSelect and BitVectorRRR ***" << endl;
+
+        int N = 1 << 22;
+        int Q = 1000000;
+#ifdef _DEBUG
+        N = 1 << 16;
+        Q = 10000;
+#endif
+        vector<int> qL(Q), qR(Q), qK(Q);
+        for (int i = 0; i < Q; i++) {
+            qL[i] = RandInt32::get() % N;
+            qR[i] = RandInt32::get() % N;
+            if (qL[i] > qR[i])
+                swap(qL[i], qR[i]);
+            qK[i] = RandInt32::get() % (qR[i] - qL[i] + 1);
+        }
+
+        vector<pair<string, vector<int>>> data;
+
+        // uniform 16-bit values
+        data.emplace_back("uniform, 16 bits", vector<int>(N));
+        for (int i = 0; i < N; i++)
+            data.back().second[i] = RandInt32::get() % 65536;
+
+        // geometric distribution, P(v) = 2^-(v+1)
+        data.emplace_back("geometric", vector<int>(N));
+        for (int i = 0; i < N; i++)
+            data.back().second[i] = geometric();
+
+        // Zipf-like, P(v) ~ 1/v over 65536 values
+        data.emplace_back("zipf, 16 bits", vector<int>(N));
+        for (int i = 0; i < N; i++) {
+            double u = (RandInt32::get() % 1000000 + 1) / 1000000.0;
+            data.back().second[i] = min(65535, int(exp(u * log(65536.0))) - 1);
+        }
+
+        // real text : the bytes of the source files of this module
+        {
+            string text;
+            for (const char* path : { "waveletMatrix.h", "waveletTree.h", "waveletTreeBitVector.h", "bitVectorRank.h" }) {
+                FILE* fp = fopen(path, "rb");
+                if (!fp)
+                    continue;
+                int ch;
+                while ((ch = fgetc(fp)) != EOF)
+                    text.push_back(char(ch));
+                fclose(fp);
+            }
+            if (!text.empty()) {
+                data.emplace_back("source text bytes", vector<int>(N));
+                for (int i = 0; i < N; i++)
+                    data.back().second[i] = (unsigned char)text[i % text.length()];
+            }
+        }
+
+        cout << "N = " << N << ", Q = " << Q << endl;
+        for (auto& it : data) {
+            cout << "  " << it.first << endl;
+            benchmarkWaveletMatrix<BitVectorRank>("BitVectorRank", it.second, qL, qR, qK);
+            benchmarkWaveletMatrix<BitVectorRankSelect>("BitVectorRankSelect", it.second, qL, qR, qK);
+            benchmarkWaveletMatrix<BitVectorRRR>("BitVectorRRR", it.second, qL, qR, qK);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+#include "succinctFile.h"
+
+// Compressed bit vector (RRR)
+//  - bits are split into blocks of 15 bits, and a block is stored as its class (the number of ones, 4 bits)
+//    and its offset (the index in all blocks of the class, ceil(log2(C(15, class))) bits)
+//  - blocks of all zeros or all ones take only 4 bits, so skewed bit vectors shrink to a fraction of N bits
+//  - a superblock of RRR_SUPERBLOCK_SIZE blocks keeps its rank, the position of its first offset and
+//    the classes of its blocks together, so rank1() reads the superblock and one offset,
+//    sums at most RRR_SUPERBLOCK_SIZE - 1 classes two at a time, and decodes one block by a table
+//  - set bits before buildRank(), get() and ranks after it
+//  - same API as BitVectorRank, and can be used as the bit vector of WaveletMatrix
+
+#ifndef RRR_SUPERBLOCK_SIZE
+#define RRR_SUPERBLOCK_SIZE     32      // in blocks, a multiple of 16
+#endif
+
+struct BitVectorRRR {
+    static const int BLOCK_BITS = 15;
+    static const int SUPERBLOCK_SIZE = RRR_SUPERBLOCK_SIZE;
+    static const int CLASSES_PER_WORD = 16;         // 4 bits per class
+    static const int SUPERBLOCK_WORDS = 1 + SUPERBLOCK_SIZE / CLASSES_PER_WORD;
+
+    static const unsigned int FILE_TYPE = SuccinctFile::TYPE_BIT_VECTOR_RRR;
+
+    int                         N;
+    int                         bitCount;
+    vector<unsigned long long>  superblocks;    // [ones before | the position of the first offset << 32][classes, 4 bits per block]
+    vector<unsigned long long>  offsets;        // variable length offsets of blocks
+    vector<unsigned long long>  plain;          // the bits before buildRank()
+
+    BitVectorRRR() : N(0), bitCount(0) {
+    }
+
+    explicit BitVectorRRR(int size) {
+        init(size);
+    }
+
+    void init(int size) {
+        N = size;
+        bitCount = 0;
+        plain.assign((size + 63) / 64, 0ull);
+        superblocks.clear();
+        offsets.clear();
+    }
+
+
+    int size() const {
+        return N;
+    }
+
+    void set(int pos) {
+        plain[pos >> 6] |= 1ull << (pos & 63);
+    }
+
+    void reset(int pos) {
+        plain[pos >> 6] &= ~(1ull << (pos & 63));
+    }
+
+    void set(int pos, bool val) {
+        if (val)
+            set(pos);
+        else
+            reset(pos);
+    }
+
+    //--- after set ---
+
+    // compresses the bits, and releases them
+    void buildRank() {
+        const Tables& tables = getTables();
+
+        int blockN = (N + BLOCK_BITS - 1) / BLOCK_BITS;
+        int superN = blockN / SUPERBLOCK_SIZE + 1;
+        superblocks.assign(size_t(superN) * SUPERBLOCK_WORDS, 0ull);
+        offsets.clear();
+
+        bitCount = 0;
+        unsigned long long offsetBits = 0;
+        for (int b = 0; b < blockN; b++) {
+            unsigned long long* super = &superblocks[size_t(b / SUPERBLOCK_SIZE) * SUPERBLOCK_WORDS];
+            int i = b % SUPERBLOCK_SIZE;
+            if (i == 0)
+                super[0] = (unsigned long long)bitCount | (offsetBits << 32);
+
+            int bits = readPlain(b * BLOCK_BITS);
+            int c = BitVectorRRR::popcount((unsigned long long)bits);
+            super[1 + i / CLASSES_PER_WORD] |= (unsigned long long)c << (i % CLASSES_PER_WORD * 4);
+            writeBits(offsetBits, tables.offset[bits], tables.offsetBits[c]);
+            offsetBits += tables.offsetBits[c];
+            bitCount += c;
+        }
+        if (blockN % SUPERBLOCK_SIZE == 0)
+            superblocks[size_t(superN - 1) * SUPERBLOCK_WORDS] = (unsigned long long)bitCount | (offsetBits << 32);
+        offsets.push_back(0ull);        // padding for readBits()
+
+        vector<unsigned long long>().swap(plain);
+    }
+
+    int count() const {
+        return bitCount;
+    }
+
+    unsigned int get(int pos) const {
+        int b = pos / BLOCK_BITS;
+        return (decodeBlock(b) >> (pos % BLOCK_BITS)) & 1;
+    }
+
+    bool test(int pos) const {
+        return get(pos) != 0;
+    }
+
+    // inclusive [0, pos]
+    int rank1(int pos) const {
+        if (pos < 0)
+            return 0;
+        else if (pos >= N - 1)
+            return bitCount;
+
+        ++pos;
+        const Tables& tables = getTables();
+
+        int b = pos / BLOCK_BITS;
+        const unsigned long long* super = &superblocks[size_t(b / SUPERBLOCK_SIZE) * SUPERBLOCK_WORDS];
+        int res = int(super[0] & 0xFFFFFFFFull);
+        unsigned long long offsetPos = super[0] >> 32;
+        skipBlocks(super, b % SUPERBLOCK_SIZE, res, offsetPos);
+
+        int r = pos % BLOCK_BITS;
+        if (r > 0) {
+            int c = getClass(super, b % SUPERBLOCK_SIZE);
+            int bits = tables.blocks[tables.classStart[c] + int(readBits(offsetPos, tables.offsetBits[c]))];
+            res += BitVectorRRR::popcount((unsigned long long)(bits & ((1 << r) - 1)));
+        }
+        return res;
+    }
+
+    // inclusive [left, right]
+    int rank1(int left, int right) const {
+        return rank1(right) - rank1(left - 1);
+    }
+
+    // inclusive [0, pos]
+    int rank0(int pos) const {
+        if (pos < 0)
+            return 0;
+        return pos + 1 - rank1(pos);
+    }
+
+    // inclusive [left, right]
+    int rank0(int left, int right) const {
+        return rank0(right) - rank0(left - 1);
+    }
+
+    // the memory after buildRank()
+    size_t memoryBytes() const {
+        return (superblocks.size() + offsets.size()) * sizeof(unsigned long long);
+    }
+
+    //--- serialization
+
+    // writes without the header, to be a part of another structure
+    bool save(SuccinctWriter& writer) const {
+        writer.write(N);
+        writer.write(bitCount);
+        writer.writeArray(superblocks.data(), superblocks.size());
+        writer.writeArray(offsets.data(), offsets.size());
+        return writer.ok;
+    }
+
+    bool load(SuccinctReader& reader) {
+        plain.clear();
+        return reader.read(N) && reader.read(bitCount)
+            && reader.readArray(superblocks) && reader.readArray(offsets)
+            && superblocks.size() == size_t((N + BLOCK_BITS - 1) / BLOCK_BITS / SUPERBLOCK_SIZE + 1) * SUPERBLOCK_WORDS
+            && !offsets.empty();
+    }
+
+
+    static int popcount(unsigned long long x) {
+#ifndef __GNUC__
+        return int(__popcnt64(x));
+#else
+        return __builtin_popcountll(x);
+#endif
+    }
+
+private:
+    // all 15-bit blocks sorted by (class, value)
+    struct Tables {
+        int             classStart[BLOCK_BITS + 2];     // the first index of each class in blocks[]
+        int             offsetBits[BLOCK_BITS + 1];     // ceil(log2(C(15, class)))
+        unsigned short  blocks[1 << BLOCK_BITS];        // blocks[classStart[c] + offset] = bits
+        unsigned short  offset[1 << BLOCK_BITS];        // offset[bits]
+        unsigned char   pairRank[256];                  // the sum of two classes in a byte
+        unsigned char   pairOffsetBits[256];            // the sum of the offset bits of two classes in a byte
+
+        Tables() {
+            int cnt[BLOCK_BITS + 1] = { 0, };
+            for (int x = 0; x < (1 << BLOCK_BITS); x++)
+                cnt[BitVectorRRR::popcount((unsigned long long)x)]++;
+
+            classStart[0] = 0;
+            for (int c = 0; c <= BLOCK_BITS; c++) {
+                classStart[c + 1] = classStart[c] + cnt[c];
+                offsetBits[c] = 0;
+                while ((1 << offsetBits[c]) < cnt[c])
+                    offsetBits[c]++;
+            }
+
+            int next[BLOCK_BITS + 1];
+            for (int c = 0; c <= BLOCK_BITS; c++)
+                next[c] = classStart[c];
+            for (int x = 0; x < (1 << BLOCK_BITS); x++) {
+                int c = BitVectorRRR::popcount((unsigned long long)x);
+                offset[x] = (unsigned short)(next[c] - classStart[c]);
+                blocks[next[c]++] = (unsigned short)x;
+            }
+
+            for (int x = 0; x < 256; x++) {
+                pairRank[x] = (unsigned char)((x & 0xF) + (x >> 4));
+                pairOffsetBits[x] = (unsigned char)(offsetBits[x & 0xF] + offsetBits[x >> 4]);
+            }
+        }
+    };
+
+    static const Tables& getTables() {
+        static const Tables tables;
+        return tables;
+    }
+
+    // adds the ones and the offset bits of the first n blocks of a superblock
+    void skipBlocks(const unsigned long long* super, int n, int& rank, unsigned long long& offsetPos) const {
+        const Tables& tables = getTables();
+        int i = 0;
+        for (; i + 2 <= n; i += 2) {
+            int pair = int((super[1 + i / CLASSES_PER_WORD] >> (i % CLASSES_PER_WORD * 4)) & 0xFF);
+            rank += tables.pairRank[pair];
+            offsetPos += tables.pairOffsetBits[pair];
+        }
+        if (i < n) {
+            int c = getClass(super, i);
+            rank += c;
+            offsetPos += tables.offsetBits[c];
+        }
+    }
+
+    // the class of the i-th block of a superblock
+    static int getClass(const unsigned long long* super, int i) {
+        return int((super[1 + i / CLASSES_PER_WORD] >> (i % CLASSES_PER_WORD * 4)) & 0xF);
+    }
+
+    int decodeBlock(int b) const {
+        const Tables& tables = getTables();
+
+        const unsigned long long* super = &superblocks[size_t(b / SUPERBLOCK_SIZE) * SUPERBLOCK_WORDS];
+        int rank = 0;
+        unsigned long long offsetPos = super[0] >> 32;
+        skipBlocks(super, b % SUPERBLOCK_SIZE, rank, offsetPos);
+
+        int c = getClass(super, b % SUPERBLOCK_SIZE);
+        return tables.blocks[tables.classStart[c] + int(readBits(offsetPos, tables.offsetBits[c]))];
+    }
+
+    // 15 bits from pos of the plain bits
+    int readPlain(int pos) const {
+        int idx = pos >> 6, off = pos & 63;
+        unsigned long long x = plain[idx] >> off;
+        if (off > 64 - BLOCK_BITS && idx + 1 < int(plain.size()))
+            x |= plain[idx + 1] << (64 - off);
+        return int(x & ((1ull << BLOCK_BITS) - 1));
+    }
+
+    // width <= 32
+    unsigned long long readBits(unsigned long long pos, int width) const {
+        if (width == 0)
+            return 0;
+        size_t idx = size_t(pos >> 6);
+        int off = int(pos & 63);
+        unsigned long long x = offsets[idx] >> off;
+        if (off + width > 64)
+            x |= offsets[idx + 1] << (64 - off);
+        return x & ((1ull << width) - 1);
+    }
+
+    void writeBits(unsigned long long pos, unsigned long long value, int width) {
+        if (width == 0)
+            return;
+        size_t idx = size_t(pos >> 6);
+        int off = int(pos & 63);
+        if (idx + 1 >= offsets.size())
+            offsets.resize(idx + 2, 0ull);
+        offsets[idx] |= value << off;
+        if (off + width > 64)
+            offsets[idx + 1] |= value >> (64 - off);
+    }
+};
@@ -1,17 +1,83 @@
 #pragma once
 
-struct BitVectorRank {
+#include "succinctFile.h"
+
+// queries of BitVectorRank, on 'values' and 'rank' in vectors (BitVectorRank) or in a mapped file (BitVectorRankView)
+template <typename WordArray, typename RankArray>
+struct BitVectorRankQuery {
     static const int BIT_SIZE = sizeof(unsigned int) * 8;
     static const unsigned int BIT_ALL = (unsigned int)-1;
 
     static const int INDEX_MASK = 0x1F;
     static const int INDEX_SHIFT = 5;
 
-    int                  N;
-    int                  bitCount;
-    vector<unsigned int> values;
-    vector<int>          rank;
+    static const unsigned int FILE_TYPE = SuccinctFile::TYPE_BIT_VECTOR_RANK;
+
+    int         N;
+    int         bitCount;
+    WordArray   values;
+    RankArray   rank;
+
+    int size() const {
+        return N;
+    }
+
+    unsigned int get(int pos) const {
+        return values[pos >> INDEX_SHIFT] & (1u << (pos & INDEX_MASK));
+    }
+
+    bool test(int pos) const {
+        return (values[pos >> INDEX_SHIFT] & (1u << (pos & INDEX_MASK))) != 0;
+    }
+
+    int count() const {
+        return bitCount;
+    }
 
+    // inclusive [0, pos]
+    int rank1(int pos) const {
+        if (pos < 0)
+            return 0;
+        else if (pos >= N - 1)
+            return bitCount;
+        int idx = ++pos >> INDEX_SHIFT;
+        int off = pos & INDEX_MASK;
+        return rank[idx] + popcount(values[idx] & ((1u << off) - 1u));
+    }
+
+    // inclusive [left, right]
+    int rank1(int left, int right) const {
+        return rank1(right) - rank1(left - 1);
+    }
+
+    // inclusive [0, pos]
+    int rank0(int pos) const {
+        if (pos < 0)
+            return 0;
+        return pos + 1 - rank1(pos);
+    }
+
+    // inclusive [left, right]
+    int rank0(int left, int right) const {
+        return rank0(right) - rank0(left - 1);
+    }
+
+
+    static int popcount(unsigned int x) {
+#ifndef __GNUC__
+        return int(__popcnt(x));
+        /*
+        x = x - ((x >> 1) & 0x55555555);
+        x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+        return ((x + (x >> 4) & 0xF0F0F0F) * 0x1010101) >> 24;
+        */
+#else
+        return __builtin_popcount(x);
+#endif
+    }
+};
+
+struct BitVectorRank : BitVectorRankQuery<vector<unsigned int>, vector<int>> {
     BitVectorRank() {
         //init(0);
     }
@@ -27,11 +93,6 @@ struct BitVectorRank {
         rank = vector<int>(values.size() + 1);
     }
 
-
-    int size() const {
-        return N;
-    }
-
     void set() {
         int n = N >> INDEX_SHIFT;
         for (int i = 0; i < n; i++)
@@ -61,14 +122,6 @@ struct BitVectorRank {
             reset(pos);
     }
 
-    unsigned int get(int pos) const {
-        return values[pos >> INDEX_SHIFT] & (1u << (pos & INDEX_MASK));
-    }
-
-    bool test(int pos) const {
-        return (values[pos >> INDEX_SHIFT] & (1u << (pos & INDEX_MASK))) != 0;
-    }
-
     //--- after set ---
 
     void buildRank() {
@@ -82,48 +135,70 @@ struct BitVectorRank {
         rank[values.size()] = bitCount;
     }
 
-    int count() const {
-        return bitCount;
+    //--- serialization
+
+    // writes without the header, to be a part of another structure
+    bool save(SuccinctWriter& writer) const {
+        writer.write(N);
+        writer.write(bitCount);
+        writer.writeArray(values.data(), values.size());
+        writer.writeArray(rank.data(), rank.size());
+        return writer.ok;
     }
 
-    // inclusive [0, pos]
-    int rank1(int pos) const {
-        if (pos < 0)
-            return 0;
-        else if (pos >= N - 1)
-            return bitCount;
-        int idx = ++pos >> INDEX_SHIFT;
-        int off = pos & INDEX_MASK;
-        return rank[idx] + popcount(values[idx] & ((1u << off) - 1u));
+    bool save(FILE* fp) const {
+        SuccinctWriter writer(fp);
+        writer.writeHeader(FILE_TYPE, sizeof(unsigned int));
+        return save(writer);
     }
 
-    // inclusive [left, right]
-    int rank1(int left, int right) const {
-        return rank1(right) - rank1(left - 1);
+    bool save(const char* path) const {
+        return saveBinaryFile(*this, path);
     }
 
-    // inclusive [0, pos]
-    int rank0(int pos) const {
-        if (pos < 0)
-            return 0;
-        return pos + 1 - rank1(pos);
+    bool load(SuccinctReader& reader) {
+        return reader.read(N) && reader.read(bitCount)
+            && reader.readArray(values) && reader.readArray(rank)
+            && rank.size() == values.size() + 1;
     }
 
-    // inclusive [left, right]
-    int rank0(int left, int right) const {
-        return rank0(right) - rank0(left - 1);
+    // copies a file made by save()
+    bool load(const char* path) {
+        MappedFile file(path);
+        SuccinctReader reader(file.data, file.size);
+        return reader.readHeader(FILE_TYPE, sizeof(unsigned int)) && load(reader);
     }
+};
 
-    static int popcount(unsigned int x) {
-#ifndef __GNUC__
-        return int(__popcnt(x));
-        /*
-        x = x - ((x >> 1) & 0x55555555);
-        x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
-        return ((x + (x >> 4) & 0xF0F0F0F) * 0x1010101) >> 24;
-        */
-#else
-        return __builtin_popcount(x);
-#endif
+// read-only BitVectorRank on a file made by BitVectorRank::save(), without copying
+struct BitVectorRankView : BitVectorRankQuery<const unsigned int*, const int*> {
+    MappedFile          file;       // empty if this is a part of another view
+
+    BitVectorRankView() {
+        N = 0;
+        bitCount = 0;
+        values = nullptr;
+        rank = nullptr;
+    }
+
+    explicit BitVectorRankView(const char* path) : BitVectorRankView() {
+        open(path);
+    }
+
+    bool open(const char* path) {
+        if (!file.open(path))
+            return false;
+        SuccinctReader reader(file.data, file.size);
+        return reader.readHeader(FILE_TYPE, sizeof(unsigned int)) && load(reader);
+    }
+
+    // points into the memory of 'reader', the memory must outlive this
+    bool load(SuccinctReader& reader) {
+        size_t valueN = 0, rankN = 0;
+        if (!reader.read(N) || !reader.read(bitCount))
+            return false;
+        values = reader.readArray<unsigned int>(valueN);
+        rank = reader.readArray<int>(rankN);
+        return values != nullptr && rank != nullptr && rankN == valueN + 1;
     }
 };
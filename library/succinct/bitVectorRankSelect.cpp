@@ -0,0 +1,210 @@
+#include <limits>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+
+using namespace std;
+
+#include "bitVectorRankSelect.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+#include "bitVectorRank.h"
+#include "waveletMatrix.h"
+
+void testBitVectorRankSelect() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- BitVector with Rank and Select ------------------" << endl;
+    {
+        for (int N : { 1, 63, 64, 65, 383, 384, 385, 1000, 5000, 100000 }) {
+            // dense, sparse, all zeros and all ones
+            for (int density : { 50, 2, 0, 100 }) {
+                vector<bool> in(N);
+                for (int i = 0; i < N; i++)
+                    in[i] = int(RandInt32::get() % 100) < density;
+
+                BitVectorRankSelect bv(N);
+                BitVectorRank bv0(N);
+                for (int i = 0; i < N; i++) {
+                    bv.set(i, in[i]);
+                    bv0.set(i, in[i]);
+                }
+                bv.buildRank();
+                bv0.buildRank();
+
+                assert(bv.count() == bv0.count());
+                int ones = 0, zeros = 0;
+                for (int i = 0; i < N; i++) {
+                    assert(bv.test(i) == in[i]);
+                    assert(bv.rank1(i) == bv0.rank1(i));
+                    assert(bv.rank0(i) == bv0.rank0(i));
+                    if (in[i])
+                        assert(bv.select1(ones++) == i);
+                    else
+                        assert(bv.select0(zeros++) == i);
+                }
+            }
+        }
+
+        for (int i = 0; i < 100000; i++) {
+            unsigned long long x = (unsigned long long)RandInt32::get() << 32 | RandInt32::get();
+            if (x == 0)
+                continue;
+            int k = RandInt32::get() % BitVectorRankSelect::popcount(x);
+            int pos = BitVectorRankSelect::selectInWord(x, k);
+            assert((x >> pos) & 1);
+            assert(BitVectorRankSelect::popcount(x & ((1ull << pos) - 1)) == k);
+        }
+    }
+    {
+        for (int t = 0; t < 100; t++) {
+            int N = RandInt32::get() % 1000 + 1;
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = RandInt32::get() % 65536;
+
+            WaveletMatrix<int> wm1(in);
+            WaveletMatrix<int, BitVectorRankSelect> wm2(in);
+            for (int i = 0; i < 100; i++) {
+                int L = RandInt32::get() % N;
+                int R = RandInt32::get() % N;
+                if (L > R)
+                    swap(L, R);
+                int K = RandInt32::get() % (R - L + 1);
+                assert(wm1.get(L) == wm2.get(L));
+                assert(wm1.kth(L, R, K) == wm2.kth(L, R, K));
+                assert(wm1.countEx(L, R, in[R]) == wm2.countEx(L, R, in[R]));
+            }
+
+            // a file keeps the type of bit vectors
+            const char* path = "succinct_test.bin";
+            assert(wm2.save(path));
+            WaveletMatrix<int, BitVectorRankSelect> wm3;
+            assert(wm3.load(path));
+            assert(!wm1.load(path));
+            assert(!WaveletMatrixView<int>().open(path));
+            for (int i = 0; i < N; i++)
+                assert(wm3.get(i) == in[i]);
+            remove(path);
+        }
+    }
+    {
+        cout << "*** Speed test : BitVectorRank vs. BitVectorRankSelect ***" << endl;
+
+        int N = 1 << 28;
+        int Q = 10000000;
+#ifdef _DEBUG
+        N = 1 << 20;
+        Q = 100000;
+#endif
+        BitVectorRank bv0(N);
+        BitVectorRankSelect bv(N);
+        for (int i = 0; i < N; i++) {
+            if (RandInt32::get() & 1) {
+                bv0.set(i);
+                bv.set(i);
+            }
+        }
+        bv0.buildRank();
+        bv.buildRank();
+
+        vector<int> pos(Q);
+        for (int i = 0; i < Q; i++)
+            pos[i] = RandInt32::get() % N;
+
+        cout << "N = " << N << ", Q = " << Q << endl;
+        long long sum0 = 0, sum1 = 0;
+
+        cout << "  BitVectorRank::rank1() : ";
+        PROFILE_START(0);
+        for (int i = 0; i < Q; i++)
+            sum0 += bv0.rank1(pos[i]);
+        PROFILE_STOP(0);
+
+        cout << "  BitVectorRankSelect::rank1() : ";
+        PROFILE_START(1);
+        for (int i = 0; i < Q; i++)
+            sum1 += bv.rank1(pos[i]);
+        PROFILE_STOP(1);
+        assert(sum0 == sum1);
+
+        cout << "  BitVectorRankSelect::select1() : ";
+        PROFILE_START(2);
+        for (int i = 0; i < Q; i++)
+            sum1 += bv.select1(pos[i] % bv.count());
+        PROFILE_STOP(2);
+
+        cout << "  BitVectorRankSelect::select0() : ";
+        PROFILE_START(3);
+        for (int i = 0; i < Q; i++)
+            sum1 += bv.select0(pos[i] % (N - bv.count()));
+        PROFILE_STOP(3);
+        if (sum1 == 0)
+            cout << "ERROR" << endl;
+    }
+    {
+        cout << "*** Speed test : WaveletMatrix with BitVectorRank vs. BitVectorRankSelect ***" << endl;
+
+        int N = 1 << 24;
+        int Q = 1000000;
+#ifdef _DEBUG
+        N = 1 << 16;
+        Q = 10000;
+#endif
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get() & 0xFFFFFF;
+
+        vector<int> qL(Q), qR(Q), qK(Q);
+        for (int i = 0; i < Q; i++) {
+            qL[i] = RandInt32::get() % N;
+            qR[i] = RandInt32::get() % N;
+            if (qL[i] > qR[i])
+                swap(qL[i], qR[i]);
+            qK[i] = RandInt32::get() % (qR[i] - qL[i] + 1);
+        }
+
+        cout << "N = " << N << ", Q = " << Q << endl;
+        long long sum0 = 0, sum1 = 0;
+        {
+            WaveletMatrix<int> wm(in);
+            cout << "  WaveletMatrix<int, BitVectorRank>::kth() : ";
+            PROFILE_START(4);
+            for (int i = 0; i < Q; i++)
+                sum0 += wm.kth(qL[i], qR[i], qK[i]);
+            PROFILE_STOP(4);
+
+            cout << "  WaveletMatrix<int, BitVectorRank>::countLessThanOrEqual() : ";
+            PROFILE_START(5);
+            for (int i = 0; i < Q; i++)
+                sum0 += wm.countLessThanOrEqual(qL[i], qR[i], in[qK[i]]);
+            PROFILE_STOP(5);
+        }
+        {
+            WaveletMatrix<int, BitVectorRankSelect> wm(in);
+            cout << "  WaveletMatrix<int, BitVectorRankSelect>::kth() : ";
+            PROFILE_START(6);
+            for (int i = 0; i < Q; i++)
+                sum1 += wm.kth(qL[i], qR[i], qK[i]);
+            PROFILE_STOP(6);
+
+            cout << "  WaveletMatrix<int, BitVectorRankSelect>::countLessThanOrEqual() : ";
+            PROFILE_START(7);
+            for (int i = 0; i < Q; i++)
+                sum1 += wm.countLessThanOrEqual(qL[i], qR[i], in[qK[i]]);
+            PROFILE_STOP(7);
+        }
+        assert(sum0 == sum1);
+    }
+
+    cout << "OK!" << endl;
+}
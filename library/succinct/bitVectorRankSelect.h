@@ -0,0 +1,343 @@
+#pragma once
+
+#include <new>
+#include <stdlib.h>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#if defined(__BMI2__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#define BIT_VECTOR_USE_PDEP
+#endif
+
+#include "succinctFile.h"
+
+// Bit vector with rank and select on 64-bit words
+//  - a block is a cache line of 8 words : [ones before the block][six 9-bit in-block counts][6 data words],
+//    so rank1() reads one cache line (rank9 with the counts interleaved with the bits)
+//  - select1()/select0() start from the block of every SELECT_SAMPLE-th bit and binary search the blocks
+//    up to the next sample, then find the word by the in-block counts
+//  - popcount() is the popcnt instruction with -mpopcnt (or /arch:AVX on MSVC),
+//    and the select in a word is pdep + tzcnt with BMI2
+//  - same API as BitVectorRank, and can be used as the bit vector of WaveletMatrix
+
+#ifndef BIT_VECTOR_SELECT_SAMPLE
+#define BIT_VECTOR_SELECT_SAMPLE    512
+#endif
+
+template <typename T>
+struct CacheLineAllocator {
+    static const size_t ALIGNMENT = 64;
+
+    typedef T value_type;
+
+    CacheLineAllocator() {
+    }
+
+    template <typename U>
+    CacheLineAllocator(const CacheLineAllocator<U>&) {
+    }
+
+    T* allocate(size_t n) {
+        void* p = nullptr;
+#ifdef _MSC_VER
+        p = _aligned_malloc(max(n * sizeof(T), size_t(1)), ALIGNMENT);
+#else
+        if (posix_memalign(&p, ALIGNMENT, max(n * sizeof(T), size_t(1))) != 0)
+            p = nullptr;
+#endif
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    void deallocate(T* p, size_t) {
+#ifdef _MSC_VER
+        _aligned_free(p);
+#else
+        free(p);
+#endif
+    }
+
+    template <typename U>
+    bool operator ==(const CacheLineAllocator<U>&) const {
+        return true;
+    }
+
+    template <typename U>
+    bool operator !=(const CacheLineAllocator<U>&) const {
+        return false;
+    }
+};
+
+struct BitVectorRankSelect {
+    static const int WORD_BITS = 64;
+    static const int BLOCK_WORDS = 8;           // a cache line
+    static const int DATA_WORDS = 6;
+    static const int BLOCK_BITS = DATA_WORDS * WORD_BITS;
+    static const int COUNT_BITS = 9;
+    static const unsigned long long COUNT_MASK = (1ull << COUNT_BITS) - 1;
+    static const int SELECT_SAMPLE = BIT_VECTOR_SELECT_SAMPLE;
+
+    static const unsigned int FILE_TYPE = SuccinctFile::TYPE_BIT_VECTOR_RANK_SELECT;
+
+    int N;
+    int bitCount;
+    int blockN;
+    vector<unsigned long long, CacheLineAllocator<unsigned long long>> blocks;
+    vector<int> select1Samples;     // select1Samples[i] = the block of the (i * SELECT_SAMPLE)-th 1
+    vector<int> select0Samples;     // select0Samples[i] = the block of the (i * SELECT_SAMPLE)-th 0
+
+    BitVectorRankSelect() : N(0), bitCount(0), blockN(0) {
+    }
+
+    explicit BitVectorRankSelect(int size) {
+        init(size);
+    }
+
+    void init(int size) {
+        N = size;
+        bitCount = 0;
+        blockN = (size + BLOCK_BITS - 1) / BLOCK_BITS + 1;  // +1 for a sentinel block
+        blocks.assign(size_t(blockN) * BLOCK_WORDS, 0ull);
+        select1Samples.clear();
+        select0Samples.clear();
+    }
+
+
+    int size() const {
+        return N;
+    }
+
+    void set() {
+        for (int i = 0; i < N; i++)
+            set(i);
+    }
+
+    void set(int pos) {
+        word(pos) |= 1ull << (pos & (WORD_BITS - 1));
+    }
+
+    void reset() {
+        fill(blocks.begin(), blocks.end(), 0ull);
+    }
+
+    void reset(int pos) {
+        word(pos) &= ~(1ull << (pos & (WORD_BITS - 1)));
+    }
+
+    void set(int pos, bool val) {
+        if (val)
+            set(pos);
+        else
+            reset(pos);
+    }
+
+    unsigned long long get(int pos) const {
+        return word(pos) & (1ull << (pos & (WORD_BITS - 1)));
+    }
+
+    bool test(int pos) const {
+        return get(pos) != 0;
+    }
+
+    //--- after set ---
+
+    void buildRank() {
+        bitCount = 0;
+        select1Samples.clear();
+        select0Samples.clear();
+        for (int b = 0; b < blockN; b++) {
+            unsigned long long* block = &blocks[size_t(b) * BLOCK_WORDS];
+            int zeroCount = b * BLOCK_BITS - bitCount;
+
+            unsigned long long counts = 0;
+            int cnt = 0;
+            for (int j = 0; j < DATA_WORDS; j++) {
+                counts |= (unsigned long long)cnt << (j * COUNT_BITS);
+                cnt += popcount(block[2 + j]);
+            }
+            block[0] = (unsigned long long)bitCount;
+            block[1] = counts;
+
+            // the padding bits after N are not zeros to select
+            int bits = N - b * BLOCK_BITS;
+            int zeroCnt = (bits <= 0 ? 0 : bits < BLOCK_BITS ? bits : BLOCK_BITS) - cnt;
+            while (int(select1Samples.size()) * SELECT_SAMPLE < bitCount + cnt)
+                select1Samples.push_back(b);
+            while (int(select0Samples.size()) * SELECT_SAMPLE < zeroCount + zeroCnt)
+                select0Samples.push_back(b);
+
+            bitCount += cnt;
+        }
+        select1Samples.push_back(blockN - 1);
+        select0Samples.push_back(blockN - 1);
+    }
+
+    int count() const {
+        return bitCount;
+    }
+
+    // inclusive [0, pos]
+    int rank1(int pos) const {
+        if (pos < 0)
+            return 0;
+        else if (pos >= N - 1)
+            return bitCount;
+        ++pos;
+        const unsigned long long* block = &blocks[size_t(pos / BLOCK_BITS) * BLOCK_WORDS];
+        int off = pos % BLOCK_BITS;
+        int j = off / WORD_BITS;
+        return int(block[0]) + int((block[1] >> (j * COUNT_BITS)) & COUNT_MASK)
+             + popcount(block[2 + j] & ((1ull << (off & (WORD_BITS - 1))) - 1ull));
+    }
+
+    // inclusive [left, right]
+    int rank1(int left, int right) const {
+        return rank1(right) - rank1(left - 1);
+    }
+
+    // inclusive [0, pos]
+    int rank0(int pos) const {
+        if (pos < 0)
+            return 0;
+        return pos + 1 - rank1(pos);
+    }
+
+    // inclusive [left, right]
+    int rank0(int left, int right) const {
+        return rank0(right) - rank0(left - 1);
+    }
+
+    // the position of the k-th 1 (0 <= k < count())
+    int select1(int k) const {
+        int lo = select1Samples[k / SELECT_SAMPLE];
+        int hi = select1Samples[k / SELECT_SAMPLE + 1];
+        // the last block with (ones before the block) <= k
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (int(blocks[size_t(mid) * BLOCK_WORDS]) <= k)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+
+        const unsigned long long* block = &blocks[size_t(lo) * BLOCK_WORDS];
+        k -= int(block[0]);
+        int j = 0;
+        for (int i = 1; i < DATA_WORDS; i++)
+            j += int((block[1] >> (i * COUNT_BITS)) & COUNT_MASK) <= k;
+        k -= int((block[1] >> (j * COUNT_BITS)) & COUNT_MASK);
+
+        return lo * BLOCK_BITS + j * WORD_BITS + selectInWord(block[2 + j], k);
+    }
+
+    // the position of the k-th 0 (0 <= k < size() - count())
+    int select0(int k) const {
+        int lo = select0Samples[k / SELECT_SAMPLE];
+        int hi = select0Samples[k / SELECT_SAMPLE + 1];
+        // the last block with (zeros before the block) <= k
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (mid * BLOCK_BITS - int(blocks[size_t(mid) * BLOCK_WORDS]) <= k)
+                lo = mid;
+            else
+                hi = mid - 1;
+        }
+
+        const unsigned long long* block = &blocks[size_t(lo) * BLOCK_WORDS];
+        k -= lo * BLOCK_BITS - int(block[0]);
+        int j = 0;
+        for (int i = 1; i < DATA_WORDS; i++)
+            j += i * WORD_BITS - int((block[1] >> (i * COUNT_BITS)) & COUNT_MASK) <= k;
+        k -= j * WORD_BITS - int((block[1] >> (j * COUNT_BITS)) & COUNT_MASK);
+
+        return lo * BLOCK_BITS + j * WORD_BITS + selectInWord(~block[2 + j], k);
+    }
+
+    //--- serialization
+
+    // writes without the header, to be a part of another structure
+    bool save(SuccinctWriter& writer) const {
+        writer.write(N);
+        writer.write(bitCount);
+        writer.writeArray(blocks.data(), blocks.size());
+        writer.writeArray(select1Samples.data(), select1Samples.size());
+        writer.writeArray(select0Samples.data(), select0Samples.size());
+        return writer.ok;
+    }
+
+    bool load(SuccinctReader& reader) {
+        size_t n = 0;
+        const unsigned long long* p;
+        if (!reader.read(N) || !reader.read(bitCount) || (p = reader.readArray<unsigned long long>(n)) == nullptr)
+            return false;
+        blocks.assign(p, p + n);
+        blockN = int(n / BLOCK_WORDS);
+        return reader.readArray(select1Samples) && reader.readArray(select0Samples)
+            && blockN == (N + BLOCK_BITS - 1) / BLOCK_BITS + 1;
+    }
+
+
+    static int popcount(unsigned long long x) {
+#ifndef __GNUC__
+        return int(__popcnt64(x));
+#else
+        return __builtin_popcountll(x);
+#endif
+    }
+
+    // the position of the k-th 1 in x (0 <= k < popcount(x))
+    static int selectInWord(unsigned long long x, int k) {
+#if defined(BIT_VECTOR_USE_PDEP)
+#ifndef __GNUC__
+        unsigned long pos;
+        _BitScanForward64(&pos, _pdep_u64(1ull << k, x));
+        return int(pos);
+#else
+        return __builtin_ctzll(_pdep_u64(1ull << k, x));
+#endif
+#else
+        // broadword : find the byte by the prefix counts of bytes, then the bit in the byte
+        const unsigned long long ONES_STEP8 = 0x0101010101010101ull;
+        const unsigned long long MSBS_STEP8 = 0x8080808080808080ull;
+        unsigned long long s = x - ((x >> 1) & 0x5555555555555555ull);
+        s = (s & 0x3333333333333333ull) + ((s >> 2) & 0x3333333333333333ull);
+        s = (s + (s >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        unsigned long long byteSums = s * ONES_STEP8;
+        unsigned long long geqStep8 = ((((unsigned long long)k * ONES_STEP8) | MSBS_STEP8) - byteSums) & MSBS_STEP8;
+        int pos = popcount(geqStep8) * 8;
+        k -= int(((byteSums << 8) >> pos) & 0xFF);
+        return pos + selectInByte(int((x >> pos) & 0xFF), k);
+#endif
+    }
+
+private:
+    // the position of the k-th 1 in x (0 <= x < 256, 0 <= k < popcount(x))
+    static int selectInByte(int x, int k) {
+        struct Table {
+            unsigned char pos[8][256];
+
+            Table() {
+                memset(pos, 0, sizeof(pos));
+                for (int x = 0; x < 256; x++) {
+                    for (int i = 0, k = 0; i < 8; i++) {
+                        if (x & (1 << i))
+                            pos[k++][x] = (unsigned char)i;
+                    }
+                }
+            }
+        };
+        static const Table table;
+        return table.pos[k][x];
+    }
+
+    unsigned long long& word(int pos) {
+        return blocks[size_t(pos / BLOCK_BITS) * BLOCK_WORDS + 2 + (pos % BLOCK_BITS) / WORD_BITS];
+    }
+
+    const unsigned long long& word(int pos) const {
+        return blocks[size_t(pos / BLOCK_BITS) * BLOCK_WORDS + 2 + (pos % BLOCK_BITS) / WORD_BITS];
+    }
+};
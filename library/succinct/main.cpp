@@ -7,9 +7,13 @@ using namespace std;
 
 int main(void) {
     TEST(BitVectorRank);
+    TEST(BitVectorRankSelect);
+    TEST(BitVectorRRR);
     TEST(WaveletTree);
     TEST(WaveletTreeBitVector);
     TEST(WaveletMatrix);
+    TEST(WaveletMatrixParallel);
     TEST(WaveletMatrixArray);
     TEST(WaveletMatrixArrayIndirect);
+    TEST(SuccinctFile);
 }
@@ -0,0 +1,165 @@
+#include <limits>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+
+using namespace std;
+
+#include "succinctFile.h"
+#include "bitVectorRank.h"
+#include "waveletMatrix.h"
+#include "waveletMatrixArray.h"
+
+/////////// For Testing ///////////////////////////////////////////////////////
+
+#include <time.h>
+#include <cassert>
+#include <string>
+#include <iostream>
+#include "../common/iostreamhelper.h"
+#include "../common/profile.h"
+#include "../common/rand.h"
+
+template <typename Matrix1, typename Matrix2>
+static void checkWaveletMatrix(const vector<int>& in, const Matrix1& m1, const Matrix2& m2) {
+    int N = int(in.size());
+    for (int t = 0; t < 100; t++) {
+        int L = RandInt32::get() % N;
+        int R = RandInt32::get() % N;
+        if (L > R)
+            swap(L, R);
+        int K = RandInt32::get() % (R - L + 1);
+        int V = in[RandInt32::get() % N];
+
+        assert(m1.get(L) == m2.get(L));
+        assert(m1.kth(L, R, K) == m2.kth(L, R, K));
+        assert(m1.countEx(L, R, V) == m2.countEx(L, R, V));
+        assert(m1.count(L, R, V / 2, V) == m2.count(L, R, V / 2, V));
+    }
+}
+
+void testSuccinctFile() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Succinct File ------------------------------" << endl;
+
+    const char* path = "succinct_test.bin";
+    {
+        for (int N = 1; N <= 1000; N += 111) {
+            BitVectorRank bv(N);
+            for (int i = 0; i < N; i++)
+                bv.set(i, (RandInt32::get() & 1) != 0);
+            bv.buildRank();
+            assert(bv.save(path));
+
+            BitVectorRank bv2;
+            assert(bv2.load(path));
+            assert(bv2.N == bv.N && bv2.values == bv.values && bv2.rank == bv.rank);
+
+            BitVectorRankView view(path);
+            assert(view.size() == N && view.count() == bv.count());
+            for (int i = 0; i < N; i++) {
+                assert(view.test(i) == bv.test(i));
+                assert(view.rank1(i) == bv.rank1(i));
+                assert(view.rank0(i) == bv.rank0(i));
+            }
+
+            vector<int> in(N);
+            for (int i = 0; i < N; i++)
+                in[i] = RandInt32::get() % 65536;
+
+            WaveletMatrix<int> wm(in);
+            assert(wm.save(path));
+            WaveletMatrix<int> wm2;
+            assert(wm2.load(path));
+            checkWaveletMatrix(in, wm, wm2);
+            WaveletMatrixView<int> wmView(path);
+            checkWaveletMatrix(in, wm, wmView);
+
+            WaveletMatrixArray<int> wma(in);
+            assert(wma.save(path));
+            WaveletMatrixArray<int> wma2;
+            assert(wma2.load(path));
+            assert(wma2.values == wma.values);
+            WaveletMatrixArrayView<int> wmaView(path);
+            checkWaveletMatrix(in, wma, wmaView);
+
+            // a file of another type or another element size is rejected
+            assert(!wm2.load(path));
+            assert(!WaveletMatrixView<int>().open(path));
+            assert(!WaveletMatrixArrayView<long long>().open(path));
+        }
+
+        // a truncated file is rejected
+        {
+            vector<int> in(1000);
+            for (int i = 0; i < 1000; i++)
+                in[i] = RandInt32::get() % 65536;
+            WaveletMatrixArray<int> wma(in);
+            FILE* fp = fopen(path, "wb");
+            SuccinctWriter writer(fp);
+            writer.writeHeader(SuccinctFile::TYPE_WAVELET_MATRIX_ARRAY, sizeof(int));
+            writer.write(wma.N);
+            writer.write(wma.H);
+            writer.write(wma.maxVal);
+            writer.writeArray(wma.values[0].data(), wma.values[0].size());
+            fclose(fp);
+
+            WaveletMatrixArray<int> wma2;
+            assert(!wma2.load(path));
+            assert(!WaveletMatrixArrayView<int>().open(path));
+        }
+    }
+    {
+        cout << "*** Speed test : build vs. load vs. open ***" << endl;
+
+        int N = 1 << 24;
+#ifdef _DEBUG
+        N = 1 << 16;
+#endif
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get() & 0x3fffffff;
+
+        cout << "N = " << N << endl;
+
+        cout << "  WaveletMatrix::build() : ";
+        PROFILE_START(0);
+        WaveletMatrix<int> wm(in);
+        PROFILE_STOP(0);
+        assert(wm.save(path));
+
+        cout << "  WaveletMatrix::load() : ";
+        PROFILE_START(1);
+        WaveletMatrix<int> wm2;
+        assert(wm2.load(path));
+        PROFILE_STOP(1);
+
+        cout << "  WaveletMatrixView::open() : ";
+        PROFILE_START(2);
+        WaveletMatrixView<int> wmView(path);
+        PROFILE_STOP(2);
+        checkWaveletMatrix(in, wm, wmView);
+
+        cout << "  WaveletMatrixArray::build() : ";
+        PROFILE_START(3);
+        WaveletMatrixArray<int> wma(in);
+        PROFILE_STOP(3);
+        assert(wma.save(path));
+
+        cout << "  WaveletMatrixArray::load() : ";
+        PROFILE_START(4);
+        WaveletMatrixArray<int> wma2;
+        assert(wma2.load(path));
+        PROFILE_STOP(4);
+
+        cout << "  WaveletMatrixArrayView::open() : ";
+        PROFILE_START(5);
+        WaveletMatrixArrayView<int> wmaView(path);
+        PROFILE_STOP(5);
+        checkWaveletMatrix(in, wma, wmaView);
+    }
+    remove(path);
+
+    cout << "OK!" << endl;
+}
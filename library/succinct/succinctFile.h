@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../common/binaryFile.h"
+
+// Binary file format of succinct structures
+//  - a BinaryFile with the magic "SUCC" and the types below
+//  - save() writes this format, load() copies a file into a structure, and the read-only views
+//    (BitVectorRankView, WaveletMatrixView, WaveletMatrixArrayView) query a mapped file directly
+struct SuccinctFile {
+    static const unsigned int MAGIC = 0x43435553u;     // "SUCC"
+    static const unsigned int VERSION = 1;
+
+    static const unsigned int TYPE_BIT_VECTOR_RANK = 1;
+    static const unsigned int TYPE_WAVELET_MATRIX = 2;
+    static const unsigned int TYPE_WAVELET_MATRIX_ARRAY = 3;
+    static const unsigned int TYPE_BIT_VECTOR_RANK_SELECT = 4;
+    static const unsigned int TYPE_BIT_VECTOR_RRR = 5;
+
+    // a wavelet matrix keeps the type of its bit vectors in the upper bits, 0 for BitVectorRank
+    static unsigned int waveletMatrixType(unsigned int bitVectorType) {
+        return TYPE_WAVELET_MATRIX | ((bitVectorType - TYPE_BIT_VECTOR_RANK) << 8);
+    }
+};
+
+struct SuccinctWriter : BinaryWriter {
+    explicit SuccinctWriter(FILE* fp) : BinaryWriter(fp) {
+    }
+
+    void writeHeader(unsigned int type, unsigned int elementSize) {
+        BinaryWriter::writeHeader(SuccinctFile::MAGIC, SuccinctFile::VERSION, type, elementSize);
+    }
+};
+
+struct SuccinctReader : BinaryReader {
+    SuccinctReader(const char* base, size_t size) : BinaryReader(base, size) {
+    }
+
+    bool readHeader(unsigned int type, unsigned int elementSize) {
+        return BinaryReader::readHeader(SuccinctFile::MAGIC, SuccinctFile::VERSION, type, elementSize);
+    }
+};
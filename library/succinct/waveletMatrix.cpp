@@ -152,3 +152,60 @@ void testWaveletMatrix() {
 
     cout << "OK!" << endl;
 }
+
+// build(..., threadCount) must make the same matrix as the single-threaded build
+void testWaveletMatrixParallel() {
+    //return; //TODO: if you want to test, make this line a comment.
+
+    cout << "--- Wavelet Matrix : parallel build ------------------------" << endl;
+    {
+        for (int n : { 0, 1, 63, 64, 65, 1000, 4097 }) {
+            vector<int> in(n);
+            for (int j = 0; j < n; j++)
+                in[j] = RandInt32::get() % 65536;
+
+            WaveletMatrix<int> seq;
+            seq.build(in, 65535);
+            for (int threadCount = 2; threadCount <= 8; threadCount++) {
+                WaveletMatrix<int> par;
+                par.build(in, 65535, threadCount);
+                assert(par.H == seq.H && par.mids == seq.mids);
+                for (int i = 0; i < par.H; i++) {
+                    for (int j = 0; j < n; j++)
+                        assert(par.values[i].rank1(j) == seq.values[i].rank1(j));
+                }
+            }
+            for (int j = 0; j < 10 && n > 0; j++) {
+                int L = RandInt32::get() % n;
+                int R = RandInt32::get() % n;
+                if (L > R)
+                    swap(L, R);
+                WaveletMatrix<int> par;
+                par.build(in, 65535, 4);
+                test(in, par, n, L, R);
+            }
+        }
+    }
+    cout << "*** Speed test : parallel build ***" << endl;
+    {
+        int N = 1 << 24;
+#ifdef _DEBUG
+        N = 1 << 16;
+#endif
+        vector<int> in(N);
+        for (int i = 0; i < N; i++)
+            in[i] = RandInt32::get() & 0x3fffffff;
+
+        int maxThreads = max(4, int(thread::hardware_concurrency()));
+        cout << "N = " << N << ", hardware threads = " << thread::hardware_concurrency() << endl;
+        for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2) {
+            WaveletMatrix<int> matrix;
+            cout << "  threads = " << threadCount << " : ";
+            PROFILE_HI_START(0);
+            matrix.build(in, 0x3fffffff, threadCount);
+            PROFILE_HI_STOP(0);
+        }
+    }
+
+    cout << "OK!" << endl;
+}
@@ -2,15 +2,17 @@
 #pragma once
 
 #include "bitVectorRank.h"
+#include "../common/parallelFor.h"
 
-template <typename T>
+// BitVectorT : BitVectorRank, or BitVectorRankSelect for faster rank on large N
+template <typename T, typename BitVectorT = BitVectorRank>
 struct WaveletMatrix {
     static const T NaN = numeric_limits<T>::min();
 
     int                     N;
     int                     H;
     T                       maxVal;
-    vector<BitVectorRank>   values;     // MSB bit first
+    vector<BitVectorT>      values;     // MSB bit first
     vector<int>             mids;          
 
     WaveletMatrix() {
@@ -21,18 +23,22 @@ struct WaveletMatrix {
     }
 
     void build(const vector<T>& in) {
-        build(&in[0], int(in.size()), (in.empty()) ? 0 : *max_element(in.begin(), in.end()));
+        build(in.data(), int(in.size()), (in.empty()) ? 0 : *max_element(in.begin(), in.end()));
     }
 
-    void build(const vector<T>& in, int maxVal) {
-        build(&in[0], int(in.size()), maxVal);
+    void build(const vector<T>& in, int maxVal, int threadCount = 1) {
+        build(in.data(), int(in.size()), maxVal, threadCount);
     }
 
     void build(const T* first, int n) {
         build(first, n, (n == 0) ? 0 : *max_element(first, first + n));
     }
 
-    void build(const T* first, int n, int maxVal) {
+    // O(N * H / threadCount)
+    //  - each level is a parallel stable partition : every thread counts zeros in its part of the array,
+    //    and scatters the part to the positions from the prefix sums of the counts
+    //  - parts are aligned to 64 bits, so threads don't share a word of the bit vector
+    void build(const T* first, int n, int maxVal, int threadCount = 1) {
         this->N = n;
         this->maxVal = maxVal;
 
@@ -40,32 +46,59 @@ struct WaveletMatrix {
         while (maxVal >= (T(1) << H))
             ++H;
 
-        values = vector<BitVectorRank>(H, BitVectorRank(N));
+        values = vector<BitVectorT>(H, BitVectorT(N));
         mids = vector<int>(H);
 
+        int wordN = (N + 63) / 64;
+        threadCount = max(1, min(threadCount, wordN));
+        vector<int> partStart(threadCount + 1);
+        for (int t = 0; t <= threadCount; t++)
+            partStart[t] = min(N, int(1ll * wordN * t / threadCount) * 64);
+        vector<int> zeroPos(threadCount + 1), onePos(threadCount);
+
         vector<T> cur(first, first + N);
         vector<T> next(N);
         for (int i = 0; i < H; i++) {
             T mask = T(1) << (H - i - 1);
 
-            int zeroN = 0;
-            for (int j = 0; j < N; j++)
-                zeroN += ((cur[j] & mask) == 0);
+            parallelFor(threadCount, threadCount, [&](int tFirst, int tLast) {
+                for (int t = tFirst; t < tLast; t++) {
+                    int zeroN = 0;
+                    for (int j = partStart[t]; j < partStart[t + 1]; j++)
+                        zeroN += ((cur[j] & mask) == 0);
+                    zeroPos[t + 1] = zeroN;
+                }
+            });
+
+            zeroPos[0] = 0;
+            for (int t = 0; t < threadCount; t++)
+                zeroPos[t + 1] += zeroPos[t];
+            int zeroN = zeroPos[threadCount];
+            for (int t = 0; t < threadCount; t++)
+                onePos[t] = zeroN + partStart[t] - zeroPos[t];
             mids[i] = zeroN;
 
-            BitVectorRank &bv = values[i];
-            int zeroPos = 0, onePos = zeroN;
-            for (int j = 0; j < N; j++) {
-                if (cur[j] & mask) {
-                    next[onePos++] = cur[j];
-                    bv.set(j);
-                } else {
-                    next[zeroPos++] = cur[j];
+            BitVectorT &bv = values[i];
+            parallelFor(threadCount, threadCount, [&](int tFirst, int tLast) {
+                for (int t = tFirst; t < tLast; t++) {
+                    int zp = zeroPos[t], op = onePos[t];
+                    for (int j = partStart[t]; j < partStart[t + 1]; j++) {
+                        if (cur[j] & mask) {
+                            next[op++] = cur[j];
+                            bv.set(j);
+                        } else {
+                            next[zp++] = cur[j];
+                        }
+                    }
                 }
-            }
-            bv.buildRank();
+            });
             next.swap(cur);
         }
+
+        parallelFor(H, threadCount, [this](int first, int last) {
+            for (int i = first; i < last; i++)
+                values[i].buildRank();
+        });
     }
 
 
@@ -77,7 +110,7 @@ struct WaveletMatrix {
     T get(int pos) const {
         T val = 0;
         for (int i = 0; i < H; i++) {
-            const BitVectorRank &bv = values[i];
+            const BitVectorT &bv = values[i];
 
             if (bv.get(pos)) {
                 val = (val << 1) | 1;
@@ -98,7 +131,7 @@ struct WaveletMatrix {
 
         T val = 0;
         for (int i = 0; i < H; i++) {
-            const BitVectorRank &bv = values[i];
+            const BitVectorT &bv = values[i];
 
             int count = bv.rank0(left, right);
             if (k >= count) {
@@ -142,7 +175,7 @@ struct WaveletMatrix {
 
         int lt = 0, gt = 0;
         for (int i = 0; i < H; i++) {
-            const BitVectorRank &bv = values[i];
+            const BitVectorT &bv = values[i];
 
             if ((val >> (H - i - 1)) & 1) {
                 int leftN = bv.rank1(left - 1);
@@ -162,4 +195,75 @@ struct WaveletMatrix {
         }
         return make_tuple(right - left + 1, lt, gt);
     }
+
+    //--- serialization
+
+    bool save(FILE* fp) const {
+        SuccinctWriter writer(fp);
+        writer.writeHeader(SuccinctFile::waveletMatrixType(BitVectorT::FILE_TYPE), sizeof(T));
+        writer.write(N);
+        writer.write(H);
+        writer.write(maxVal);
+        writer.writeArray(mids.data(), mids.size());
+        for (int i = 0; i < H; i++)
+            values[i].save(writer);
+        return writer.ok;
+    }
+
+    bool save(const char* path) const {
+        return saveBinaryFile(*this, path);
+    }
+
+    // copies a file made by save(), use WaveletMatrixView to query the file without copying
+    bool load(const char* path) {
+        MappedFile file(path);
+        SuccinctReader reader(file.data, file.size);
+        return load(reader);
+    }
+
+    // reads the bit vectors with BitVectorT::load(), which points into the memory of 'reader' for a view
+    bool load(SuccinctReader& reader) {
+        if (!reader.readHeader(SuccinctFile::waveletMatrixType(BitVectorT::FILE_TYPE), sizeof(T))
+            || !reader.read(N) || !reader.read(H) || !reader.read(maxVal) || !reader.readArray(mids)
+            || int(mids.size()) != H)
+            return false;
+
+        values = vector<BitVectorT>(H);
+        for (int i = 0; i < H; i++) {
+            if (!values[i].load(reader))
+                return false;
+        }
+        return true;
+    }
+};
+
+// read-only WaveletMatrix on a file made by WaveletMatrix::save()
+//  - the file is mapped and queried in place, so opening is O(H) regardless of N,
+//    and processes opening the same file share its pages
+//  - the queries are the ones of WaveletMatrix on BitVectorRankView
+template <typename T>
+struct WaveletMatrixView : WaveletMatrix<T, BitVectorRankView> {
+    MappedFile file;
+
+    WaveletMatrixView() {
+        this->N = 0;
+        this->H = 0;
+        this->maxVal = 0;
+    }
+
+    explicit WaveletMatrixView(const char* path) : WaveletMatrixView() {
+        open(path);
+    }
+
+    bool open(const char* path) {
+        if (!file.open(path))
+            return false;
+        SuccinctReader reader(file.data, file.size);
+        return this->load(reader);
+    }
+
+private:
+    // a view is only opened on a file, load(path) would point into a closed file
+    using WaveletMatrix<T, BitVectorRankView>::build;
+    using WaveletMatrix<T, BitVectorRankView>::load;
 };
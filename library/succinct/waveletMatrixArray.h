@@ -7,14 +7,15 @@
 // Speed:  WaveletMatrixArray is faster 4 ~ 5 times
 // Memory: WaveletMatrix is more efficient 24 ~ 30%
 
-template <typename T>
+// LevelT : vector<int>, or const int* into a mapped file (WaveletMatrixArrayView)
+template <typename T, typename LevelT = vector<int>>
 struct WaveletMatrixArray {
     static const T NaN = numeric_limits<T>::min();
 
     int                 N;
     int                 H;
     T                   maxVal;
-    vector<vector<int>> values; // MSB bit first
+    vector<LevelT>      values; // MSB bit first, values[i][N] is the number of zeros
 
     WaveletMatrixArray() {
     }
@@ -81,11 +82,11 @@ struct WaveletMatrixArray {
     T get(int pos) const {
         T val = 0;
         for (int i = 0; i < H; i++) {
-            const vector<int>& v = values[i];
+            const LevelT& v = values[i];
 
             if (v[pos] == v[pos + 1]) {
                 val = (val << 1) | 1;
-                pos = v.back() + (pos - v[pos]);
+                pos = v[N] + (pos - v[pos]);
             } else {
                 val = val << 1;
                 pos = v[pos];
@@ -102,13 +103,13 @@ struct WaveletMatrixArray {
 
         T val = 0;
         for (int i = 0; i < H; i++) {
-            const vector<int>& v = values[i];
+            const LevelT& v = values[i];
 
             int count = v[right + 1] - v[left];
             if (k >= count) {
                 val = (val << 1) | 1;
-                left = v.back() + (left - v[left]);
-                right = v.back() + (right - v[right + 1]);
+                left = v[N] + (left - v[left]);
+                right = v[N] + (right - v[right + 1]);
                 k -= count;
             } else {
                 val = val << 1;
@@ -146,15 +147,15 @@ struct WaveletMatrixArray {
 
         int lt = 0, gt = 0;
         for (int i = 0; i < H; i++) {
-            const vector<int>& v = values[i];
+            const LevelT& v = values[i];
 
             if ((val >> (H - i - 1)) & 1) {
                 int leftN = left - v[left];
                 int rightN = right + 1 - v[right + 1];
 
                 lt += (right - left + 1) - (rightN - leftN);
-                left = v.back() + leftN;
-                right = v.back() + rightN - 1;
+                left = v[N] + leftN;
+                right = v[N] + rightN - 1;
             } else {
                 int leftN = v[left];
                 int rightN = v[right + 1];
@@ -166,4 +167,84 @@ struct WaveletMatrixArray {
         }
         return make_tuple(right - left + 1, lt, gt);
     }
+
+    //--- serialization
+
+    bool save(FILE* fp) const {
+        SuccinctWriter writer(fp);
+        writer.writeHeader(SuccinctFile::TYPE_WAVELET_MATRIX_ARRAY, sizeof(T));
+        writer.write(N);
+        writer.write(H);
+        writer.write(maxVal);
+        for (int i = 0; i < H; i++)
+            writer.writeArray(values[i].data(), values[i].size());
+        return writer.ok;
+    }
+
+    bool save(const char* path) const {
+        return saveBinaryFile(*this, path);
+    }
+
+    // copies a file made by save(), use WaveletMatrixArrayView to query the file without copying
+    bool load(const char* path) {
+        MappedFile file(path);
+        SuccinctReader reader(file.data, file.size);
+        return load(reader);
+    }
+
+    // a level is copied into a vector, or points into the memory of 'reader' for a view
+    bool load(SuccinctReader& reader) {
+        if (!reader.readHeader(SuccinctFile::TYPE_WAVELET_MATRIX_ARRAY, sizeof(T))
+            || !reader.read(N) || !reader.read(H) || !reader.read(maxVal))
+            return false;
+
+        values = vector<LevelT>(H);
+        for (int i = 0; i < H; i++) {
+            if (!readLevel(reader, values[i]))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    bool readLevel(SuccinctReader& reader, vector<int>& v) const {
+        return reader.readArray(v) && int(v.size()) == N + 1;
+    }
+
+    bool readLevel(SuccinctReader& reader, const int*& v) const {
+        size_t n = 0;
+        v = reader.readArray<int>(n);
+        return v != nullptr && int(n) == N + 1;
+    }
+};
+
+// read-only WaveletMatrixArray on a file made by WaveletMatrixArray::save()
+//  - the file is mapped and queried in place, so opening is O(H) regardless of N,
+//    and processes opening the same file share its pages
+//  - the queries are the ones of WaveletMatrixArray on levels in the file
+template <typename T>
+struct WaveletMatrixArrayView : WaveletMatrixArray<T, const int*> {
+    MappedFile file;
+
+    WaveletMatrixArrayView() {
+        this->N = 0;
+        this->H = 0;
+        this->maxVal = 0;
+    }
+
+    explicit WaveletMatrixArrayView(const char* path) : WaveletMatrixArrayView() {
+        open(path);
+    }
+
+    bool open(const char* path) {
+        if (!file.open(path))
+            return false;
+        SuccinctReader reader(file.data, file.size);
+        return this->load(reader);
+    }
+
+private:
+    // a view is only opened on a file, load(path) would point into a closed file
+    using WaveletMatrixArray<T, const int*>::build;
+    using WaveletMatrixArray<T, const int*>::load;
 };
@@ -35,19 +35,19 @@ struct AVLNode {
     }
 };
 
-template <typename T>
-struct AVLTree : public BST<T, AVLNode<T>> {
+template <typename T, typename NodeAllocatorT = HeapNodeAllocator>
+struct AVLTree : public BST<T, AVLNode<T>, NodeAllocatorT> {
     typedef AVLNode<T>  Node;
 
     AVLTree() {
         sentinel->height = 0;
     }
 
-    AVLTree(const AVLTree<T>& tree) : BST<AVLData<T>>(tree) {
+    AVLTree(const AVLTree<T, NodeAllocatorT>& tree) : BST<T, AVLNode<T>, NodeAllocatorT>(tree) {
         sentinel->height = 0;
     }
 
-    AVLTree<T>& operator =(const AVLTree<T>& tree) {
+    AVLTree<T, NodeAllocatorT>& operator =(const AVLTree<T, NodeAllocatorT>& tree) {
         BST::operator =(tree);
         return *this;
     }
@@ -149,7 +149,7 @@ protected:
     }
 
     virtual void onUpdateNode(Node* node) override {
-        BST<T, AVLNode<T>>::onUpdateNode(node);
+        BST<T, AVLNode<T>, NodeAllocatorT>::onUpdateNode(node);
         updateHeight(node);
     }
 
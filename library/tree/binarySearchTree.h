@@ -4,6 +4,8 @@
 #include <functional>
 #include <algorithm>
 
+#include "../memory/nodeAllocator.h"
+
 // T has to have below functions
 //    1) operator ==()
 //    2) operator <()
@@ -33,7 +35,7 @@ struct BSTNode {
     }
 };
 
-template <typename T, typename Node = BSTNode<T>>
+template <typename T, typename Node = BSTNode<T>, typename NodeAllocatorT = HeapNodeAllocator>
 struct BST {
     Node*       root;     // root node
     bool        duplicate;
@@ -44,7 +46,7 @@ struct BST {
     //-----------------------------------------------------------
 
     BST() {
-        sentinel = new Node();
+        sentinel = NodeAllocatorT::template create<Node>();
         sentinel->init();
 
         root = sentinel;
@@ -52,8 +54,8 @@ struct BST {
         count = 0;
     }
 
-    BST(const BST<T>& tree) {
-        sentinel = new Node();
+    BST(const BST<T, Node, NodeAllocatorT>& tree) {
+        sentinel = NodeAllocatorT::template create<Node>();
         sentinel->init();
 
         root = sentinel;
@@ -64,10 +66,10 @@ struct BST {
 
     virtual ~BST() {
         deleteRecursive(root);
-        delete sentinel;
+        NodeAllocatorT::destroy(sentinel);
     }
 
-    BST<T>& operator =(const BST<T>& tree) {
+    BST<T, Node, NodeAllocatorT>& operator =(const BST<T, Node, NodeAllocatorT>& tree) {
         if (this != &tree) {
             deleteRecursive(root);
             duplicate = tree.duplicate;
@@ -349,7 +351,7 @@ struct BST {
 
 protected:
     Node* createNode(const T& item) {
-        Node* p = new Node();
+        Node* p = NodeAllocatorT::template create<Node>();
         p->init(item, sentinel);
         count++;
         return p;
@@ -357,7 +359,7 @@ protected:
 
     void destroyNode(Node* node) {
         assert(node != sentinel);
-        delete node;
+        NodeAllocatorT::destroy(node);
         count--;
     }
 
@@ -40,17 +40,17 @@ struct RBNode {
     }
 };
 
-template <typename T>
-struct RBTree : public BST<T, RBNode<T>> {
+template <typename T, typename NodeAllocatorT = HeapNodeAllocator>
+struct RBTree : public BST<T, RBNode<T>, NodeAllocatorT> {
     typedef RBNode<T>   Node;
 
     RBTree() {
     }
 
-    RBTree(const RBTree<T>& tree) : BST<T, RBNode<T>>(tree) {
+    RBTree(const RBTree<T, NodeAllocatorT>& tree) : BST<T, RBNode<T>, NodeAllocatorT>(tree) {
     }
 
-    RBTree<T>& operator =(const RBTree<T>& tree) {
+    RBTree<T, NodeAllocatorT>& operator =(const RBTree<T, NodeAllocatorT>& tree) {
         BST::operator =(tree);
         return *this;
     }
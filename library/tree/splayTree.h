@@ -2,7 +2,9 @@
 
 #include <algorithm>
 
-template <typename T>
+#include "../memory/nodeAllocator.h"
+
+template <typename T, typename NodeAllocatorT = HeapNodeAllocator>
 struct SplayTree {
     struct Node {
         Node* parent;
@@ -168,12 +170,12 @@ struct SplayTree {
 protected:
     Node* createNode() {
         count++;
-        return new Node();
+        return NodeAllocatorT::template create<Node>();
     }
 
     void destroyNode(Node* node) {
         count--;
-        delete node;
+        NodeAllocatorT::destroy(node);
     }
 
     void deleteRecursive(Node* node) {
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 
-template <typename T>
+#include "../memory/nodeAllocator.h"
+
+template <typename T, typename NodeAllocatorT = HeapNodeAllocator>
 struct Treap {
     struct Node {
         Node* parent;
@@ -108,7 +110,7 @@ struct Treap {
 
 protected:
     Node* createNode(const T& item) {
-        Node* p = new Node();
+        Node* p = NodeAllocatorT::template create<Node>();
         p->init();
         p->value = item;
         count++;
@@ -117,7 +119,7 @@ protected:
 
     void destroyNode(Node* node) {
         count--;
-        delete node;
+        NodeAllocatorT::destroy(node);
     }
 
     void deleteRecursive(Node* node) {